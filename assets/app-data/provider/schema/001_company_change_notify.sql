@@ -0,0 +1,34 @@
+-- 001_company_change_notify.sql
+--
+-- NOTIFY trigger feeding WatchCompanies when the provider runs with
+-- "change_feed": "notify". Payload: <op>|<SERVER_UID>|<UID>, op = I, U or D
+-- (parsed by CompanyChangeListener::parsePayload). An UPDATE that moves a
+-- row to another SERVER_UID also sends D for the old tenant.
+--
+-- Schema migrations live here, not in sql-applets/: they are applied once
+-- by the DBA and are never loaded by SqlTemplate.
+
+CREATE OR REPLACE FUNCTION company_change_notify() RETURNS trigger AS $$
+DECLARE
+    rec RECORD;
+BEGIN
+    IF TG_OP = 'UPDATE' AND OLD."SERVER_UID" <> NEW."SERVER_UID" THEN
+        PERFORM pg_notify('company_changes',
+                          'D|' || OLD."SERVER_UID" || '|' || OLD."UID");
+    END IF;
+    IF TG_OP = 'DELETE' THEN
+        rec := OLD;
+    ELSE
+        rec := NEW;
+    END IF;
+    PERFORM pg_notify('company_changes',
+                      left(TG_OP, 1) || '|' || rec."SERVER_UID" || '|' || rec."UID");
+    RETURN NULL;
+END;
+$$ LANGUAGE plpgsql;
+
+DROP TRIGGER IF EXISTS company_change_notify ON company;
+
+CREATE TRIGGER company_change_notify
+    AFTER INSERT OR UPDATE OR DELETE ON company
+    FOR EACH ROW EXECUTE FUNCTION company_change_notify();
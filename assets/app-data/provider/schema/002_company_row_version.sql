@@ -0,0 +1,37 @@
+-- 002_company_row_version.sql
+--
+-- Row versions and tombstones for SyncCompanies (delta sync).
+--
+-- Every insert/update takes the next value of its tenant's clock row in
+-- company_sync_clock (company_sync_clock_bump.sql, run by CompanyRepository
+-- in the writer's transaction). The clock row stays locked until commit, so
+-- the versions of one SERVER_UID become visible in increasing order and
+-- "ROW_VERSION" > :SINCE_VERSION never skips a late committer. Deleted UIDs,
+-- and UIDs moved to another SERVER_UID, go to company_tombstone with a
+-- version from the old tenant's clock (company_tombstone_insert.sql).
+-- Tombstones are pruned after a retention period (schema/005).
+
+CREATE TABLE IF NOT EXISTS company_sync_clock (
+    "SERVER_UID"  INTEGER PRIMARY KEY,
+    "ROW_VERSION" BIGINT  NOT NULL
+);
+
+-- Existing rows start at version 1 so that a first sync (since 0) sees them
+ALTER TABLE company ADD COLUMN IF NOT EXISTS "ROW_VERSION" BIGINT NOT NULL DEFAULT 1;
+
+INSERT INTO company_sync_clock ("SERVER_UID", "ROW_VERSION")
+SELECT DISTINCT "SERVER_UID", 1 FROM company
+ON CONFLICT ("SERVER_UID") DO NOTHING;
+
+CREATE INDEX IF NOT EXISTS company_sync_idx
+    ON company ("SERVER_UID", "ROW_VERSION");
+
+CREATE TABLE IF NOT EXISTS company_tombstone (
+    "UID"         TEXT        NOT NULL,
+    "SERVER_UID"  INTEGER     NOT NULL,
+    "ROW_VERSION" BIGINT      NOT NULL,
+    "DELETED_AT"  TIMESTAMPTZ NOT NULL DEFAULT now()
+);
+
+CREATE INDEX IF NOT EXISTS company_tombstone_sync_idx
+    ON company_tombstone ("SERVER_UID", "ROW_VERSION");
@@ -0,0 +1,20 @@
+-- 003_company_trigram.sql
+--
+-- Trigram indexes for the TRIGRAM/SIMILAR search modes (company_search*.sql,
+-- company_similar*.sql). A GIN gin_trgm_ops index serves both
+-- ILIKE '%term%' and the pg_trgm similarity operator, which the plain
+-- LIKE '%term%' of company_select.sql can only answer with a sequential scan.
+--
+-- Requires the pg_trgm contrib extension (CREATE privilege on the database).
+-- UID is not indexed: lookups by UID are exact (company_select_by_uid.sql).
+
+CREATE EXTENSION IF NOT EXISTS pg_trgm;
+
+CREATE INDEX IF NOT EXISTS company_name_trgm_idx
+    ON company USING gin ("NAME" gin_trgm_ops);
+
+CREATE INDEX IF NOT EXISTS company_address_trgm_idx
+    ON company USING gin ("ADDRESS" gin_trgm_ops);
+
+CREATE INDEX IF NOT EXISTS company_license_trgm_idx
+    ON company USING gin ("LICENSE" gin_trgm_ops);
@@ -0,0 +1,23 @@
+-- 004_company_row_counter.sql
+--
+-- Per-tenant row counters for unfiltered QueryCompanyTotalCount
+-- ("row_counters": true in provider.json).
+--
+-- CompanyRepository adds +1/-1 to one of COUNTER_SHARDS rows per SERVER_UID
+-- in the transaction of each insert/delete (company_counter_adjust.sql); the
+-- shard is picked at random so concurrent writers rarely wait on the same
+-- row. The tenant total is the sum of its shards (company_counter_total.sql).
+-- CompanyCounterReconciler periodically corrects drift, e.g. after rows were
+-- changed outside the provider (company_counter_reconcile.sql).
+
+CREATE TABLE IF NOT EXISTS company_row_counter (
+    "SERVER_UID" INTEGER  NOT NULL,
+    "SHARD"      SMALLINT NOT NULL,
+    "ROW_COUNT"  BIGINT   NOT NULL,
+    PRIMARY KEY ("SERVER_UID", "SHARD")
+);
+
+-- Start from the current contents; shard 0 holds the initial count
+INSERT INTO company_row_counter ("SERVER_UID", "SHARD", "ROW_COUNT")
+SELECT "SERVER_UID", 0, COUNT(*) FROM company GROUP BY "SERVER_UID"
+ON CONFLICT ("SERVER_UID", "SHARD") DO NOTHING;
@@ -0,0 +1,14 @@
+-- 005_company_tombstone_retention.sql
+--
+-- Retention for company_tombstone (schema/002_company_row_version.sql).
+--
+-- CompanyTombstonePruner drops tombstones older than "tombstone_retention_days"
+-- (company_tombstone_horizon.sql, company_tombstone_prune.sql). Before it does,
+-- it raises the tenant's PRUNED_VERSION to the newest version it drops. A
+-- client whose since_version is below PRUNED_VERSION may have missed a delete,
+-- so SyncCompanies answers it with a reset and a full snapshot.
+
+ALTER TABLE company_sync_clock ADD COLUMN IF NOT EXISTS "PRUNED_VERSION" BIGINT NOT NULL DEFAULT 0;
+
+CREATE INDEX IF NOT EXISTS company_tombstone_age_idx
+    ON company_tombstone ("DELETED_AT");
@@ -0,0 +1,11 @@
+-- company_counter_adjust.sql
+-- @param SERVER_UID NUMERIC  default=0
+-- @param SHARD      NUMERIC  default=0
+-- @param DELTA      NUMERIC  default=0
+--
+-- Add DELTA to one counter shard of a tenant (same transaction as the insert/delete)
+
+INSERT INTO company_row_counter ("SERVER_UID", "SHARD", "ROW_COUNT")
+VALUES (:SERVER_UID, :SHARD, :DELTA)
+ON CONFLICT ("SERVER_UID", "SHARD") DO UPDATE
+    SET "ROW_COUNT" = company_row_counter."ROW_COUNT" + EXCLUDED."ROW_COUNT";
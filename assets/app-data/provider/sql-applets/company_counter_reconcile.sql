@@ -0,0 +1,27 @@
+-- company_counter_reconcile.sql
+-- @param SERVER_UID NUMERIC  default=-1
+--
+-- Correct counter drift of one tenant (or all tenants for SERVER_UID < 0).
+-- Run after LOCK TABLE company_row_counter IN SHARE ROW EXCLUSIVE MODE in the
+-- same transaction, so no insert/delete adjusts the counters meanwhile.
+-- Returns one row per corrected tenant.
+
+WITH actual AS (
+    SELECT "SERVER_UID", COUNT(*) AS n
+    FROM company
+    WHERE :SERVER_UID < 0 OR "SERVER_UID" = :SERVER_UID
+    GROUP BY "SERVER_UID"
+), counted AS (
+    SELECT "SERVER_UID", SUM("ROW_COUNT") AS n
+    FROM company_row_counter
+    WHERE :SERVER_UID < 0 OR "SERVER_UID" = :SERVER_UID
+    GROUP BY "SERVER_UID"
+)
+INSERT INTO company_row_counter ("SERVER_UID", "SHARD", "ROW_COUNT")
+SELECT COALESCE(a."SERVER_UID", c."SERVER_UID"), 0, COALESCE(a.n, 0) - COALESCE(c.n, 0)
+FROM actual a
+FULL JOIN counted c ON c."SERVER_UID" = a."SERVER_UID"
+WHERE COALESCE(a.n, 0) <> COALESCE(c.n, 0)
+ON CONFLICT ("SERVER_UID", "SHARD") DO UPDATE
+    SET "ROW_COUNT" = company_row_counter."ROW_COUNT" + EXCLUDED."ROW_COUNT"
+RETURNING "SERVER_UID";
@@ -0,0 +1,8 @@
+-- company_counter_total.sql
+-- @param SERVER_UID NUMERIC  default=0
+--
+-- Number of companies of a tenant from its counter shards
+
+SELECT COALESCE(SUM("ROW_COUNT"), 0) AS "ROW_COUNT"
+FROM company_row_counter
+WHERE "SERVER_UID" = :SERVER_UID;
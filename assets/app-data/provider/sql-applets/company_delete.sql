@@ -2,5 +2,7 @@
 -- @param UID STRING default=''
 --
 -- Delete a company by UID
+-- CompanyRepository::remove() then writes the company_tombstone row so
+-- SyncCompanies can report it
 
-DELETE FROM company WHERE "UID" = :UID RETURNING "UID";
+DELETE FROM company WHERE "UID" = :UID RETURNING "UID", "SERVER_UID";
@@ -1,4 +1,5 @@
 -- company_insert.sql
+-- @param UID          STRING   default=''
 -- @param SERVER_UID   NUMERIC  default=0
 -- @param COMPANY_TYPE NUMERIC  default=0
 -- @param NAME         STRING   default=''
@@ -6,10 +7,14 @@
 -- @param REG_DATE     DATE     default='2007-01-20'
 -- @param JOINT_DATE   DATE     default='2007-01-20'
 -- @param LICENSE      STRING   default=''
+-- @param ROW_VERSION  INT64    default=0
 --
 -- Insert a new company record
+-- UID is a UUIDv7 made by the caller (timeFormatter::generateUuidV7), so new
+-- keys land at the right edge of the UID index instead of all over it
+-- ROW_VERSION comes from company_sync_clock_bump.sql in the same transaction
 
-INSERT INTO company("SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
- "JOINT_DATE", "LICENSE", "LOGO")
-VALUES (:SERVER_UID, :COMPANY_TYPE, :NAME, :ADDRESS, :REG_DATE, :JOINT_DATE,
- :LICENSE, :LOGO) RETURNING "UID";
+INSERT INTO company("UID", "SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
+ "JOINT_DATE", "LICENSE", "LOGO", "ROW_VERSION")
+VALUES (:UID, :SERVER_UID, :COMPANY_TYPE, :NAME, :ADDRESS, :REG_DATE,
+ :JOINT_DATE, :LICENSE, :LOGO, :ROW_VERSION) RETURNING "UID";
@@ -0,0 +1,11 @@
+-- company_lock_row.sql
+-- @param UID STRING default=''
+--
+-- Lock a company row for the rest of the transaction and return its current
+-- SERVER_UID. CompanyRepository::update() runs it first to tell whether the
+-- update moves the row to another tenant. SQLite uses
+-- company_lock_row_sqlite.sql instead (see CompanyRepository::lockApplet()).
+
+SELECT "SERVER_UID" FROM company
+WHERE "UID" = :UID
+FOR UPDATE;
@@ -0,0 +1,11 @@
+-- company_lock_row_sqlite.sql
+-- @param UID STRING default=''
+--
+-- SQLite form of company_lock_row.sql: SQLite has no row locks, so a no-op
+-- UPDATE takes the write lock and returns the row's current SERVER_UID.
+-- CompanyRepository::lockApplet() picks it for SA_SQLite_Client only; on
+-- PostgreSQL it would leave a dead tuple and fire the NOTIFY trigger.
+
+UPDATE company SET "SERVER_UID" = "SERVER_UID"
+WHERE "UID" = :UID
+RETURNING "SERVER_UID";
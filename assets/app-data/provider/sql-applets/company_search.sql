@@ -0,0 +1,17 @@
+-- company_search.sql
+-- @param SERVER_UID   NUMERIC  default=0
+-- @param FILTER_FIELD STRING   default=NAME
+-- @param FILTER_VALUE STRING   default=''
+-- @param OFFSET       NUMERIC  default=0
+-- @param LIMIT        NUMERIC  default=100
+--
+-- Case-insensitive substring search served by the pg_trgm GIN indexes (PostgreSQL)
+
+SELECT "UID", "SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
+ "JOINT_DATE", "LICENSE", "LOGO"
+FROM company
+WHERE "SERVER_UID" = :SERVER_UID
+  AND $FILTER_FIELD ILIKE '%' || :FILTER_VALUE || '%'
+ORDER BY $FILTER_FIELD, "UID"
+OFFSET :OFFSET
+LIMIT :LIMIT;
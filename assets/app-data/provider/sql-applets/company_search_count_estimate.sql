@@ -0,0 +1,13 @@
+-- company_search_count_estimate.sql
+-- @param SERVER_UID   NUMERIC  default=0
+-- @param FILTER_FIELD STRING   default=NAME
+-- @param FILTER_VALUE STRING   default=''
+-- @timeout  2s
+--
+-- Planner estimate of the company_search_count.sql result ("Plan Rows"), PostgreSQL only
+
+EXPLAIN (FORMAT JSON)
+SELECT 1
+FROM company
+WHERE "SERVER_UID" = :SERVER_UID
+  AND $FILTER_FIELD ILIKE '%' || :FILTER_VALUE || '%';
@@ -0,0 +1,10 @@
+-- company_select_by_uids.sql
+-- @param UIDS ARRAY_STRING default=''
+--
+-- Select the companies whose UID is in UIDS (QueryCompaniesByUids)
+-- PostgreSQL binds UIDS as one text[]; other databases get an IN-list
+
+SELECT "UID", "SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
+ "JOINT_DATE", "LICENSE", "LOGO"
+FROM company
+WHERE "UID" = ANY(:UIDS);
@@ -0,0 +1,17 @@
+-- company_similar.sql
+-- @param SERVER_UID   NUMERIC  default=0
+-- @param FILTER_FIELD STRING   default=NAME
+-- @param FILTER_VALUE STRING   default=''
+-- @param OFFSET       NUMERIC  default=0
+-- @param LIMIT        NUMERIC  default=100
+--
+-- Fuzzy search with the pg_trgm % operator, best match first (PostgreSQL)
+
+SELECT "UID", "SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
+ "JOINT_DATE", "LICENSE", "LOGO"
+FROM company
+WHERE "SERVER_UID" = :SERVER_UID
+  AND $FILTER_FIELD % :FILTER_VALUE
+ORDER BY similarity($FILTER_FIELD, :FILTER_VALUE) DESC, "UID"
+OFFSET :OFFSET
+LIMIT :LIMIT;
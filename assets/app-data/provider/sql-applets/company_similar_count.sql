@@ -0,0 +1,11 @@
+-- company_similar_count.sql
+-- @param SERVER_UID   NUMERIC  default=0
+-- @param FILTER_FIELD STRING   default=NAME
+-- @param FILTER_VALUE STRING   default=''
+--
+-- Count companies matching a company_similar.sql fuzzy search (PostgreSQL)
+
+SELECT COUNT(*) AS "ROW_COUNT"
+FROM company
+WHERE "SERVER_UID" = :SERVER_UID
+  AND $FILTER_FIELD % :FILTER_VALUE;
@@ -0,0 +1,15 @@
+-- company_sync.sql
+-- @param SERVER_UID    NUMERIC  default=0
+-- @param SINCE_VERSION INT64    default=0
+-- @param LIMIT         NUMERIC  default=500
+-- @prefetch 500
+--
+-- Companies inserted or updated after SINCE_VERSION, oldest change first
+
+SELECT "UID", "SERVER_UID", "COMPANY_TYPE", "NAME", "ADDRESS", "REG_DATE",
+ "JOINT_DATE", "LICENSE", "LOGO", "ROW_VERSION"
+FROM company
+WHERE "SERVER_UID" = :SERVER_UID
+  AND "ROW_VERSION" > :SINCE_VERSION
+ORDER BY "ROW_VERSION"
+LIMIT :LIMIT;
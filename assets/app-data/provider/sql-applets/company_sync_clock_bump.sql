@@ -0,0 +1,12 @@
+-- company_sync_clock_bump.sql
+-- @param SERVER_UID NUMERIC  default=0
+--
+-- Next ROW_VERSION of a tenant, taken in the writer's transaction before the
+-- row change. The clock row stays locked until commit, so the versions of one
+-- SERVER_UID become visible in increasing order.
+
+INSERT INTO company_sync_clock ("SERVER_UID", "ROW_VERSION")
+VALUES (:SERVER_UID, 1)
+ON CONFLICT ("SERVER_UID") DO UPDATE
+    SET "ROW_VERSION" = company_sync_clock."ROW_VERSION" + 1
+RETURNING "ROW_VERSION";
@@ -0,0 +1,9 @@
+-- company_sync_horizon.sql
+-- @param SERVER_UID NUMERIC  default=0
+--
+-- Oldest since_version SyncCompanies can still answer with a delta: tombstones
+-- up to PRUNED_VERSION are gone, so older clients must reload
+
+SELECT "PRUNED_VERSION"
+FROM company_sync_clock
+WHERE "SERVER_UID" = :SERVER_UID;
@@ -0,0 +1,14 @@
+-- company_sync_tombstones.sql
+-- @param SERVER_UID    NUMERIC  default=0
+-- @param SINCE_VERSION INT64    default=0
+-- @param LIMIT         NUMERIC  default=500
+-- @prefetch 500
+--
+-- Companies deleted after SINCE_VERSION, oldest first
+
+SELECT "UID", "ROW_VERSION"
+FROM company_tombstone
+WHERE "SERVER_UID" = :SERVER_UID
+  AND "ROW_VERSION" > :SINCE_VERSION
+ORDER BY "ROW_VERSION"
+LIMIT :LIMIT;
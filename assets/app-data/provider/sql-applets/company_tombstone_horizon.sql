@@ -0,0 +1,19 @@
+-- company_tombstone_horizon.sql
+-- @param RETENTION_SEC NUMERIC  default=2592000
+--
+-- First step of tombstone pruning: move each tenant's PRUNED_VERSION up to the
+-- newest tombstone older than RETENTION_SEC. SyncCompanies answers clients
+-- that are behind PRUNED_VERSION with a full reset
+-- (schema/005_company_tombstone_retention.sql). PostgreSQL only, like the
+-- CompanyTombstonePruner job that runs it
+
+UPDATE company_sync_clock
+SET "PRUNED_VERSION" = expired."ROW_VERSION"
+FROM (
+    SELECT "SERVER_UID", MAX("ROW_VERSION") AS "ROW_VERSION"
+    FROM company_tombstone
+    WHERE "DELETED_AT" < now() - make_interval(secs => :RETENTION_SEC)
+    GROUP BY "SERVER_UID"
+) AS expired
+WHERE company_sync_clock."SERVER_UID" = expired."SERVER_UID"
+  AND company_sync_clock."PRUNED_VERSION" < expired."ROW_VERSION";
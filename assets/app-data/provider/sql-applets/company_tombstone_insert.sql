@@ -0,0 +1,11 @@
+-- company_tombstone_insert.sql
+-- @param UID         STRING   default=''
+-- @param SERVER_UID  NUMERIC  default=0
+-- @param ROW_VERSION INT64    default=0
+--
+-- Record that UID left SERVER_UID (deleted, or moved to another tenant) so
+-- SyncCompanies of that tenant reports it; ROW_VERSION comes from
+-- company_sync_clock_bump.sql in the same transaction
+
+INSERT INTO company_tombstone ("UID", "SERVER_UID", "ROW_VERSION")
+VALUES (:UID, :SERVER_UID, :ROW_VERSION);
@@ -0,0 +1,10 @@
+-- company_tombstone_prune.sql
+--
+-- Second step of tombstone pruning: drop the tombstones at or below their
+-- tenant's PRUNED_VERSION (set by company_tombstone_horizon.sql)
+
+DELETE FROM company_tombstone
+WHERE "ROW_VERSION" <= (
+    SELECT "PRUNED_VERSION" FROM company_sync_clock
+    WHERE company_sync_clock."SERVER_UID" = company_tombstone."SERVER_UID"
+);
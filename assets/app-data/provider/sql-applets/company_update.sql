@@ -7,8 +7,10 @@
 -- @param REG_DATE     DATE     default='2007-01-20'
 -- @param JOINT_DATE   DATE     default='2007-01-20'
 -- @param LICENSE      STRING   default=''
+-- @param ROW_VERSION  INT64    default=0
 --
 -- Update an existing company record
+-- ROW_VERSION comes from company_sync_clock_bump.sql in the same transaction
 
 UPDATE company
 SET "SERVER_UID" = :SERVER_UID,
@@ -18,6 +20,7 @@ SET "SERVER_UID" = :SERVER_UID,
     "REG_DATE" = :REG_DATE,
     "JOINT_DATE" = :JOINT_DATE,
     "LICENSE" = :LICENSE,
-    "LOGO" = :LOGO
+    "LOGO" = :LOGO,
+    "ROW_VERSION" = :ROW_VERSION
 WHERE "UID" = :UID
 RETURNING "UID";
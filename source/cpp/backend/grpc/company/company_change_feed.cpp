@@ -0,0 +1,102 @@
+#include "company_change_feed.h"
+
+#include <random>
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyChangeFeed::CompanyChangeFeed(size_t retention)
+    : m_retention(retention > 0 ? retention : 1)
+{
+    std::random_device rd;
+    std::mt19937_64 gen(rd());
+    std::uniform_int_distribution<uint64_t> dist(1);
+    m_epoch = dist(gen);
+}
+
+// ============================================================================
+// Producers
+// ============================================================================
+
+uint64_t CompanyChangeFeed::publish(ChangeOperation op, int serverUid, std::string_view uid)
+{
+    uint64_t sequence = 0;
+    {
+        std::lock_guard lock(m_mutex);
+        sequence = ++m_lastSequence;
+        m_events.push_back({sequence, op, serverUid, std::string(uid)});
+        if (m_events.size() > m_retention) {
+            m_events.pop_front();
+        }
+    }
+    m_changed.notify_all();
+    return sequence;
+}
+
+void CompanyChangeFeed::close()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_closed = true;
+    }
+    m_changed.notify_all();
+}
+
+uint64_t CompanyChangeFeed::lastSequence() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_lastSequence;
+}
+
+// ============================================================================
+// Consumers
+// ============================================================================
+
+CompanyChangeFeed::Batch CompanyChangeFeed::collect(int serverUid, uint64_t afterSequence) const
+{
+    Batch batch;
+    batch.lastSequence = m_lastSequence;
+    batch.closed = m_closed;
+
+    if (afterSequence >= m_lastSequence) {
+        // Up to date — or a sequence this feed never issued
+        batch.resumeGap = afterSequence > m_lastSequence;
+        return batch;
+    }
+
+    // Sequences are contiguous, so the deque index is a subtraction
+    const uint64_t oldest = m_events.empty() ? m_lastSequence + 1 : m_events.front().sequence;
+    if (afterSequence + 1 < oldest) {
+        batch.resumeGap = true;
+        return batch;
+    }
+
+    for (size_t i = static_cast<size_t>(afterSequence + 1 - oldest); i < m_events.size(); ++i) {
+        const auto& event = m_events[i];
+        if (event.server_uid == serverUid || event.op == ChangeOperation::Reset) {
+            batch.events.push_back(event);
+        }
+    }
+    return batch;
+}
+
+CompanyChangeFeed::Batch CompanyChangeFeed::waitForChanges(int serverUid, uint64_t afterSequence,
+                                                           std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::unique_lock lock(m_mutex);
+    for (;;) {
+        Batch batch = collect(serverUid, afterSequence);
+        if (!batch.events.empty() || batch.resumeGap || batch.closed) {
+            return batch;
+        }
+        // Events of other tenants only move the resume point
+        afterSequence = batch.lastSequence;
+
+        if (m_changed.wait_until(lock, deadline) == std::cv_status::timeout) {
+            return collect(serverUid, afterSequence);
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Kind of change carried by the company change feed
+ *
+ * Values match CompanyEdit::ChangeOperation so the gRPC adapter can cast.
+ */
+enum class ChangeOperation {
+    Insert = 1,
+    Update = 2,
+    Delete = 3,
+    Reset = 5       ///< Events may have been lost — watchers must reload
+};
+
+/**
+ * @brief One entry of the change feed
+ */
+struct CompanyChangeEvent {
+    uint64_t sequence = 0;   ///< Monotonic within one feed epoch
+    ChangeOperation op = ChangeOperation::Update;
+    int server_uid = 0;      ///< 0 for Reset (applies to every tenant)
+    std::string uid;
+};
+
+/**
+ * @brief In-process fan-out hub for company change events
+ *
+ * Producers (CompanyService after commit, or CompanyChangeListener for
+ * PostgreSQL NOTIFY) publish events; WatchCompanies streams block in
+ * waitForChanges() until something for their SERVER_UID arrives.
+ *
+ * The last @c retention events are kept so a reconnecting watcher can
+ * resume from its last sequence instead of reloading. A watcher that fell
+ * further behind (or comes from a previous process — different epoch) gets
+ * a resume gap and must reload.
+ *
+ * Thread-safe.
+ */
+class CompanyChangeFeed {
+public:
+    static constexpr size_t DEFAULT_RETENTION = 4096;
+
+    explicit CompanyChangeFeed(size_t retention = DEFAULT_RETENTION);
+
+    CompanyChangeFeed(const CompanyChangeFeed&) = delete;
+    CompanyChangeFeed& operator=(const CompanyChangeFeed&) = delete;
+
+    /**
+     * @brief Append an event and wake all watchers
+     * @return Sequence number assigned to the event
+     */
+    uint64_t publish(ChangeOperation op, int serverUid, std::string_view uid);
+
+    /**
+     * @brief Result of waitForChanges()
+     */
+    struct Batch {
+        std::vector<CompanyChangeEvent> events;  ///< Matching events, in sequence order
+        uint64_t lastSequence = 0;  ///< Resume point for the next call
+        bool resumeGap = false;     ///< Requested sequence is no longer retained
+        bool closed = false;        ///< Feed was closed (server shutdown)
+    };
+
+    /**
+     * @brief Wait for events of one tenant published after @p afterSequence
+     *
+     * Returns as soon as at least one matching event (or a Reset) exists,
+     * when @p timeout expires (empty batch — caller sends a heartbeat),
+     * or when the feed is closed.
+     */
+    Batch waitForChanges(int serverUid, uint64_t afterSequence,
+                         std::chrono::milliseconds timeout);
+
+    /// Random per-process id; sequences are only comparable within one epoch
+    uint64_t epoch() const noexcept { return m_epoch; }
+
+    uint64_t lastSequence() const;
+
+    /// Wake all watchers and make further waits return immediately
+    void close();
+
+private:
+    /// Collect matching events after @p afterSequence (caller holds m_mutex)
+    Batch collect(int serverUid, uint64_t afterSequence) const;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::deque<CompanyChangeEvent> m_events;
+    size_t m_retention;
+    uint64_t m_lastSequence = 0;
+    uint64_t m_epoch = 0;
+    bool m_closed = false;
+};
@@ -0,0 +1,189 @@
+#include "company_change_listener.h"
+
+#include "sqlconnection.h"
+
+#include <SQLAPI.h>
+#include <pgAPI.h>
+#include <easylogging++.h>
+
+#include <algorithm>
+#include <charconv>
+
+using std::string;
+using std::string_view;
+
+namespace {
+constexpr std::chrono::milliseconds POLL_INTERVAL{250};
+constexpr std::chrono::milliseconds RECONNECT_MIN{1000};
+constexpr std::chrono::milliseconds RECONNECT_MAX{30000};
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyChangeListener::CompanyChangeListener(std::shared_ptr<CompanyChangeFeed> feed,
+                                             string_view dbHost,
+                                             string_view dbUser,
+                                             string_view dbPass,
+                                             bool logSql)
+    : m_feed(std::move(feed))
+    , m_dbHost(dbHost)
+    , m_dbUser(dbUser)
+    , m_dbPass(dbPass)
+    , m_logSql(logSql)
+{
+}
+
+CompanyChangeListener::~CompanyChangeListener()
+{
+    stop();
+}
+
+void CompanyChangeListener::setKeepalive(int idleSeconds, int intervalSeconds, int probes)
+{
+    m_keepaliveIdle = idleSeconds;
+    m_keepaliveInterval = intervalSeconds;
+    m_keepaliveProbes = probes;
+}
+
+void CompanyChangeListener::start()
+{
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&CompanyChangeListener::run, this);
+}
+
+void CompanyChangeListener::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CompanyChangeListener::sleepFor(std::chrono::milliseconds duration)
+{
+    std::unique_lock lock(m_mutex);
+    m_wakeup.wait_for(lock, duration, [this] { return m_stopping.load(); });
+}
+
+// ============================================================================
+// Payload parsing
+// ============================================================================
+
+bool CompanyChangeListener::parsePayload(string_view payload, ChangeOperation& op,
+                                         int& serverUid, string& uid)
+{
+    const size_t first = payload.find('|');
+    if (first != 1) {
+        return false;
+    }
+    const size_t second = payload.find('|', first + 1);
+    if (second == string_view::npos || second + 1 >= payload.size()) {
+        return false;
+    }
+
+    switch (payload[0]) {
+    case 'I': op = ChangeOperation::Insert; break;
+    case 'U': op = ChangeOperation::Update; break;
+    case 'D': op = ChangeOperation::Delete; break;
+    default:  return false;
+    }
+
+    const char* begin = payload.data() + first + 1;
+    const char* end = payload.data() + second;
+    auto [ptr, ec] = std::from_chars(begin, end, serverUid);
+    if (ec != std::errc() || ptr != end) {
+        return false;
+    }
+
+    uid.assign(payload.substr(second + 1));
+    return true;
+}
+
+// ============================================================================
+// Listener thread
+// ============================================================================
+
+void CompanyChangeListener::listen(SqlConnection& conn)
+{
+    conn.connect();
+    // LISTEN only takes effect once committed
+    conn.setAutoCommit(true);
+    SACommand cmd(conn.connectionSa(), SAString(("LISTEN " + string(CHANNEL)).c_str()));
+    cmd.Execute();
+}
+
+bool CompanyChangeListener::drainNotifications(SqlConnection& conn)
+{
+    auto* api = static_cast<pgAPI*>(conn.connectionSa()->NativeAPI());
+    auto* handles = static_cast<pgConnectionHandles*>(conn.connectionSa()->NativeHandles());
+    if (!api || !handles || !handles->conn) {
+        return false;
+    }
+
+    if (api->PQconsumeInput(handles->conn) == 0) {
+        return false;
+    }
+
+    while (PGnotify* notify = api->PQnotifies(handles->conn)) {
+        ChangeOperation op;
+        int serverUid = 0;
+        string uid;
+        if (parsePayload(notify->extra ? notify->extra : "", op, serverUid, uid)) {
+            m_feed->publish(op, serverUid, uid);
+        } else {
+            LOG(WARNING) << "[NOTIFY] " << CHANNEL << ": ignoring malformed payload";
+        }
+        LOG_IF(m_logSql, INFO) << "[NOTIFY] " << CHANNEL << ": " << (notify->extra ? notify->extra : "");
+        api->PQfreemem(notify);
+    }
+    return true;
+}
+
+void CompanyChangeListener::run()
+{
+    SqlConnection conn(SA_PostgreSQL_Client, m_dbHost.c_str(), m_dbUser.c_str(), m_dbPass.c_str());
+    conn.setKeepalive(m_keepaliveIdle, m_keepaliveInterval, m_keepaliveProbes);
+    auto backoff = RECONNECT_MIN;
+    bool listenedBefore = false;
+
+    while (!m_stopping) {
+        try {
+            if (!conn.isConnected()) {
+                listen(conn);
+                backoff = RECONNECT_MIN;
+                if (listenedBefore) {
+                    // Anything sent while we were away is gone
+                    m_feed->publish(ChangeOperation::Reset, 0, "");
+                }
+                listenedBefore = true;
+                LOG(INFO) << "[NOTIFY] listening on " << CHANNEL;
+            }
+
+            if (!drainNotifications(conn)) {
+                LOG(WARNING) << "[NOTIFY] connection lost, reconnecting";
+                conn.disconnect();
+                continue;
+            }
+            sleepFor(POLL_INTERVAL);
+        } catch (const SAException& e) {
+            LOG(ERROR) << "[NOTIFY] " << e.ErrText().GetMultiByteChars();
+            conn.disconnect();
+            sleepFor(backoff);
+            backoff = std::min(backoff * 2, RECONNECT_MAX);
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "[NOTIFY] " << e.what();
+            conn.disconnect();
+            sleepFor(backoff);
+            backoff = std::min(backoff * 2, RECONNECT_MAX);
+        }
+    }
+}
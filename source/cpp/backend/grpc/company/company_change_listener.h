@@ -0,0 +1,79 @@
+#pragma once
+
+#include "company_change_feed.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+class SqlConnection;
+
+/**
+ * @brief Feeds CompanyChangeFeed from PostgreSQL LISTEN/NOTIFY
+ *
+ * Owns a dedicated connection that LISTENs on CHANNEL. Notifications are
+ * raised by the company_change_notify trigger (see
+ * assets/app-data/provider/schema/), so writes made by other provider
+ * instances or by hand are seen as well.
+ *
+ * When the connection drops, the listener reconnects with backoff and
+ * publishes a Reset event — notifications sent while disconnected are lost.
+ */
+class CompanyChangeListener {
+public:
+    static constexpr const char* CHANNEL = "company_changes";
+
+    CompanyChangeListener(std::shared_ptr<CompanyChangeFeed> feed,
+                          std::string_view dbHost,
+                          std::string_view dbUser,
+                          std::string_view dbPass,
+                          bool logSql = false);
+    ~CompanyChangeListener();
+
+    CompanyChangeListener(const CompanyChangeListener&) = delete;
+    CompanyChangeListener& operator=(const CompanyChangeListener&) = delete;
+
+    /// TCP keepalive for the LISTEN connection and its reconnects; call before start()
+    void setKeepalive(int idleSeconds, int intervalSeconds, int probes);
+
+    void start();
+    void stop();
+
+    /**
+     * @brief Parse a trigger payload of the form "<op>|<server_uid>|<uid>"
+     *
+     * op is the first letter of TG_OP (I, U or D).
+     * @return false for malformed payloads
+     */
+    static bool parsePayload(std::string_view payload, ChangeOperation& op,
+                             int& serverUid, std::string& uid);
+
+private:
+    void run();
+    void listen(SqlConnection& conn);
+
+    /// Consume pending notifications; false if the connection is broken
+    bool drainNotifications(SqlConnection& conn);
+
+    /// Sleep until @p duration elapsed or stop() was called
+    void sleepFor(std::chrono::milliseconds duration);
+
+    std::shared_ptr<CompanyChangeFeed> m_feed;
+    std::string m_dbHost;
+    std::string m_dbUser;
+    std::string m_dbPass;
+    bool m_logSql = false;
+    int m_keepaliveIdle = 0;
+    int m_keepaliveInterval = 0;
+    int m_keepaliveProbes = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_stopping{false};
+};
@@ -0,0 +1,70 @@
+#include "company_count_cache.h"
+
+#include <algorithm>
+#include <cctype>
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyCountCache::CompanyCountCache(std::chrono::milliseconds ttl, int64_t threshold)
+    : m_ttl(ttl)
+    , m_threshold(threshold)
+{
+}
+
+// ============================================================================
+// Key normalization
+// ============================================================================
+
+CompanyCountCache::Key CompanyCountCache::makeKey(const CompanyFilter& filter)
+{
+    // The applets default FILTER_FIELD to NAME and the allow-list is upper case
+    std::string field = filter.field.empty() ? std::string("NAME") : filter.field;
+    std::transform(field.begin(), field.end(), field.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return {filter.server_uid, std::move(field), static_cast<int>(filter.mode), filter.value};
+}
+
+// ============================================================================
+// Lookup / store
+// ============================================================================
+
+std::optional<int64_t> CompanyCountCache::find(const CompanyFilter& filter, Clock::time_point now)
+{
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(makeKey(filter));
+    if (it == m_entries.end()) {
+        return std::nullopt;
+    }
+    if (it->second.expires <= now) {
+        m_entries.erase(it);
+        return std::nullopt;
+    }
+    return it->second.count;
+}
+
+void CompanyCountCache::store(const CompanyFilter& filter, int64_t count, Clock::time_point now)
+{
+    if (m_ttl.count() <= 0 || count < m_threshold) {
+        return;
+    }
+    std::lock_guard lock(m_mutex);
+    // Expired entries of filters nobody asks for again are swept here
+    std::erase_if(m_entries, [now](const auto& item) { return item.second.expires <= now; });
+    m_entries[makeKey(filter)] = {count, now + m_ttl};
+}
+
+void CompanyCountCache::invalidate(int serverUid)
+{
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_entries, [serverUid](const auto& item) {
+        return std::get<0>(item.first) == serverUid;
+    });
+}
+
+size_t CompanyCountCache::size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_entries.size();
+}
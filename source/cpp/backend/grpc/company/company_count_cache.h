@@ -0,0 +1,62 @@
+#pragma once
+
+#include "company_types.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+
+/**
+ * @brief Short-lived cache of exact company counts
+ *
+ * Exact COUNT(*) over a substring predicate grows with the tenant, and the
+ * navigator asks for it on every page change. Counts of at least
+ * @c threshold rows are kept for @c ttl per normalized filter; smaller counts
+ * are cheap enough to recompute and are never cached.
+ *
+ * CompanyService drops a tenant's entries after each committed mutation of
+ * that tenant; the TTL bounds staleness for writes it cannot see (other
+ * provider instances).
+ *
+ * Thread-safe.
+ */
+class CompanyCountCache {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    CompanyCountCache(std::chrono::milliseconds ttl, int64_t threshold);
+
+    CompanyCountCache(const CompanyCountCache&) = delete;
+    CompanyCountCache& operator=(const CompanyCountCache&) = delete;
+
+    std::optional<int64_t> find(const CompanyFilter& filter, Clock::time_point now = Clock::now());
+
+    /// Remember @p count if it reaches the threshold
+    void store(const CompanyFilter& filter, int64_t count, Clock::time_point now = Clock::now());
+
+    /// Drop every entry of @p serverUid
+    void invalidate(int serverUid);
+
+    int64_t threshold() const noexcept { return m_threshold; }
+    size_t size() const;
+
+private:
+    /// (SERVER_UID, column, search mode, value) — offset/limit do not affect counts
+    using Key = std::tuple<int, std::string, int, std::string>;
+
+    struct Entry {
+        int64_t count = 0;
+        Clock::time_point expires;
+    };
+
+    static Key makeKey(const CompanyFilter& filter);
+
+    std::chrono::milliseconds m_ttl;
+    int64_t m_threshold;
+    mutable std::mutex m_mutex;
+    std::map<Key, Entry> m_entries;
+};
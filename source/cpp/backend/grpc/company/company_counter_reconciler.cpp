@@ -0,0 +1,109 @@
+#include "company_counter_reconciler.h"
+
+#include "company_repository.h"
+#include "sqlconnection.h"
+#include "transactionscope.h"
+
+#include <SQLAPI.h>
+#include <easylogging++.h>
+
+using std::string_view;
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyCounterReconciler::CompanyCounterReconciler(string_view appletPath,
+                                                   eSAClient client,
+                                                   string_view dbHost,
+                                                   string_view dbUser,
+                                                   string_view dbPass,
+                                                   std::chrono::seconds interval,
+                                                   bool logSql)
+    : m_appletPath(appletPath)
+    , m_client(client)
+    , m_dbHost(dbHost)
+    , m_dbUser(dbUser)
+    , m_dbPass(dbPass)
+    , m_interval(interval)
+    , m_logSql(logSql)
+{
+}
+
+CompanyCounterReconciler::~CompanyCounterReconciler()
+{
+    stop();
+}
+
+void CompanyCounterReconciler::setKeepalive(int idleSeconds, int intervalSeconds, int probes)
+{
+    m_keepaliveIdle = idleSeconds;
+    m_keepaliveInterval = intervalSeconds;
+    m_keepaliveProbes = probes;
+}
+
+void CompanyCounterReconciler::start()
+{
+    if (m_thread.joinable() || m_interval.count() <= 0) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&CompanyCounterReconciler::run, this);
+}
+
+void CompanyCounterReconciler::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CompanyCounterReconciler::sleepFor(std::chrono::milliseconds duration)
+{
+    std::unique_lock lock(m_mutex);
+    m_wakeup.wait_for(lock, duration, [this] { return m_stopping.load(); });
+}
+
+// ============================================================================
+// Reconciliation thread
+// ============================================================================
+
+void CompanyCounterReconciler::reconcile(SqlConnection& conn)
+{
+    if (!conn.isConnected()) {
+        conn.connect();
+    }
+    CompanyRepository repo(conn, m_appletPath, m_logSql, /*rowCounters=*/true);
+    TransactionScope tx(conn);
+    const int corrected = repo.reconcileRowCounts();
+    tx.commit();
+    LOG_IF(m_logSql || corrected > 0, INFO) << "[COUNTER] reconciled, "
+                                            << corrected << " tenant(s) corrected";
+}
+
+void CompanyCounterReconciler::run()
+{
+    SqlConnection conn(m_client, m_dbHost.c_str(), m_dbUser.c_str(), m_dbPass.c_str());
+    conn.setKeepalive(m_keepaliveIdle, m_keepaliveInterval, m_keepaliveProbes);
+
+    while (!m_stopping) {
+        sleepFor(m_interval);
+        if (m_stopping) {
+            break;
+        }
+        try {
+            reconcile(conn);
+        } catch (const SAException& e) {
+            LOG(ERROR) << "[COUNTER] " << e.ErrText().GetMultiByteChars();
+            conn.disconnect();
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "[COUNTER] " << e.what();
+            conn.disconnect();
+        }
+    }
+}
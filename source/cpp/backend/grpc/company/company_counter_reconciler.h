@@ -0,0 +1,66 @@
+#pragma once
+
+#include <SQLAPI.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+class SqlConnection;
+
+/**
+ * @brief Background job that keeps company_row_counter exact
+ *
+ * Counters are adjusted in the transaction of every insert, delete and
+ * tenant move made by the provider, but rows changed by hand or by another
+ * tool leave them off. Every @c interval this job recounts all tenants of
+ * one shard on its own @p client connection and books the difference
+ * (CompanyRepository::reconcileRowCounts()).
+ */
+class CompanyCounterReconciler {
+public:
+    CompanyCounterReconciler(std::string_view appletPath,
+                             eSAClient client,
+                             std::string_view dbHost,
+                             std::string_view dbUser,
+                             std::string_view dbPass,
+                             std::chrono::seconds interval,
+                             bool logSql = false);
+    ~CompanyCounterReconciler();
+
+    CompanyCounterReconciler(const CompanyCounterReconciler&) = delete;
+    CompanyCounterReconciler& operator=(const CompanyCounterReconciler&) = delete;
+
+    /// TCP keepalive for the job's connection and its reconnects; call before start()
+    void setKeepalive(int idleSeconds, int intervalSeconds, int probes);
+
+    void start();
+    void stop();
+
+private:
+    void run();
+    void reconcile(SqlConnection& conn);
+
+    /// Sleep until @p duration elapsed or stop() was called
+    void sleepFor(std::chrono::milliseconds duration);
+
+    std::string m_appletPath;
+    eSAClient m_client;
+    std::string m_dbHost;
+    std::string m_dbUser;
+    std::string m_dbPass;
+    std::chrono::seconds m_interval;
+    bool m_logSql = false;
+    int m_keepaliveIdle = 0;
+    int m_keepaliveInterval = 0;
+    int m_keepaliveProbes = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_stopping{false};
+};
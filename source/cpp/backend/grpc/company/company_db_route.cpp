@@ -0,0 +1,56 @@
+#include "company_db_route.h"
+
+namespace {
+/// Expired pins are swept once the map grows past this
+constexpr size_t PIN_SWEEP_SIZE = 1024;
+}
+
+CompanyDbRoute::CompanyDbRoute(std::unique_ptr<SqlConnectionPool> primary,
+                               std::vector<std::unique_ptr<SqlConnectionPool>> replicas,
+                               std::chrono::milliseconds readYourWrites)
+    : m_primary(std::move(primary))
+    , m_replicas(std::move(replicas))
+    , m_readYourWrites(readYourWrites)
+{
+}
+
+void CompanyDbRoute::noteWrite(int serverUid, Clock::time_point now)
+{
+    if (m_replicas.empty()) {
+        return;  // everything is read from the primary anyway
+    }
+
+    const auto until = now + m_readYourWrites;
+    std::lock_guard lock(m_mutex);
+    if (m_pinnedUntil.size() >= PIN_SWEEP_SIZE) {
+        std::erase_if(m_pinnedUntil, [now](const auto& entry) { return entry.second <= now; });
+    }
+    m_pinnedUntil[serverUid] = until;
+    m_anyPinnedUntil = until;
+}
+
+bool CompanyDbRoute::isPinned(std::optional<int> serverUid, Clock::time_point now) const
+{
+    std::lock_guard lock(m_mutex);
+    if (!serverUid) {
+        return now < m_anyPinnedUntil;
+    }
+    auto it = m_pinnedUntil.find(*serverUid);
+    return it != m_pinnedUntil.end() && now < it->second;
+}
+
+SqlConnectionPool& CompanyDbRoute::readPool(std::optional<int> serverUid, Clock::time_point now)
+{
+    if (m_replicas.empty() || isPinned(serverUid, now)) {
+        return *m_primary;
+    }
+
+    const size_t start = m_next.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < m_replicas.size(); ++i) {
+        SqlConnectionPool& replica = *m_replicas[(start + i) % m_replicas.size()];
+        if (replica.isHealthy(now)) {
+            return replica;
+        }
+    }
+    return *m_primary;
+}
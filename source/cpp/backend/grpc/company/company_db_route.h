@@ -0,0 +1,59 @@
+#pragma once
+
+#include "sqlconnectionpool.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Chooses the database for a company request
+ *
+ * Mutations always go to the primary. Reads go round-robin to healthy
+ * replicas, and fall back to the primary when every replica is cooling
+ * down after a failure (see SqlConnectionPool::reportFailure()).
+ *
+ * Read-your-writes: for readYourWrites after a write, reads of that tenant
+ * stay on the primary so a client never sees its own change disappear
+ * because of replication lag. Reads without a tenant (lookup by uid) stay
+ * on the primary after any write.
+ */
+class CompanyDbRoute {
+public:
+    using Clock = SqlConnectionPool::Clock;
+
+    CompanyDbRoute(std::unique_ptr<SqlConnectionPool> primary,
+                   std::vector<std::unique_ptr<SqlConnectionPool>> replicas,
+                   std::chrono::milliseconds readYourWrites);
+
+    CompanyDbRoute(const CompanyDbRoute&) = delete;
+    CompanyDbRoute& operator=(const CompanyDbRoute&) = delete;
+
+    SqlConnectionPool& primary() noexcept { return *m_primary; }
+
+    /// Pool for a read of @p serverUid (nullopt: tenant unknown)
+    SqlConnectionPool& readPool(std::optional<int> serverUid, Clock::time_point now = Clock::now());
+
+    /// Record a committed write of @p serverUid
+    void noteWrite(int serverUid, Clock::time_point now = Clock::now());
+
+    /// true while reads of @p serverUid must stay on the primary
+    bool isPinned(std::optional<int> serverUid, Clock::time_point now = Clock::now()) const;
+
+    size_t replicaCount() const noexcept { return m_replicas.size(); }
+    SqlConnectionPool& replica(size_t index) { return *m_replicas.at(index); }
+
+private:
+    std::unique_ptr<SqlConnectionPool> m_primary;
+    std::vector<std::unique_ptr<SqlConnectionPool>> m_replicas;
+    std::chrono::milliseconds m_readYourWrites;
+    std::atomic<size_t> m_next{0};
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<int, Clock::time_point> m_pinnedUntil;  ///< per tenant
+    Clock::time_point m_anyPinnedUntil{};
+};
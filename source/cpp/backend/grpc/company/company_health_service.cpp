@@ -0,0 +1,117 @@
+#include "company_health_service.h"
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+using grpc::ServerContext;
+using grpc::Status;
+using grpc::StatusCode;
+using grpc::health::v1::HealthCheckRequest;
+using grpc::health::v1::HealthCheckResponse;
+
+namespace {
+// How often an idle Watch stream checks whether its client went away
+constexpr std::chrono::milliseconds WATCH_POLL{500};
+}
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyHealthService::CompanyHealthService(std::vector<std::string> services)
+    : m_services(std::move(services))
+{
+}
+
+CompanyHealthService::~CompanyHealthService()
+{
+    shutdown();
+}
+
+// ============================================================================
+// Status
+// ============================================================================
+
+void CompanyHealthService::setServing(bool serving)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_shutdown) {
+            return;
+        }
+        m_serving = serving;
+    }
+    m_changed.notify_all();
+}
+
+bool CompanyHealthService::serving() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_serving;
+}
+
+void CompanyHealthService::shutdown()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_shutdown = true;
+        m_serving = false;
+    }
+    m_changed.notify_all();
+}
+
+bool CompanyHealthService::knows(const std::string& service) const
+{
+    return service.empty() ||
+           std::find(m_services.begin(), m_services.end(), service) != m_services.end();
+}
+
+// ============================================================================
+// gRPC — Check / Watch
+// ============================================================================
+
+Status CompanyHealthService::Check(ServerContext*,
+                                   const HealthCheckRequest* request,
+                                   HealthCheckResponse* response)
+{
+    if (!knows(request->service())) {
+        return Status(StatusCode::NOT_FOUND, "unknown service");
+    }
+    response->set_status(serving() ? HealthCheckResponse::SERVING
+                                   : HealthCheckResponse::NOT_SERVING);
+    return Status::OK;
+}
+
+Status CompanyHealthService::Watch(ServerContext* context,
+                                   const HealthCheckRequest* request,
+                                   grpc::ServerWriter<HealthCheckResponse>* writer)
+{
+    const bool known = knows(request->service());
+
+    std::unique_lock lock(m_mutex);
+    // Send the current status, then one message per change; shutdown()
+    // ends the stream after its NOT_SERVING went out
+    std::optional<bool> sent;
+    while (!context->IsCancelled()) {
+        if (!sent || (known && *sent != m_serving)) {
+            HealthCheckResponse response;
+            response.set_status(!known      ? HealthCheckResponse::SERVICE_UNKNOWN
+                                : m_serving ? HealthCheckResponse::SERVING
+                                            : HealthCheckResponse::NOT_SERVING);
+            sent = m_serving;
+            lock.unlock();
+            const bool written = writer->Write(response);
+            lock.lock();
+            if (!written) {
+                break;
+            }
+            continue;
+        }
+        if (m_shutdown) {
+            break;
+        }
+        m_changed.wait_for(lock, WATCH_POLL);
+    }
+    return Status::OK;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <grpcpp/grpcpp.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "health.grpc.pb.h"
+
+/**
+ * @brief grpc.health.v1 Health service that starts out NOT_SERVING
+ *
+ * gRPC's default health service reports SERVING as soon as
+ * BuildAndStart() returns, before the server could change it. This one is
+ * registered like any other service, so the status is in place before the
+ * first call is accepted: NOT_SERVING until setServing(true).
+ *
+ * The overall status ("") and every name passed to the constructor share
+ * the one flag; other names get NOT_FOUND from Check and SERVICE_UNKNOWN
+ * from Watch.
+ */
+class CompanyHealthService final : public grpc::health::v1::Health::Service {
+public:
+    explicit CompanyHealthService(std::vector<std::string> services = {});
+    ~CompanyHealthService() override;
+
+    void setServing(bool serving);
+    bool serving() const;
+
+    /// End every Watch stream; call before Server::Shutdown()
+    void shutdown();
+
+    grpc::Status Check(grpc::ServerContext* context,
+                       const grpc::health::v1::HealthCheckRequest* request,
+                       grpc::health::v1::HealthCheckResponse* response) override;
+
+    grpc::Status Watch(grpc::ServerContext* context,
+                       const grpc::health::v1::HealthCheckRequest* request,
+                       grpc::ServerWriter<grpc::health::v1::HealthCheckResponse>* writer) override;
+
+private:
+    bool knows(const std::string& service) const;
+
+    const std::vector<std::string> m_services;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    bool m_serving = false;
+    bool m_shutdown = false;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "transactionretry.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One entry of the "shards" map in provider.json
+ *
+ * A shard owns either the SERVER_UID range [from, to] or, without a range,
+ * a hash bucket: tenants outside every range go to hash shard
+ * (server_uid mod number-of-hash-shards).
+ */
+struct CompanyShardSpec {
+    std::string name;
+    std::optional<int> from;
+    std::optional<int> to;
+    std::string host;
+    std::string user;
+    std::string pass;
+    std::vector<std::string> replicas;
+    std::string client = "postgresql";  ///< "postgresql" or "sqlite"
+};
+
+/**
+ * @brief Tunables for the company service, read from provider.json
+ *
+ * Defaults keep the behaviour of a single-instance provider; every field
+ * is optional in the config file.
+ */
+struct CompanyServiceOptions {
+    /// Feed WatchCompanies from PostgreSQL NOTIFY ("change_feed": "notify")
+    /// instead of in-process hooks. Requires the company_change_notify trigger.
+    bool listenNotify = false;
+
+    /// Idle WatchCompanies streams get a heartbeat this often
+    std::chrono::seconds watchHeartbeat{15};
+
+    /// Exact counts of at least countCacheThreshold rows are reused for
+    /// countCacheTtl ("count_cache_ttl_sec", "count_cache_threshold").
+    /// Estimated counts are only returned when they reach the threshold too.
+    std::chrono::seconds countCacheTtl{10};
+    int64_t countCacheThreshold = 10000;
+
+    /// Maintain company_row_counter and answer unfiltered counts from it
+    /// ("row_counters": true). Requires schema/004_company_row_counter.sql.
+    bool rowCounters = false;
+
+    /// How often CompanyCounterReconciler corrects counter drift
+    /// ("row_counter_reconcile_sec"); 0 disables the job.
+    std::chrono::seconds rowCounterReconcile{3600};
+
+    /// SyncCompanies tombstones are kept tombstoneRetention
+    /// ("tombstone_retention_days", 0 keeps them forever) and
+    /// CompanyTombstonePruner drops expired ones every tombstonePrune
+    /// ("tombstone_prune_sec"). Requires schema/005_company_tombstone_retention.sql.
+    std::chrono::seconds tombstoneRetention{std::chrono::days(30)};
+    std::chrono::seconds tombstonePrune{3600};
+
+    /// Read replicas ("replicas": JSON array of hosts, same credentials as
+    /// the primary). Empty: every request goes to the primary.
+    std::vector<std::string> replicaHosts;
+
+    /// Connections per database host ("pool_size")
+    size_t poolSize = 4;
+
+    /// Connections opened per database host during startup warm-up
+    /// ("pool_min", at most poolSize)
+    size_t poolMin = 1;
+
+    /// Warm-up also runs the hot read applets once on every opened
+    /// connection ("warmup_statements": true)
+    bool warmStatements = false;
+
+    /// Pooled connections idle this long are pinged and replaced when dead;
+    /// checked as often ("pool_check_sec", 0 disables)
+    std::chrono::seconds poolCheck{30};
+
+    /// TCP keepalive on every PostgreSQL connection: pools, LISTEN and background
+    /// jobs, reapplied on reconnect ("tcp_keepalive_idle_sec",
+    /// "tcp_keepalive_interval_sec", "tcp_keepalive_count"; idle 0 disables)
+    int keepaliveIdle = 60;
+    int keepaliveInterval = 10;
+    int keepaliveProbes = 3;
+
+    /// Reads of a tenant stay on the primary this long after its last write
+    /// ("read_your_writes_ms"), hiding replication lag from the writer.
+    std::chrono::milliseconds readYourWrites{2000};
+
+    /// A replica that failed is skipped this long ("replica_retry_sec")
+    std::chrono::seconds replicaRetry{5};
+
+    /// Transient failures (serialization, lost connection) are retried
+    /// ("retry_attempts", "retry_base_ms", "retry_max_ms")
+    RetryPolicy retry;
+
+    /// Group commit for AddCompany/EditCompany ("write_coalescing": true):
+    /// writes arriving within coalesceWindow ("write_coalesce_window_us"), up
+    /// to coalesceMaxBatch ("write_coalesce_max"), share one transaction.
+    bool coalesceWrites = false;
+    std::chrono::microseconds coalesceWindow{2000};
+    size_t coalesceMaxBatch = 32;
+
+    /// Tenant shards ("shards", see CompanyShardRouter::parseShardMap()).
+    /// Empty: one shard on host/user/pass with replicaHosts.
+    std::vector<CompanyShardSpec> shards;
+};
@@ -3,6 +3,14 @@
 #include "include_backend_util.h"
 #include "JsonParameterFormatter.h"
 #include <easylogging++.h>
+#include <nlohmann/json.hpp>
+
+#ifdef MEDICON_COMPILED_APPLETS
+#include "sql_applets.h"
+#endif
+
+#include <random>
+#include <stdexcept>
 
 using std::string;
 using std::vector;
@@ -12,10 +20,11 @@ using std::vector;
 // ============================================================================
 
 CompanyRepository::CompanyRepository(SqlConnection& conn, std::string_view appletPath,
-                                       bool logSql)
+                                       bool logSql, bool rowCounters)
     : m_conn(conn)
     , m_appletPath(appletPath)
     , m_logSql(logSql)
+    , m_rowCounters(rowCounters)
 {
 }
 
@@ -31,46 +40,6 @@ void CompanyRepository::ensureConnected()
     }
 }
 
-// ============================================================================
-// Result mapping
-// ============================================================================
-
-CompanyData CompanyRepository::rowToCompany(SACommand& row)
-{
-    CompanyData data;
-    data.uid = row.Field("UID").asString().GetMultiByteChars();
-    data.server_uid = row.Field("SERVER_UID");
-    data.company_type = row.Field("COMPANY_TYPE");
-
-    SAString name = row.Field("NAME").asString();
-    name.TrimRight();
-    data.name = name.GetMultiByteChars();
-
-    SAString address = row.Field("ADDRESS").asString();
-    address.TrimRight();
-    data.address = address.GetMultiByteChars();
-
-    string strRegDate = row.Field("REG_DATE").asString().GetMultiByteChars();
-    string strJointDate = row.Field("JOINT_DATE").asString().GetMultiByteChars();
-
-    data.reg_date = TimeFormatHelper::stringTochronoSysSec(strRegDate, DataInfo::Date);
-    data.joint_date = TimeFormatHelper::stringTochronoSysSec(strJointDate, DataInfo::Date);
-
-    SAString license = row.Field("LICENSE").asString();
-    license.TrimRight();
-    data.license = license.GetMultiByteChars();
-
-    // LOGO is bytea: asBytes() returns the raw binary (not the hex-encoded
-    // text that asString() would). Copy with the explicit byte length —
-    // GetMultiByteChars() alone is a C-string and truncates at the first
-    // null byte.
-    SAString logoBytes = row.Field("LOGO").asBytes();
-    data.logo.assign(logoBytes.GetMultiByteChars(),
-                     static_cast<size_t>(logoBytes.GetLength()));
-
-    return data;
-}
-
 // ============================================================================
 // Parameter binding helper
 // ============================================================================
@@ -111,20 +80,17 @@ void CompanyRepository::bindParams(SACommand& cmd, const SqlTemplate& tpl)
 
 CompanyData CompanyRepository::add(const CompanyData& data)
 {
+    // Time-ordered key: inserts append to the UID index
+    ensureConnected();
+
     SqlTemplate tpl(sqlPath("company_insert.sql"));
-    tpl.addParameter("SERVER_UID", data.server_uid);
-    tpl.addParameter("COMPANY_TYPE", data.company_type);
-    tpl.addParameter("NAME", data.name.c_str());
-    tpl.addParameter("ADDRESS", data.address.c_str());
-    tpl.addParameter("REG_DATE", data.reg_date, DataInfo::Date);
-    tpl.addParameter("JOINT_DATE", data.joint_date, DataInfo::Date);
-    tpl.addParameter("LICENSE", data.license.c_str());
+    tpl.addParameter("UID", timeFormatter::generateUuidV7().c_str());
+    addSchemaParameters<CompanySchema>(tpl, data);
+    tpl.addParameter("ROW_VERSION", nextRowVersion(data.server_uid));
     tpl.parse();
 
     LOG_IF(m_logSql, INFO) << "[SQL] company_insert: " << tpl.getDebugSql();
 
-    ensureConnected();
-
     SAString sql(tpl.sql().c_str());
     SACommand cmd(m_conn.connectionSa(), sql);
 
@@ -138,6 +104,9 @@ CompanyData CompanyRepository::add(const CompanyData& data)
     if (cmd.isResultSet() && cmd.FetchNext()) {
         result.uid = cmd.Field("UID").asString().GetMultiByteChars();
     }
+    if (m_rowCounters && !result.uid.empty()) {
+        adjustRowCount(data.server_uid, +1);
+    }
     return result;
 }
 
@@ -145,23 +114,34 @@ CompanyData CompanyRepository::add(const CompanyData& data)
 // CRUD — Update
 // ============================================================================
 
-CompanyData CompanyRepository::update(const CompanyData& data)
+UpdateResult CompanyRepository::update(const CompanyData& data)
 {
+    ensureConnected();
+
+    // Lock the row first: its current tenant tells whether this is a move
+    std::optional<int> oldServerUid;
+    {
+        const char* applet = lockApplet(m_conn.connectionSa()->Client());
+        SqlCommand lock(m_conn, sqlPath(applet));
+        lock.addParameter("UID", data.uid.c_str());
+        LOG_IF(m_logSql, INFO) << "[SQL] " << applet << ": " << lock.getSqlWithParameters();
+        lock.execute();
+        if (lock.isResultSet() && lock.FetchNext()) {
+            oldServerUid = static_cast<int>(lock.Field("SERVER_UID").asLong());
+        }
+    }
+    if (!oldServerUid) {
+        return {};  // no such row
+    }
+
     SqlTemplate tpl(sqlPath("company_update.sql"));
     tpl.addParameter("UID", data.uid.c_str());
-    tpl.addParameter("SERVER_UID", data.server_uid);
-    tpl.addParameter("COMPANY_TYPE", data.company_type);
-    tpl.addParameter("NAME", data.name.c_str());
-    tpl.addParameter("ADDRESS", data.address.c_str());
-    tpl.addParameter("REG_DATE", data.reg_date, DataInfo::Date);
-    tpl.addParameter("JOINT_DATE", data.joint_date, DataInfo::Date);
-    tpl.addParameter("LICENSE", data.license.c_str());
+    addSchemaParameters<CompanySchema>(tpl, data);
+    tpl.addParameter("ROW_VERSION", nextRowVersion(data.server_uid));
     tpl.parse();
 
     LOG_IF(m_logSql, INFO) << "[SQL] company_update: " << tpl.getDebugSql();
 
-    ensureConnected();
-
     SAString sql(tpl.sql().c_str());
     SACommand cmd(m_conn.connectionSa(), sql);
 
@@ -171,9 +151,19 @@ CompanyData CompanyRepository::update(const CompanyData& data)
     cmd.Param(_TSA("logo")).setAsLongBinary() = SaBinary::toSaString(data.logo);
     cmd.Execute();
 
-    CompanyData result;
+    UpdateResult result;
+    result.old_server_uid = *oldServerUid;
     if (cmd.isResultSet() && cmd.FetchNext()) {
-        result.uid = cmd.Field("UID").asString().GetMultiByteChars();
+        result.row.uid = cmd.Field("UID").asString().GetMultiByteChars();
+        result.row.server_uid = data.server_uid;
+    }
+    // Moved to another tenant: the old tenant's sync must drop the row
+    if (result.moved()) {
+        addTombstone(result.row.uid, *oldServerUid);
+        if (m_rowCounters) {
+            adjustRowCount(*oldServerUid, -1);
+            adjustRowCount(data.server_uid, +1);
+        }
     }
     return result;
 }
@@ -195,20 +185,261 @@ DeleteResult CompanyRepository::remove(std::string_view uid)
     DeleteResult result;
     if (cmd.isResultSet() && cmd.FetchNext()) {
         result.uid = cmd.Field("UID").asString().GetMultiByteChars();
+        result.server_uid = cmd.Field("SERVER_UID");
         result.success = true;
     } else {
         result.success = false;
         result.error = "No result set";
     }
+    if (result.success) {
+        addTombstone(result.uid, result.server_uid);
+    }
+    if (m_rowCounters && result.success) {
+        adjustRowCount(result.server_uid, -1);
+    }
     return result;
 }
 
+// ============================================================================
+// Row versions and tombstones (delta sync)
+// ============================================================================
+
+int64_t CompanyRepository::nextRowVersion(int serverUid)
+{
+    SqlCommand cmd(m_conn, sqlPath("company_sync_clock_bump.sql"));
+    cmd.addParameter("SERVER_UID", serverUid);
+    LOG_IF(m_logSql, INFO) << "[SQL] company_sync_clock_bump: " << cmd.getSqlWithParameters();
+    cmd.execute();
+    if (!cmd.isResultSet() || !cmd.FetchNext()) {
+        throw std::runtime_error("company_sync_clock_bump.sql returned no ROW_VERSION");
+    }
+    return cmd.Field("ROW_VERSION").asInt64();
+}
+
+void CompanyRepository::addTombstone(std::string_view uid, int serverUid)
+{
+    const int64_t version = nextRowVersion(serverUid);
+
+    SqlCommand cmd(m_conn, sqlPath("company_tombstone_insert.sql"));
+    cmd.addParameter("UID", string(uid));
+    cmd.addParameter("SERVER_UID", serverUid);
+    cmd.addParameter("ROW_VERSION", version);
+    LOG_IF(m_logSql, INFO) << "[SQL] company_tombstone_insert: " << cmd.getSqlWithParameters();
+    cmd.execute();
+}
+
+int64_t CompanyRepository::pruneTombstones(std::chrono::seconds retention)
+{
+    ensureConnected();
+
+    SqlCommand horizon(m_conn, sqlPath("company_tombstone_horizon.sql"));
+    horizon.addParameter("RETENTION_SEC", static_cast<int64_t>(retention.count()));
+    LOG_IF(m_logSql, INFO) << "[SQL] company_tombstone_horizon: " << horizon.getSqlWithParameters();
+    horizon.execute();
+
+    SqlCommand prune(m_conn, sqlPath("company_tombstone_prune.sql"));
+    LOG_IF(m_logSql, INFO) << "[SQL] company_tombstone_prune: " << prune.getSqlWithParameters();
+    prune.execute();
+    return prune.RowsAffected();
+}
+
+// ============================================================================
+// Row counters
+// ============================================================================
+
+void CompanyRepository::adjustRowCount(int serverUid, int delta)
+{
+    thread_local std::minstd_rand shardPicker{std::random_device{}()};
+    std::uniform_int_distribution<int> shard(0, COUNTER_SHARDS - 1);
+
+    SqlCommand cmd(m_conn, sqlPath("company_counter_adjust.sql"));
+    cmd.addParameter("SERVER_UID", serverUid);
+    cmd.addParameter("SHARD", shard(shardPicker));
+    cmd.addParameter("DELTA", delta);
+    LOG_IF(m_logSql, INFO) << "[SQL] company_counter_adjust: " << cmd.getSqlWithParameters();
+    cmd.execute();
+}
+
+int64_t CompanyRepository::rowCount(int serverUid)
+{
+    ensureConnected();
+
+    SqlQuery cmd(m_conn, sqlPath("company_counter_total.sql"));
+    cmd.addParameter("SERVER_UID", serverUid);
+
+    LOG_IF(m_logSql, INFO) << "[SQL] company_counter_total: " << cmd.getSqlWithParameters();
+
+    const auto counts = cmd.fetchAll<int64_t>([](SACommand& row) {
+        return row.Field("ROW_COUNT").asInt64();
+    });
+    return counts.empty() ? 0 : counts.front();
+}
+
+int CompanyRepository::reconcileRowCounts(int serverUid)
+{
+    ensureConnected();
+
+    // Blocks add/remove adjustments (ROW EXCLUSIVE) until commit, but not
+    // readers; a writer that is already past its counter update holds its
+    // lock, so we wait for it and then see its row. SQLite has a single
+    // writer per database, so the reconcile statement needs no lock there.
+    if (m_conn.connectionSa()->Client() == SA_PostgreSQL_Client) {
+        SqlDirectCommand lock(m_conn,
+            SAString("LOCK TABLE company_row_counter IN SHARE ROW EXCLUSIVE MODE"));
+        lock.execute();
+    }
+
+    SqlQuery cmd(m_conn, sqlPath("company_counter_reconcile.sql"));
+    cmd.addParameter("SERVER_UID", serverUid);
+
+    LOG_IF(m_logSql, INFO) << "[SQL] company_counter_reconcile: " << cmd.getSqlWithParameters();
+
+    int corrected = 0;
+    while (cmd.query()) {
+        LOG(WARNING) << "[COUNTER] corrected drift of SERVER_UID "
+                     << cmd.Field("SERVER_UID").asLong();
+        ++corrected;
+    }
+    return corrected;
+}
+
+// ============================================================================
+// Search mode → applet
+// ============================================================================
+
+namespace {
+CompanySearchMode effectiveMode(const CompanyFilter& filter, eSAClient client)
+{
+    if (client != SA_PostgreSQL_Client) {
+        return CompanySearchMode::Like;  // no pg_trgm (SQLite etc.)
+    }
+    if (filter.mode == CompanySearchMode::Similar && filter.value.empty()) {
+        // Nothing is similar to ''; list everything like the other modes do
+        return CompanySearchMode::Trigram;
+    }
+    return filter.mode;
+}
+} // namespace
+
+const char* CompanyRepository::selectApplet(const CompanyFilter& filter, eSAClient client)
+{
+    switch (effectiveMode(filter, client)) {
+    case CompanySearchMode::Trigram: return "company_search.sql";
+    case CompanySearchMode::Similar: return "company_similar.sql";
+    default:                         return "company_select.sql";
+    }
+}
+
+const char* CompanyRepository::countApplet(const CompanyFilter& filter, eSAClient client)
+{
+    switch (effectiveMode(filter, client)) {
+    case CompanySearchMode::Trigram: return "company_search_count.sql";
+    case CompanySearchMode::Similar: return "company_similar_count.sql";
+    default:                         return "company_count.sql";
+    }
+}
+
+const char* CompanyRepository::estimateApplet(const CompanyFilter& filter, eSAClient client)
+{
+    switch (effectiveMode(filter, client)) {
+    case CompanySearchMode::Trigram: return "company_search_count_estimate.sql";
+    case CompanySearchMode::Similar: return "company_similar_count_estimate.sql";
+    default:                         return "company_count_estimate.sql";
+    }
+}
+
+const char* CompanyRepository::lockApplet(eSAClient client)
+{
+    return client == SA_SQLite_Client ? "company_lock_row_sqlite.sql" : "company_lock_row.sql";
+}
+
+#ifdef MEDICON_COMPILED_APPLETS
+// ============================================================================
+// Compiled applets (MEDICON_COMPILED_APPLETS)
+// ============================================================================
+
+namespace {
+/// Call @p visit with the generated select wrapper for @p mode
+template <typename Visitor>
+auto visitSelectApplet(CompanySearchMode mode, Visitor&& visit)
+{
+    switch (mode) {
+    case CompanySearchMode::Trigram: return visit(sql_applets::CompanySearch{});
+    case CompanySearchMode::Similar: return visit(sql_applets::CompanySimilar{});
+    default:                         return visit(sql_applets::CompanySelect{});
+    }
+}
+
+/// Call @p visit with the generated count wrapper for @p mode
+template <typename Visitor>
+auto visitCountApplet(CompanySearchMode mode, Visitor&& visit)
+{
+    switch (mode) {
+    case CompanySearchMode::Trigram: return visit(sql_applets::CompanySearchCount{});
+    case CompanySearchMode::Similar: return visit(sql_applets::CompanySimilarCount{});
+    default:                         return visit(sql_applets::CompanyCount{});
+    }
+}
+
+/// Copy @p filter into the typed members; unset fields keep the applet defaults
+template <typename Applet>
+void applyFilter(Applet& applet, const CompanyFilter& filter)
+{
+    applet.SERVER_UID = filter.server_uid;
+    if (!filter.field.empty()) applet.FILTER_FIELD = filter.field;
+    if (!filter.value.empty()) applet.FILTER_VALUE = filter.value;
+    if constexpr (requires { applet.OFFSET; applet.LIMIT; }) {
+        applet.OFFSET = filter.offset;
+        applet.LIMIT = filter.limit;
+    }
+}
+
+/// Prepare, bind and execute @p applet; rows are read with query()
+template <typename Applet>
+void executeApplet(SqlDirectQuery& cmd, const Applet& applet)
+{
+    applet.bind(cmd);
+    cmd.executeWithTimeout(Applet::TIMEOUT);
+}
+
+/// Applet SQL with :NAME markers; $FILTER_FIELD goes through COMPANY_COLUMNS
+template <typename Applet>
+string appletSql(const Applet& applet)
+{
+    if constexpr (requires { Applet::sql(); }) {
+        return Applet::sql();
+    } else {
+        return applet.sql(COMPANY_COLUMNS);
+    }
+}
+} // namespace
+#endif
+
 // ============================================================================
 // Query
 // ============================================================================
 
 vector<CompanyData> CompanyRepository::query(const CompanyFilter& filter)
 {
+#ifdef MEDICON_COMPILED_APPLETS
+    ensureConnected();
+
+    const auto mode = effectiveMode(filter, m_conn.connectionSa()->Client());
+    return visitSelectApplet(mode, [&](auto applet) {
+        applyFilter(applet, filter);
+        const string sql = appletSql(applet);
+        LOG_IF(m_logSql, INFO) << "[SQL] " << applet.FILE_NAME << ": " << sql;
+
+        SqlDirectQuery cmd(m_conn, SAString(sql.c_str()));
+        executeApplet(cmd, applet);
+        vector<CompanyData> rows;
+        CompanyRowReader readRow;
+        while (cmd.query()) {
+            rows.push_back(readRow(cmd));
+        }
+        return rows;
+    });
+#else
     // Build param map from structured filter
     std::map<std::string, std::string> params;
     params["SERVER_UID"] = std::to_string(filter.server_uid);
@@ -219,16 +450,14 @@ vector<CompanyData> CompanyRepository::query(const CompanyFilter& filter)
 
     ensureConnected();
 
-    SqlQuery cmd(m_conn, sqlPath("company_select.sql"), std::move(params));
+    const char* applet = selectApplet(filter, m_conn.connectionSa()->Client());
+    SqlQuery cmd(m_conn, sqlPath(applet), std::move(params));
     cmd.setColumnValidator("FILTER_FIELD", &COMPANY_COLUMNS);
 
-    LOG_IF(m_logSql, INFO) << "[SQL] company_select: " << cmd.getSqlWithParameters();
+    LOG_IF(m_logSql, INFO) << "[SQL] " << applet << ": " << cmd.getSqlWithParameters();
 
-    vector<CompanyData> results;
-    while (cmd.query()) {
-        results.push_back(rowToCompany(cmd));
-    }
-    return results;
+    return cmd.fetchAll<CompanyData>(CompanyRowReader());
+#endif
 }
 
 // ============================================================================
@@ -239,23 +468,62 @@ std::optional<CompanyData> CompanyRepository::findByUid(std::string_view uid)
 {
     ensureConnected();
 
+#ifdef MEDICON_COMPILED_APPLETS
+    sql_applets::CompanySelectByUid applet;
+    applet.UID = uid;
+    LOG_IF(m_logSql, INFO) << "[SQL] company_select_by_uid: " << applet.SQL;
+
+    SqlDirectQuery cmd(m_conn, SAString(applet.SQL.data()));
+    executeApplet(cmd, applet);
+#else
     SqlQuery cmd(m_conn, sqlPath("company_select_by_uid.sql"));
     cmd.addParameter("UID", uid.data());
 
     LOG_IF(m_logSql, INFO) << "[SQL] company_select_by_uid: " << cmd.getSqlWithParameters();
+#endif
 
     if (cmd.query()) {
-        return rowToCompany(cmd);
+        return CompanyRowReader()(cmd);
     }
     return std::nullopt;
 }
 
+vector<CompanyData> CompanyRepository::findByUids(const vector<string>& uids)
+{
+    if (uids.empty()) {
+        return {};
+    }
+    ensureConnected();
+
+    // No compiled wrapper: the statement text depends on the array binding
+    SqlQuery cmd(m_conn, sqlPath("company_select_by_uids.sql"));
+    cmd.addParameter("UIDS", uids);
+
+    LOG_IF(m_logSql, INFO) << "[SQL] company_select_by_uids: " << cmd.getSqlWithParameters();
+
+    return cmd.fetchAll<CompanyData>(CompanyRowReader());
+}
+
 // ============================================================================
 // Count
 // ============================================================================
 
 int64_t CompanyRepository::count(const CompanyFilter& filter)
 {
+#ifdef MEDICON_COMPILED_APPLETS
+    ensureConnected();
+
+    const auto mode = effectiveMode(filter, m_conn.connectionSa()->Client());
+    return visitCountApplet(mode, [&](auto applet) -> int64_t {
+        applyFilter(applet, filter);
+        const string sql = appletSql(applet);
+        LOG_IF(m_logSql, INFO) << "[SQL] " << applet.FILE_NAME << ": " << sql;
+
+        SqlDirectQuery cmd(m_conn, SAString(sql.c_str()));
+        executeApplet(cmd, applet);
+        return cmd.query() ? cmd.Field("ROW_COUNT").asInt64() : 0;
+    });
+#else
     std::map<std::string, std::string> params;
     params["SERVER_UID"] = std::to_string(filter.server_uid);
     if (!filter.field.empty()) params["FILTER_FIELD"] = filter.field;
@@ -263,13 +531,124 @@ int64_t CompanyRepository::count(const CompanyFilter& filter)
 
     ensureConnected();
 
-    SqlQuery cmd(m_conn, sqlPath("company_count.sql"), std::move(params));
+    const char* applet = countApplet(filter, m_conn.connectionSa()->Client());
+    SqlQuery cmd(m_conn, sqlPath(applet), std::move(params));
     cmd.setColumnValidator("FILTER_FIELD", &COMPANY_COLUMNS);
 
-    LOG_IF(m_logSql, INFO) << "[SQL] company_count: " << cmd.getSqlWithParameters();
+    LOG_IF(m_logSql, INFO) << "[SQL] " << applet << ": " << cmd.getSqlWithParameters();
 
-    if (cmd.query()) {
-        return cmd.Field("ROW_COUNT").asInt64();
+    const auto counts = cmd.fetchAll<int64_t>([](SACommand& row) {
+        return row.Field("ROW_COUNT").asInt64();
+    });
+    return counts.empty() ? 0 : counts.front();
+#endif
+}
+
+// ============================================================================
+// Estimated count
+// ============================================================================
+
+std::optional<int64_t> CompanyRepository::estimateCount(const CompanyFilter& filter)
+{
+    ensureConnected();
+    const eSAClient client = m_conn.connectionSa()->Client();
+    if (client != SA_PostgreSQL_Client) {
+        return std::nullopt;
+    }
+
+    std::map<std::string, std::string> params;
+    params["SERVER_UID"] = std::to_string(filter.server_uid);
+    if (!filter.field.empty()) params["FILTER_FIELD"] = filter.field;
+    if (!filter.value.empty()) params["FILTER_VALUE"] = filter.value;
+
+    // EXPLAIN the same predicate count() would run for this search mode
+    const char* applet = estimateApplet(filter, client);
+    SqlQuery cmd(m_conn, sqlPath(applet), std::move(params));
+    cmd.setColumnValidator("FILTER_FIELD", &COMPANY_COLUMNS);
+
+    LOG_IF(m_logSql, INFO) << "[SQL] " << applet << ": " << cmd.getSqlWithParameters();
+
+    if (!cmd.query()) {
+        return std::nullopt;
+    }
+    // EXPLAIN (FORMAT JSON) yields one row: [{"Plan": {"Plan Rows": N, ...}}]
+    auto plan = nlohmann::json::parse(cmd.Field(1).asString().GetMultiByteChars(),
+                                      nullptr, /*allow_exceptions=*/false);
+    if (!plan.is_array() || plan.empty() || !plan[0].contains("Plan")) {
+        return std::nullopt;
+    }
+    const auto& rows = plan[0]["Plan"]["Plan Rows"];
+    if (!rows.is_number()) {
+        return std::nullopt;
+    }
+    return static_cast<int64_t>(rows.get<double>());
+}
+
+// ============================================================================
+// Delta sync
+// ============================================================================
+
+CompanyDelta CompanyRepository::sync(int serverUid, int64_t sinceVersion, int limit, bool snapshot)
+{
+    ensureConnected();
+
+    // Tombstones up to PRUNED_VERSION are gone: an older client may have
+    // missed a delete and has to start over
+    if (sinceVersion > 0 && !snapshot) {
+        SqlQuery cmd(m_conn, sqlPath("company_sync_horizon.sql"));
+        cmd.addParameter("SERVER_UID", serverUid);
+        LOG_IF(m_logSql, INFO) << "[SQL] company_sync_horizon: " << cmd.getSqlWithParameters();
+        if (cmd.query() && sinceVersion < cmd.Field("PRUNED_VERSION").asInt64()) {
+            CompanyDelta delta;
+            delta.reset = true;
+            return delta;
+        }
+    }
+
+    // Fetch one extra row from each source: the merged first `limit`
+    // entries are then exactly the oldest `limit` changes overall.
+    std::map<std::string, std::string> params;
+    params["SERVER_UID"] = std::to_string(serverUid);
+    params["SINCE_VERSION"] = std::to_string(sinceVersion);
+    params["LIMIT"] = std::to_string(limit + 1);
+
+    vector<CompanyData> changed;
+    {
+        SqlQuery cmd(m_conn, sqlPath("company_sync.sql"), params);
+        LOG_IF(m_logSql, INFO) << "[SQL] company_sync: " << cmd.getSqlWithParameters();
+        CompanyRowReader readRow;
+        while (cmd.query()) {
+            changed.push_back(readRow(cmd));
+        }
+    }
+
+    vector<std::pair<int64_t, string>> tombstones;
+    {
+        SqlQuery cmd(m_conn, sqlPath("company_sync_tombstones.sql"), std::move(params));
+        LOG_IF(m_logSql, INFO) << "[SQL] company_sync_tombstones: " << cmd.getSqlWithParameters();
+        while (cmd.query()) {
+            tombstones.emplace_back(cmd.Field("ROW_VERSION").asInt64(),
+                                    cmd.Field("UID").asString().GetMultiByteChars());
+        }
+    }
+
+    // Merge both version-ordered lists, keeping at most `limit` entries
+    CompanyDelta delta;
+    delta.version = sinceVersion;
+    size_t c = 0, t = 0;
+    int taken = 0;
+    while (taken < limit && (c < changed.size() || t < tombstones.size())) {
+        const bool takeChanged = t >= tombstones.size() ||
+            (c < changed.size() && changed[c].row_version < tombstones[t].first);
+        if (takeChanged) {
+            delta.version = changed[c].row_version;
+            delta.changed.push_back(std::move(changed[c++]));
+        } else {
+            delta.version = tombstones[t].first;
+            delta.deleted_uids.push_back(std::move(tombstones[t++].second));
+        }
+        ++taken;
     }
-    return 0;
+    delta.has_more = c < changed.size() || t < tombstones.size();
+    return delta;
 }
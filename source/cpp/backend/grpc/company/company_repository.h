@@ -7,6 +7,8 @@
 #include "sqlquery.h"
 #include "sqltemplate.h"
 
+#include <chrono>
+
 /**
  * @brief Repository layer for company CRUD operations
  *
@@ -17,20 +19,93 @@
  */
 class CompanyRepository {
 public:
+    /**
+     * @param rowCounters maintain company_row_counter on add/remove and on
+     *        updates that move a row to another SERVER_UID
+     *        (schema/004_company_row_counter.sql)
+     */
     CompanyRepository(SqlConnection& conn, std::string_view appletPath,
-                     bool logSql = false);
+                     bool logSql = false, bool rowCounters = false);
     virtual ~CompanyRepository() = default;
 
     // CRUD operations
     virtual CompanyData add(const CompanyData& data);
-    virtual CompanyData update(const CompanyData& data);
+    virtual UpdateResult update(const CompanyData& data);
     virtual DeleteResult remove(std::string_view uid);
 
     // Query operations
     virtual std::vector<CompanyData> query(const CompanyFilter& filter);
     virtual std::optional<CompanyData> findByUid(std::string_view uid);
+
+    /**
+     * @brief Rows whose UID is in @p uids, in no particular order
+     *
+     * One statement for the whole list (company_select_by_uids.sql).
+     */
+    virtual std::vector<CompanyData> findByUids(const std::vector<std::string>& uids);
     virtual int64_t count(const CompanyFilter& filter);
 
+    /**
+     * @brief Planner row estimate for @p filter (EXPLAIN, PostgreSQL only)
+     *
+     * Explains the predicate of the count applet for the filter's search
+     * mode (estimateApplet()).
+     * @return std::nullopt where no estimate is available
+     */
+    virtual std::optional<int64_t> estimateCount(const CompanyFilter& filter);
+
+    /// Number of rows of @p serverUid from company_row_counter (O(shards))
+    virtual int64_t rowCount(int serverUid);
+
+    /**
+     * @brief Correct company_row_counter drift
+     *
+     * Must run inside a transaction: locks the counter table against
+     * concurrent adjustments until commit.
+     * @param serverUid tenant to check, or < 0 for every tenant
+     * @return number of tenants whose counter was corrected
+     */
+    virtual int reconcileRowCounts(int serverUid = -1);
+
+    /// Connection the repository works on (e.g. for a SavepointScope)
+    SqlConnection& connection() noexcept { return m_conn; }
+
+    /// Counter rows per tenant; writers spread over them to avoid a hot row
+    static constexpr int COUNTER_SHARDS = 8;
+
+    /**
+     * @brief Rows and tombstones of @p serverUid with ROW_VERSION > @p sinceVersion
+     *
+     * A @p sinceVersion below the tenant's PRUNED_VERSION may have missed
+     * pruned tombstones: the delta is then empty with @c reset set, unless
+     * @p snapshot says the caller is paging a fresh snapshot from version 0.
+     * Runs three reads; call it in a TransactionOptions::snapshot()
+     * transaction (CompanyService::syncCompanies does) so that they agree.
+     */
+    virtual CompanyDelta sync(int serverUid, int64_t sinceVersion, int limit, bool snapshot);
+
+    /**
+     * @brief Drop tombstones older than @p retention
+     *
+     * Must run inside a transaction (PostgreSQL only). Raises each tenant's
+     * PRUNED_VERSION before its tombstones go.
+     * @return number of tombstones removed
+     */
+    virtual int64_t pruneTombstones(std::chrono::seconds retention);
+
+    /**
+     * @brief Applet that answers @p filter on a @p client database
+     *
+     * Trigram/Similar need PostgreSQL with pg_trgm; elsewhere, and for an
+     * empty search term, the portable LIKE applets are used.
+     */
+    static const char* selectApplet(const CompanyFilter& filter, eSAClient client);
+    static const char* countApplet(const CompanyFilter& filter, eSAClient client);
+    static const char* estimateApplet(const CompanyFilter& filter, eSAClient client);
+
+    /// Row lock of update(): SELECT ... FOR UPDATE, or a no-op UPDATE on SQLite
+    static const char* lockApplet(eSAClient client);
+
 private:
     [[nodiscard]] std::string sqlPath(const char* name) const;
 
@@ -40,10 +115,17 @@ private:
     /// Bind all template parameters to a command (shared by add/update)
     static void bindParams(SACommand& cmd, const SqlTemplate& tpl);
 
-    // Result mapping helper
-    static CompanyData rowToCompany(SACommand& row);
+    /// Add @p delta to a random counter shard of @p serverUid
+    void adjustRowCount(int serverUid, int delta);
+
+    /// Take the next ROW_VERSION of @p serverUid (company_sync_clock_bump.sql)
+    int64_t nextRowVersion(int serverUid);
+
+    /// Record that @p uid left @p serverUid (delete or move to another tenant)
+    void addTombstone(std::string_view uid, int serverUid);
 
     SqlConnection& m_conn;
     std::string m_appletPath;
     bool m_logSql = false;
+    bool m_rowCounters = false;
 };
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "company_types.h"
+#include "table_schema.h"
+
+/**
+ * @brief Columns of the company table and the CompanyData members they map to
+ *
+ * Single source for COMPANY_COLUMNS, CompanyRowReader and the insert/update
+ * parameters; company_server.cpp binds the same members to the proto fields.
+ */
+struct CompanySchema {
+    using Row = CompanyData;
+
+    static constexpr std::tuple columns{
+        schemaColumn("UID",          DataInfo::String, &CompanyData::uid,          SchemaFilter),
+        schemaColumn("SERVER_UID",   DataInfo::Int,    &CompanyData::server_uid,   SchemaFilter | SchemaWrite),
+        schemaColumn("COMPANY_TYPE", DataInfo::Int,    &CompanyData::company_type, SchemaFilter | SchemaWrite),
+        schemaColumn("NAME",         DataInfo::String, &CompanyData::name,         SchemaFilter | SchemaWrite | SchemaTrim),
+        schemaColumn("ADDRESS",      DataInfo::String, &CompanyData::address,      SchemaFilter | SchemaWrite | SchemaTrim),
+        schemaColumn("REG_DATE",     DataInfo::Date,   &CompanyData::reg_date,     SchemaFilter | SchemaWrite),
+        schemaColumn("JOINT_DATE",   DataInfo::Date,   &CompanyData::joint_date,   SchemaFilter | SchemaWrite),
+        schemaColumn("LICENSE",      DataInfo::String, &CompanyData::license,      SchemaFilter | SchemaWrite | SchemaTrim),
+        schemaColumn("LOGO",         DataInfo::String, &CompanyData::logo,         SchemaFilter | SchemaBytes),
+        schemaColumn("ROW_VERSION",  DataInfo::Int64,  &CompanyData::row_version),
+    };
+};
+
+/// Maps company result rows by ordinal; one per result set
+using CompanyRowReader = SchemaRowReader<CompanySchema>;
@@ -1,14 +1,26 @@
 #include "company_server.h"
 
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
-#include <grpcpp/health_check_service_interface.h>
 #include <absl/strings/str_format.h>
 
+#include <algorithm>
+#include <chrono>
+#include <charconv>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
+#include "company_change_listener.h"
+#include "company_counter_reconciler.h"
+#include "company_health_service.h"
+#include "company_schema.h"
+#include "company_tombstone_pruner.h"
 #include "JsonParameterFormatter.h"
 #include "include_backend_util.h"
+#include "sqlpoolmaintainer.h"
+#include "sqltemplatecache.h"
 #include <easylogging++.h>
 
 using grpc::Server;
@@ -22,9 +34,21 @@ using CompanyEdit::CompanyResult;
 using CompanyEdit::CompanyList;
 using CompanyEdit::JsonParameters;
 using CompanyEdit::CompanyUid;
+using CompanyEdit::CompanyUids;
+using CompanyEdit::CompanyLookup;
 using CompanyEdit::TotalCount;
+using CompanyEdit::CompanyQuery;
+using CompanyEdit::CompanyFilterField;
+using CompanyEdit::WatchRequest;
+using CompanyEdit::CompanyChange;
 using std::string; 
 
+namespace {
+constexpr std::string_view CURSOR_PREFIX = "o:";
+// Pause before a failed startup warm-up is tried again
+constexpr std::chrono::seconds WARMUP_RETRY{5};
+}
+
 // ============================================================================
 // Construction
 // ============================================================================
@@ -40,18 +64,26 @@ CompanyServiceImpl::CompanyServiceImpl(
 // Protobuf ↔ Domain type conversion
 // ============================================================================
 
+namespace {
+/// CompanySchema members ↔ Company fields
+const std::tuple COMPANY_PROTO_FIELDS{
+    protoField(&CompanyData::uid, &Company::uid, protoStringSetter<Company>(&Company::set_uid)),
+    protoField(&CompanyData::server_uid, &Company::server_uid, &Company::set_server_uid),
+    protoField(&CompanyData::company_type, &Company::company_type, &Company::set_company_type),
+    protoField(&CompanyData::name, &Company::name, protoStringSetter<Company>(&Company::set_name)),
+    protoField(&CompanyData::address, &Company::address, protoStringSetter<Company>(&Company::set_address)),
+    protoField(&CompanyData::reg_date, &Company::reg_date, &Company::set_reg_date),
+    protoField(&CompanyData::joint_date, &Company::joint_date, &Company::set_joint_date),
+    protoField(&CompanyData::license, &Company::license, protoStringSetter<Company>(&Company::set_license)),
+    protoField(&CompanyData::logo, &Company::logo, protoStringSetter<Company>(&Company::set_logo)),
+    protoField(&CompanyData::row_version, &Company::row_version, &Company::set_row_version),
+};
+} // namespace
+
 CompanyData CompanyServiceImpl::toCompanyData(const Company& company)
 {
     CompanyData data;
-    data.uid = company.uid();
-    data.server_uid = company.server_uid();
-    data.company_type = company.company_type();
-    data.name = company.name();
-    data.address = company.address();
-    data.reg_date = std::chrono::milliseconds(company.reg_date());
-    data.joint_date = std::chrono::milliseconds(company.joint_date());
-    data.license = company.license();
-    data.logo = company.logo();
+    copyFromProto(COMPANY_PROTO_FIELDS, company, data);
     return data;
 }
 
@@ -72,6 +104,8 @@ CompanyFilter CompanyServiceImpl::toCompanyFilter(const JsonParameters& params)
     if (it != map.end()) filter.field = it->second;
     it = map.find("FILTER_VALUE");
     if (it != map.end()) filter.value = it->second;
+    it = map.find("SEARCH_MODE");
+    if (it != map.end()) filter.mode = toSearchMode(it->second);
     it = map.find("OFFSET");
     if (it != map.end()) filter.offset = std::stoi(it->second);
     it = map.find("LIMIT");
@@ -79,17 +113,126 @@ CompanyFilter CompanyServiceImpl::toCompanyFilter(const JsonParameters& params)
     return filter;
 }
 
+CompanyFilter CompanyServiceImpl::toCompanyFilter(const CompanyQuery& query)
+{
+    CompanyFilter filter;
+    filter.server_uid = query.server_uid();
+    filter.field = toColumnName(query.filter_field());
+    filter.value = query.filter_value();
+    filter.mode = toSearchMode(query.search_mode());
+    filter.offset = decodeCursor(query.cursor());
+    filter.limit = query.limit() > 0 ? std::min(query.limit(), MAX_PAGE_SIZE)
+                                     : DEFAULT_PAGE_SIZE;
+    return filter;
+}
+
+const char* CompanyServiceImpl::toColumnName(CompanyFilterField field)
+{
+    switch (field) {
+    case CompanyEdit::FILTER_FIELD_NAME:     return "NAME";
+    case CompanyEdit::FILTER_FIELD_ADDRESS:  return "ADDRESS";
+    case CompanyEdit::FILTER_FIELD_LICENSE:  return "LICENSE";
+    case CompanyEdit::FILTER_FIELD_UID:      return "UID";
+    default:                                 return "";  // template default
+    }
+}
+
+CompanySearchMode CompanyServiceImpl::toSearchMode(CompanyEdit::CompanySearchMode mode)
+{
+    switch (mode) {
+    case CompanyEdit::SEARCH_MODE_TRIGRAM: return CompanySearchMode::Trigram;
+    case CompanyEdit::SEARCH_MODE_SIMILAR: return CompanySearchMode::Similar;
+    default:                               return CompanySearchMode::Like;
+    }
+}
+
+CountAccuracy CompanyServiceImpl::toCountAccuracy(CompanyEdit::CountAccuracy accuracy)
+{
+    return accuracy == CompanyEdit::COUNT_ESTIMATE ? CountAccuracy::Estimate
+                                                   : CountAccuracy::Exact;
+}
+
+CountAccuracy CompanyServiceImpl::toCountAccuracy(const JsonParameters& params)
+{
+    auto mapOpt = JsonParameterFormatter::tryFromJsonString(params.jsonparams());
+    if (mapOpt) {
+        auto it = mapOpt->find("COUNT_ACCURACY");
+        if (it != mapOpt->end() && it->second == "ESTIMATE") {
+            return CountAccuracy::Estimate;
+        }
+    }
+    return CountAccuracy::Exact;
+}
+
+CompanySearchMode CompanyServiceImpl::toSearchMode(std::string_view name)
+{
+    if (name == "TRIGRAM") return CompanySearchMode::Trigram;
+    if (name == "SIMILAR") return CompanySearchMode::Similar;
+    return CompanySearchMode::Like;
+}
+
+string CompanyServiceImpl::encodeCursor(int offset)
+{
+    return string(CURSOR_PREFIX) + std::to_string(offset);
+}
+
+int CompanyServiceImpl::decodeCursor(std::string_view cursor)
+{
+    // Unknown or damaged cursors restart from the first page
+    if (!cursor.starts_with(CURSOR_PREFIX)) {
+        return 0;
+    }
+    cursor.remove_prefix(CURSOR_PREFIX.size());
+
+    int offset = 0;
+    auto [ptr, ec] = std::from_chars(cursor.data(), cursor.data() + cursor.size(), offset);
+    if (ec != std::errc() || ptr != cursor.data() + cursor.size() || offset < 0) {
+        return 0;
+    }
+    return offset;
+}
+
 void CompanyServiceImpl::toProto(const CompanyData& data, Company* proto)
 {
-    proto->set_uid(data.uid);
-    proto->set_server_uid(data.server_uid);
-    proto->set_company_type(data.company_type);
-    proto->set_name(data.name);
-    proto->set_address(data.address);
-    proto->set_reg_date(data.reg_date.count());
-    proto->set_joint_date(data.joint_date.count());
-    proto->set_license(data.license);
-    proto->set_logo(data.logo);
+    copyToProto(COMPANY_PROTO_FIELDS, data, *proto);
+}
+
+void CompanyServiceImpl::toProto(const CompanyChangeEvent& event, uint64_t epoch,
+                                 CompanyChange* proto)
+{
+    proto->set_epoch(epoch);
+    proto->set_sequence(event.sequence);
+    proto->set_operation(static_cast<CompanyEdit::ChangeOperation>(event.op));
+    proto->set_uid(event.uid);
+    proto->set_server_uid(event.server_uid);
+}
+
+void CompanyServiceImpl::toProto(const CompanyDelta& delta, SyncResponse* proto)
+{
+    for (const auto& data : delta.changed) {
+        toProto(data, proto->add_changed());
+    }
+    for (const auto& uid : delta.deleted_uids) {
+        proto->add_deleted_uids(uid);
+    }
+    proto->set_version(delta.version);
+    proto->set_has_more(delta.has_more);
+    proto->set_reset(delta.reset);
+}
+
+void CompanyServiceImpl::toProto(const CompanyLookupData& lookup, CompanyLookup* proto)
+{
+    for (const auto& data : lookup.rows) {
+        toProto(data, proto->add_companies());
+    }
+    for (const auto& uid : lookup.missing_uids) {
+        proto->add_missing_uids(uid);
+    }
+}
+
+int CompanyServiceImpl::syncBatchSize(int requested)
+{
+    return requested > 0 ? std::min(requested, MAX_SYNC_BATCH) : DEFAULT_SYNC_BATCH;
 }
 
 // ============================================================================
@@ -158,6 +301,11 @@ Status CompanyServiceImpl::EditCompany(ServerContext*, const Company* company,
         result->set_success(false);
         result->set_error(e.ErrText().GetMultiByteChars());
         return Status::CANCELLED;
+    } catch (const CompanyShardMoveException& e) {
+        LOG(WARNING) << e.what();
+        result->set_success(false);
+        result->set_error(e.what());
+        return Status(StatusCode::FAILED_PRECONDITION, e.what());
     } catch (const std::exception& e) {
         LOG(ERROR) << e.what();
         result->set_success(false);
@@ -259,6 +407,36 @@ Status CompanyServiceImpl::QueryCompanyByUid(ServerContext*,
     }
 }
 
+// ============================================================================
+// gRPC — QueryCompaniesByUids (multi-get)
+// ============================================================================
+
+Status CompanyServiceImpl::QueryCompaniesByUids(ServerContext*,
+                                                 const CompanyUids* request,
+                                                 CompanyLookup* response)
+{
+    if (request->uids_size() > MAX_LOOKUP_UIDS) {
+        return Status(StatusCode::INVALID_ARGUMENT,
+                      "at most " + std::to_string(MAX_LOOKUP_UIDS) + " uids per request");
+    }
+
+    try {
+        const std::vector<string> uids(request->uids().begin(), request->uids().end());
+        toProto(m_service->getCompaniesByUids(uids), response);
+        return Status::OK;
+    } catch (const SAException& e) {
+        LOG(ERROR) << e.ErrText().GetMultiByteChars();
+        logError("QueryCompaniesByUids", "SQL error");
+        return Status::CANCELLED;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in QueryCompaniesByUids";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
 // ============================================================================
 // gRPC — QueryCompanyTotalCount
 // ============================================================================
@@ -269,8 +447,9 @@ Status CompanyServiceImpl::QueryCompanyTotalCount(ServerContext*,
 {
     try {
         CompanyFilter filter = toCompanyFilter(*request);
-        int64_t count = m_service->countCompanies(filter);
-        response->set_count(count);
+        CompanyCount count = m_service->countCompanies(filter, toCountAccuracy(*request));
+        response->set_count(count.count);
+        response->set_estimated(count.estimated);
         return Status::OK;
     } catch (const SAException& e) {
         LOG(ERROR) << e.ErrText().GetMultiByteChars();
@@ -285,6 +464,205 @@ Status CompanyServiceImpl::QueryCompanyTotalCount(ServerContext*,
     }
 }
 
+// ============================================================================
+// gRPC — ListCompanies (typed)
+// ============================================================================
+
+Status CompanyServiceImpl::ListCompanies(ServerContext*,
+                                          const CompanyQuery* query,
+                                          CompanyList* list)
+{
+    try {
+        CompanyFilter filter = toCompanyFilter(*query);
+        auto results = m_service->queryCompanies(filter);
+        for (const auto& data : results) {
+            toProto(data, list->add_companies());
+        }
+        // A full page means there may be more rows
+        if (static_cast<int>(results.size()) == filter.limit) {
+            list->set_next_cursor(encodeCursor(filter.offset + filter.limit));
+        }
+        return Status::OK;
+    } catch (const SAException& e) {
+        LOG(ERROR) << e.ErrText().GetMultiByteChars();
+        logError("ListCompanies", "SQL error");
+        return Status::CANCELLED;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in ListCompanies";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
+// ============================================================================
+// gRPC — CountCompanies (typed)
+// ============================================================================
+
+Status CompanyServiceImpl::CountCompanies(ServerContext*,
+                                           const CompanyQuery* query,
+                                           TotalCount* response)
+{
+    try {
+        CompanyFilter filter = toCompanyFilter(*query);
+        CompanyCount count = m_service->countCompanies(
+            filter, toCountAccuracy(query->count_accuracy()));
+        response->set_count(count.count);
+        response->set_estimated(count.estimated);
+        return Status::OK;
+    } catch (const SAException& e) {
+        LOG(ERROR) << e.ErrText().GetMultiByteChars();
+        logError("CountCompanies", "SQL error");
+        return Status::CANCELLED;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in CountCompanies";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
+// ============================================================================
+// gRPC — ListCompanyPage (page + total, one snapshot)
+// ============================================================================
+
+Status CompanyServiceImpl::ListCompanyPage(ServerContext*,
+                                            const CompanyQuery* query,
+                                            CompanyPage* page)
+{
+    try {
+        CompanyFilter filter = toCompanyFilter(*query);
+        CompanyPageData result = m_service->queryCompanyPage(filter);
+        for (const auto& data : result.rows) {
+            toProto(data, page->add_companies());
+        }
+        if (static_cast<int>(result.rows.size()) == filter.limit) {
+            page->set_next_cursor(encodeCursor(filter.offset + filter.limit));
+        }
+        page->set_total_count(static_cast<uint64_t>(result.total));
+        return Status::OK;
+    } catch (const SAException& e) {
+        LOG(ERROR) << e.ErrText().GetMultiByteChars();
+        logError("ListCompanyPage", "SQL error");
+        return Status::CANCELLED;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in ListCompanyPage";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
+// ============================================================================
+// gRPC — WatchCompanies (server streaming)
+// ============================================================================
+
+Status CompanyServiceImpl::WatchCompanies(ServerContext* context,
+                                           const WatchRequest* request,
+                                           grpc::ServerWriter<CompanyChange>* writer)
+{
+    try {
+        CompanyChangeFeed& feed = *m_service->changeFeed();
+        const auto heartbeat = std::chrono::duration_cast<std::chrono::milliseconds>(
+            m_service->options().watchHeartbeat);
+        const int serverUid = request->server_uid();
+
+        auto sendControl = [&](CompanyEdit::ChangeOperation op, uint64_t sequence) {
+            CompanyChange change;
+            change.set_epoch(feed.epoch());
+            change.set_sequence(sequence);
+            change.set_operation(op);
+            change.set_server_uid(serverUid);
+            return writer->Write(change);
+        };
+
+        // Resume only within the same feed epoch (i.e. same server process)
+        uint64_t cursor = feed.lastSequence();
+        bool resumeLost = false;
+        if (request->has_resume_sequence()) {
+            if (request->epoch() == feed.epoch()) {
+                cursor = request->resume_sequence();
+            } else {
+                resumeLost = true;
+            }
+        }
+
+        // First message tells the client the epoch and its resume point
+        if (!sendControl(resumeLost ? CompanyEdit::CHANGE_RESET : CompanyEdit::CHANGE_HEARTBEAT,
+                         cursor)) {
+            return Status::OK;  // client went away
+        }
+
+        while (!context->IsCancelled()) {
+            auto batch = feed.waitForChanges(serverUid, cursor, heartbeat);
+            if (batch.closed) {
+                break;
+            }
+            if (batch.resumeGap && !sendControl(CompanyEdit::CHANGE_RESET, batch.lastSequence)) {
+                break;
+            }
+            bool alive = true;
+            for (const auto& event : batch.events) {
+                CompanyChange change;
+                toProto(event, feed.epoch(), &change);
+                if (!writer->Write(change)) {
+                    alive = false;
+                    break;
+                }
+            }
+            if (!alive) {
+                break;
+            }
+            if (batch.events.empty() && !batch.resumeGap &&
+                !sendControl(CompanyEdit::CHANGE_HEARTBEAT, batch.lastSequence)) {
+                break;
+            }
+            cursor = batch.lastSequence;
+        }
+        return Status::OK;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in WatchCompanies";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
+// ============================================================================
+// gRPC — SyncCompanies (delta sync)
+// ============================================================================
+
+Status CompanyServiceImpl::SyncCompanies(ServerContext*,
+                                          const SyncRequest* request,
+                                          SyncResponse* response)
+{
+    try {
+        if (request->since_version() < 0) {
+            return Status(StatusCode::INVALID_ARGUMENT, "since_version must not be negative");
+        }
+        CompanyDelta delta = m_service->syncCompanies(request->server_uid(),
+                                                      request->since_version(),
+                                                      syncBatchSize(request->limit()),
+                                                      request->snapshot());
+        toProto(delta, response);
+        return Status::OK;
+    } catch (const SAException& e) {
+        LOG(ERROR) << e.ErrText().GetMultiByteChars();
+        logError("SyncCompanies", "SQL error");
+        return Status::CANCELLED;
+    } catch (const std::exception& e) {
+        LOG(ERROR) << e.what();
+        return Status(StatusCode::INTERNAL, e.what());
+    } catch (...) {
+        LOG(ERROR) << "Unknown error in SyncCompanies";
+        return Status(StatusCode::ABORTED, "Unknown error!");
+    }
+}
+
 // ============================================================================
 // Server entry point
 // ============================================================================
@@ -293,25 +671,120 @@ void RunCompanyServer(uint16_t port, bool logSql,
                       const std::string& appletPath,
                       const std::string& dbHost,
                       const std::string& dbUser,
-                      const std::string& dbPass)
+                      const std::string& dbPass,
+                      const CompanyServiceOptions& options)
 {
     auto service = std::make_unique<CompanyService>(
-        appletPath, dbHost, dbUser, dbPass, logSql);
+        appletPath, dbHost, dbUser, dbPass, logSql, options);
 
+    // Dedicated LISTEN connection per shard feeding WatchCompanies from NOTIFY triggers,
+    // periodic drift correction for company_row_counter and tombstone retention on every shard
+    std::vector<std::unique_ptr<CompanyChangeListener>> listeners;
+    std::vector<std::unique_ptr<CompanyCounterReconciler>> reconcilers;
+    std::vector<std::unique_ptr<CompanyTombstonePruner>> pruners;
+    CompanyShardRouter& shards = *service->shards();
+    for (size_t i = 0; i < shards.shardCount(); ++i) {
+        const CompanyShardSpec& shard = shards.spec(i);
+        if (options.listenNotify) {
+            listeners.push_back(std::make_unique<CompanyChangeListener>(
+                service->changeFeed(), shard.host, shard.user, shard.pass, logSql));
+            listeners.back()->setKeepalive(options.keepaliveIdle, options.keepaliveInterval,
+                                           options.keepaliveProbes);
+            listeners.back()->start();
+        }
+        if (options.rowCounters) {
+            reconcilers.push_back(std::make_unique<CompanyCounterReconciler>(
+                appletPath, CompanyShardRouter::clientOf(shard), shard.host, shard.user, shard.pass,
+                options.rowCounterReconcile, logSql));
+            reconcilers.back()->setKeepalive(options.keepaliveIdle, options.keepaliveInterval,
+                                             options.keepaliveProbes);
+            reconcilers.back()->start();
+        }
+        // The retention horizon uses PostgreSQL interval arithmetic
+        if (CompanyShardRouter::clientOf(shard) == SA_PostgreSQL_Client) {
+            pruners.push_back(std::make_unique<CompanyTombstonePruner>(
+                appletPath, shard.host, shard.user, shard.pass,
+                options.tombstoneRetention, options.tombstonePrune, logSql));
+            pruners.back()->setKeepalive(options.keepaliveIdle, options.keepaliveInterval,
+                                         options.keepaliveProbes);
+            pruners.back()->start();
+        }
+    }
+
+    CompanyService& companyService = *service;
     CompanyServiceImpl impl(std::move(service), logSql);
 
     std::string server_address = absl::StrFormat("127.0.0.1:%d", port);
 
-    grpc::EnableDefaultHealthCheckService(true);
+    // Health answers NOT_SERVING from the first accepted call until warm-up succeeds
+    CompanyHealthService health({CompanyEditor::service_full_name()});
+
     grpc::reflection::InitProtoReflectionServerBuilderPlugin();
     ServerBuilder builder;
     builder.AddListeningPort(server_address, grpc::InsecureServerCredentials());
     builder.RegisterService(&impl);
+    builder.RegisterService(&health);
     std::unique_ptr<Server> server(builder.BuildAndStart());
     if (!server) {
         std::cerr << "Failed to start server on " << server_address << std::endl;
         return;
     }
     std::cout << "Server listening on " << server_address << std::endl;
+
+    // Runs one warm-up step; false when it threw
+    auto timed = [](const char* step, const auto& fn) {
+        const auto start = std::chrono::steady_clock::now();
+        bool ok = true;
+        try {
+            fn();
+        } catch (const SAException& e) {
+            LOG(ERROR) << "[WARMUP] " << step << ": " << e.ErrText().GetMultiByteChars();
+            ok = false;
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "[WARMUP] " << step << ": " << e.what();
+            ok = false;
+        }
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        LOG(INFO) << "[WARMUP] " << step << " took " << elapsed.count() << " ms";
+        return ok;
+    };
+    auto openConnections = [&] {
+        LOG(INFO) << "[WARMUP] " << companyService.warmConnections() << " connections open";
+    };
+    auto loadApplets = [&] {
+        size_t failed = 0;
+        const size_t loaded = SqlTemplateCache::instance().preload(
+            appletPath, [&failed](const std::string& filePath, const std::string& error) {
+                LOG(ERROR) << "[WARMUP] " << filePath << ": " << error;
+                ++failed;
+            });
+        LOG(INFO) << "[WARMUP] " << loaded << " applets loaded";
+        if (failed > 0) {
+            throw std::runtime_error(std::to_string(failed) + " applet(s) failed to load");
+        }
+    };
+    // Primary connections and every applet must be ready before SERVING
+    while (!timed("connections", openConnections) || !timed("applets", loadApplets)) {
+        LOG(WARNING) << "[WARMUP] retrying in " << WARMUP_RETRY.count() << " s";
+        std::this_thread::sleep_for(WARMUP_RETRY);
+    }
+    // Optional: a failure only leaves the caches cold
+    if (options.warmStatements) {
+        timed("statements", [&] { companyService.warmStatements(); });
+    }
+    health.setServing(true);
+
+    // Ping idle pooled connections so a dropped one is replaced before a request needs it
+    std::unique_ptr<SqlPoolMaintainer> poolMaintainer;
+    if (options.poolCheck.count() > 0) {
+        poolMaintainer = std::make_unique<SqlPoolMaintainer>(
+            companyService.pools(), options.poolCheck,
+            [](const std::string& host, size_t replaced) {
+                LOG(WARNING) << "[DB] replaced " << replaced << " dead connection(s) to " << host;
+            });
+        poolMaintainer->start();
+    }
+
     server->Wait();
 }
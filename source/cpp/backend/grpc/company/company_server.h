@@ -4,6 +4,7 @@
 #include <grpcpp/grpcpp.h>
 #include <memory>
 #include <string>
+#include <string_view>
 
 #include "company.grpc.pb.h"
 #include "company_service.h"
@@ -16,9 +17,18 @@ using CompanyEdit::CompanyEditor;
 using CompanyEdit::Company;
 using CompanyEdit::CompanyResult;
 using CompanyEdit::CompanyList;
+using CompanyEdit::CompanyPage;
 using CompanyEdit::JsonParameters;
 using CompanyEdit::CompanyUid;
+using CompanyEdit::CompanyUids;
+using CompanyEdit::CompanyLookup;
 using CompanyEdit::TotalCount;
+using CompanyEdit::CompanyQuery;
+using CompanyEdit::CompanyFilterField;
+using CompanyEdit::WatchRequest;
+using CompanyEdit::CompanyChange;
+using CompanyEdit::SyncRequest;
+using CompanyEdit::SyncResponse;
 
 /**
  * @brief Thin gRPC adapter — delegates all work to CompanyService
@@ -30,7 +40,7 @@ class CompanyServiceImpl final : public CompanyEditor::Service {
 public:
     CompanyServiceImpl(std::unique_ptr<CompanyService> service, bool logSql);
 
-    // 6 gRPC overrides
+    // gRPC overrides
     Status AddCompany(ServerContext* context, const Company* company,
                       CompanyResult* result) override;
 
@@ -46,16 +56,62 @@ public:
     Status QueryCompanyByUid(ServerContext* context, const CompanyUid* request,
                              Company* response) override;
 
+    Status QueryCompaniesByUids(ServerContext* context, const CompanyUids* request,
+                                CompanyLookup* response) override;
+
     Status QueryCompanyTotalCount(ServerContext* context,
                                   const JsonParameters* request,
                                   TotalCount* response) override;
 
+    Status ListCompanies(ServerContext* context, const CompanyQuery* query,
+                         CompanyList* list) override;
+
+    Status CountCompanies(ServerContext* context, const CompanyQuery* query,
+                          TotalCount* response) override;
+
+    Status ListCompanyPage(ServerContext* context, const CompanyQuery* query,
+                           CompanyPage* page) override;
+
+    Status WatchCompanies(ServerContext* context, const WatchRequest* request,
+                          grpc::ServerWriter<CompanyChange>* writer) override;
+
+    Status SyncCompanies(ServerContext* context, const SyncRequest* request,
+                         SyncResponse* response) override;
+
+    /// Page size used when CompanyQuery.limit is 0
+    static constexpr int DEFAULT_PAGE_SIZE = 100;
+    /// Upper bound for CompanyQuery.limit
+    static constexpr int MAX_PAGE_SIZE = 1000;
+    /// SyncCompanies batch size when SyncRequest.limit is 0
+    static constexpr int DEFAULT_SYNC_BATCH = 500;
+    /// Upper bound for SyncRequest.limit
+    static constexpr int MAX_SYNC_BATCH = 5000;
+    /// Upper bound for CompanyUids.uids
+    static constexpr int MAX_LOOKUP_UIDS = 1000;
+
     // Protobuf ↔ domain type conversion helpers
     // Public (pure static functions) so they can be unit-tested directly.
     static CompanyData toCompanyData(const Company& company);
     static CompanyFilter toCompanyFilter(const JsonParameters& params);
+    static CompanyFilter toCompanyFilter(const CompanyQuery& query);
+    static const char* toColumnName(CompanyFilterField field);
+    static CompanySearchMode toSearchMode(CompanyEdit::CompanySearchMode mode);
+    /// JsonParameters SEARCH_MODE value ("LIKE", "TRIGRAM", "SIMILAR")
+    static CompanySearchMode toSearchMode(std::string_view name);
+    static CountAccuracy toCountAccuracy(CompanyEdit::CountAccuracy accuracy);
+    /// JsonParameters COUNT_ACCURACY value ("EXACT", "ESTIMATE")
+    static CountAccuracy toCountAccuracy(const JsonParameters& params);
     static void toProto(const CompanyData& data, Company* proto);
 
+    // Paging cursor (opaque to clients; currently the next row offset)
+    static std::string encodeCursor(int offset);
+    static int decodeCursor(std::string_view cursor);
+
+    static void toProto(const CompanyChangeEvent& event, uint64_t epoch, CompanyChange* proto);
+    static void toProto(const CompanyDelta& delta, SyncResponse* proto);
+    static void toProto(const CompanyLookupData& lookup, CompanyLookup* proto);
+    static int syncBatchSize(int requested);
+
 private:
     void logError(const char* op, const std::string& detail) const;
 
@@ -68,6 +124,7 @@ void RunCompanyServer(uint16_t port, bool logSql,
                       const std::string& appletPath,
                       const std::string& dbHost,
                       const std::string& dbUser,
-                      const std::string& dbPass);
+                      const std::string& dbPass,
+                      const CompanyServiceOptions& options = {});
 
 #endif // COMPANY_SERVER_H
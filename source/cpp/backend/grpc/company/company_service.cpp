@@ -1,8 +1,93 @@
 #include "company_service.h"
 
+#include "transactionretry.h"
+
+#include <easylogging++.h>
+
+#include <future>
+#include <unordered_map>
+#include <unordered_set>
+
 using std::string;
 using std::string_view;
 
+// ============================================================================
+// Connection routing — tenant shard, then primary for writes
+// ============================================================================
+
+template <typename Fn>
+auto CompanyService::writeShard(CompanyDbRoute& route, Fn&& fn)
+{
+    auto conn = route.primary().acquire();
+    return m_retry.runInTransaction(*conn, [&](SqlConnection& c) {
+        CompanyRepository repo(c, m_appletPath, m_logSql, m_options.rowCounters);
+        return fn(repo);
+    });
+}
+
+template <typename Fn>
+auto CompanyService::readShard(CompanyDbRoute& route, std::optional<int> pinKey, Fn&& fn)
+{
+    SqlConnectionPool& pool = route.readPool(pinKey);
+    if (&pool != &route.primary()) {
+        std::optional<SqlConnectionPool::Lease> conn;
+        try {
+            conn.emplace(pool.acquire());
+        } catch (const SAException& e) {
+            // acquire() already marked the pool unhealthy
+            LOG(WARNING) << "[DB] replica " << pool.host() << " unavailable: "
+                         << e.ErrText().GetMultiByteChars();
+        }
+        if (conn) {
+            try {
+                CompanyRepository repo(**conn, m_appletPath, m_logSql, m_options.rowCounters);
+                return fn(repo);
+            } catch (const SAException& e) {
+                if ((*conn)->connectionSa()->isAlive()) {
+                    throw;  // the statement failed, not the replica
+                }
+                conn->markBroken();
+                pool.reportFailure();
+                LOG(WARNING) << "[DB] replica " << pool.host() << " lost, reading from primary: "
+                             << e.ErrText().GetMultiByteChars();
+            }
+        }
+    }
+
+    auto conn = route.primary().acquire();
+    return m_retry.run(*conn, [&](SqlConnection& c) {
+        CompanyRepository repo(c, m_appletPath, m_logSql, m_options.rowCounters);
+        return fn(repo);
+    });
+}
+
+template <typename Fn>
+auto CompanyService::write(int serverUid, Fn&& fn)
+{
+    if (!m_coalescers.empty()) {
+        const size_t shard = m_useInternalRepo ? m_shards->shardOf(serverUid) : 0;
+        std::invoke_result_t<Fn&, CompanyRepository&> result{};
+        m_coalescers[shard]->submit([&](CompanyRepository& repo) {
+            result = fn(repo);
+        });
+        return result;
+    }
+
+    if (!m_useInternalRepo) {
+        return fn(*m_repo);  // Testing mode — no DB needed
+    }
+    return writeShard(m_shards->route(serverUid), fn);
+}
+
+template <typename Fn>
+auto CompanyService::read(int serverUid, Fn&& fn)
+{
+    if (!m_useInternalRepo) {
+        return fn(*m_repo);
+    }
+    return readShard(m_shards->route(serverUid), serverUid, fn);
+}
+
 // ============================================================================
 // Construction
 // ============================================================================
@@ -10,41 +95,175 @@ using std::string_view;
 CompanyService::CompanyService(string_view appletPath,
                                string_view dbHost, string_view dbUser,
                                string_view dbPass,
-                               bool logSql)
+                               bool logSql,
+                               const CompanyServiceOptions& options)
     : m_appletPath(appletPath)
-    , m_dbHost(dbHost)
-    , m_dbUser(dbUser)
-    , m_dbPass(dbPass)
     , m_logSql(logSql)
     , m_useInternalRepo(true)
+    , m_options(options)
+    , m_countCache(options.countCacheTtl, options.countCacheThreshold)
 {
+    std::vector<CompanyShardSpec> shards = options.shards;
+    if (shards.empty()) {
+        CompanyShardSpec single;
+        single.name = "default";
+        single.host = dbHost;
+        single.user = dbUser;
+        single.pass = dbPass;
+        single.replicas = options.replicaHosts;
+        shards.push_back(std::move(single));
+    }
+    m_shards = std::make_unique<CompanyShardRouter>(shards, options.poolSize,
+                                                    options.replicaRetry, options.readYourWrites);
+    for (SqlConnectionPool* pool : pools()) {
+        pool->setKeepalive(options.keepaliveIdle, options.keepaliveInterval, options.keepaliveProbes);
+    }
+
+    if (options.coalesceWrites) {
+        for (size_t i = 0; i < m_shards->shardCount(); ++i) {
+            CompanyDbRoute& route = m_shards->shard(i);
+            m_coalescers.push_back(std::make_unique<CompanyWriteCoalescer>(
+                [this, &route](const CompanyWriteCoalescer::Job& body) {
+                    writeShard(route, [&](CompanyRepository& repo) {
+                        body(repo);
+                        return true;
+                    });
+                },
+                options.coalesceWindow, options.coalesceMaxBatch,
+                [](CompanyRepository& repo, const CompanyWriteCoalescer::Job& job) -> std::exception_ptr {
+                    SavepointScope savepoint(repo.connection());
+                    try {
+                        job(repo);
+                    } catch (const SAException& e) {
+                        // A serialization failure or lost connection takes the whole
+                        // transaction with it: fail the batch so TransactionRetry reruns it
+                        if (TransactionRetry::classify(e, repo.connection()) != SqlErrorKind::Permanent) {
+                            throw;
+                        }
+                        return std::current_exception();
+                    } catch (...) {
+                        return std::current_exception();
+                    }
+                    savepoint.release();
+                    return nullptr;
+                }));
+        }
+    }
 }
 
-CompanyService::CompanyService(std::unique_ptr<CompanyRepository> repo)
+CompanyService::CompanyService(std::unique_ptr<CompanyRepository> repo,
+                               const CompanyServiceOptions& options)
     : m_repo(std::move(repo))
     , m_useInternalRepo(false)
+    , m_options(options)
+    , m_countCache(options.countCacheTtl, options.countCacheThreshold)
 {
+    if (options.coalesceWrites) {
+        m_coalescers.push_back(std::make_unique<CompanyWriteCoalescer>(
+            [this](const CompanyWriteCoalescer::Job& body) { body(*m_repo); },
+            options.coalesceWindow, options.coalesceMaxBatch));
+    }
 }
 
 // ============================================================================
-// Connection management — lazy init + auto-reconnect
+// Startup warm-up
 // ============================================================================
 
-void CompanyService::ensureConnected()
+size_t CompanyService::warmConnections()
 {
     if (!m_useInternalRepo) {
-        return;  // Testing mode — no DB needed
+        return 0;
+    }
+
+    struct Warming {
+        SqlConnectionPool* pool;
+        bool replica;
+        std::future<size_t> opened;
+    };
+    std::vector<Warming> pools;
+    auto warm = [&](SqlConnectionPool& pool, bool replica) {
+        pools.push_back({&pool, replica, std::async(std::launch::async, [this, &pool] {
+            return pool.warmUp(m_options.poolMin);
+        })});
+    };
+    for (size_t i = 0; i < m_shards->shardCount(); ++i) {
+        CompanyDbRoute& route = m_shards->shard(i);
+        warm(route.primary(), false);
+        for (size_t r = 0; r < route.replicaCount(); ++r) {
+            warm(route.replica(r), true);
+        }
+    }
+
+    size_t open = 0;
+    for (auto& item : pools) {
+        try {
+            open += item.opened.get();
+        } catch (const SAException& e) {
+            if (!item.replica) {
+                throw;
+            }
+            // warmUp() already marked the pool unhealthy
+            LOG(WARNING) << "[DB] replica " << item.pool->host() << " unavailable: "
+                         << e.ErrText().GetMultiByteChars();
+        }
+    }
+    return open;
+}
+
+std::vector<SqlConnectionPool*> CompanyService::pools()
+{
+    std::vector<SqlConnectionPool*> result;
+    if (!m_shards) {
+        return result;
+    }
+    for (size_t i = 0; i < m_shards->shardCount(); ++i) {
+        CompanyDbRoute& route = m_shards->shard(i);
+        result.push_back(&route.primary());
+        for (size_t r = 0; r < route.replicaCount(); ++r) {
+            result.push_back(&route.replica(r));
+        }
     }
+    return result;
+}
 
-    // Create connection on first access
-    if (!m_conn) {
-        m_conn = std::make_unique<SqlConnection>(
-            SA_PostgreSQL_Client, m_dbHost.c_str(), m_dbUser.c_str(), m_dbPass.c_str());
+void CompanyService::warmStatements()
+{
+    if (!m_useInternalRepo) {
+        return;
     }
 
-    // Connect (or reconnect if dropped)
-    if (!m_conn->isConnected()) {
-        m_conn->connect();
+    for (SqlConnectionPool* pool : pools()) {
+        std::vector<SqlConnectionPool::Lease> leases;
+        for (size_t n = pool->idleCount(); n > 0; --n) {
+            leases.push_back(pool->acquire());
+        }
+        const CompanyFilter filter;
+        for (auto& conn : leases) {
+            try {
+                CompanyRepository repo(*conn, m_appletPath, m_logSql, m_options.rowCounters);
+                repo.query(filter);
+                repo.count(filter);
+                repo.findByUid("");
+            } catch (const SAException& e) {
+                LOG(WARNING) << "[WARMUP] " << pool->host() << ": "
+                             << e.ErrText().GetMultiByteChars();
+            }
+        }
+    }
+}
+
+// ============================================================================
+// Change feed
+// ============================================================================
+
+void CompanyService::publishChange(ChangeOperation op, int serverUid, string_view uid)
+{
+    m_countCache.invalidate(serverUid);
+    if (m_shards) {
+        m_shards->route(serverUid).noteWrite(serverUid);
+    }
+    if (!m_options.listenNotify) {
+        m_changeFeed->publish(op, serverUid, uid);
     }
 }
 
@@ -54,15 +273,12 @@ void CompanyService::ensureConnected()
 
 CompanyData CompanyService::addCompany(const CompanyData& data)
 {
-    if (!m_useInternalRepo) {
-        return m_repo->add(data);
+    CompanyData result = write(data.server_uid, [&](CompanyRepository& repo) {
+        return repo.add(data);
+    });
+    if (!result.uid.empty()) {
+        publishChange(ChangeOperation::Insert, data.server_uid, result.uid);
     }
-
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    TransactionScope tx(*m_conn);
-    CompanyData result = repo.add(data);
-    tx.commit();
     return result;
 }
 
@@ -72,16 +288,28 @@ CompanyData CompanyService::addCompany(const CompanyData& data)
 
 CompanyData CompanyService::editCompany(const CompanyData& data)
 {
-    if (!m_useInternalRepo) {
-        return m_repo->update(data);
+    // The write goes to the new tenant's shard; the row must already be there
+    if (m_useInternalRepo && m_shards->shardCount() > 1) {
+        auto current = getCompanyByUid(data.uid);
+        if (current && m_shards->shardOf(current->server_uid) != m_shards->shardOf(data.server_uid)) {
+            throw CompanyShardMoveException(
+                "cannot move company " + data.uid + " from SERVER_UID " +
+                std::to_string(current->server_uid) + " to SERVER_UID " +
+                std::to_string(data.server_uid) + " on another shard");
+        }
     }
 
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    TransactionScope tx(*m_conn);
-    CompanyData result = repo.update(data);
-    tx.commit();
-    return result;
+    UpdateResult result = write(data.server_uid, [&](CompanyRepository& repo) {
+        return repo.update(data);
+    });
+    if (result.moved()) {
+        // The old tenant loses the row: drop it from its watchers and counts
+        publishChange(ChangeOperation::Delete, result.old_server_uid, result.row.uid);
+    }
+    if (!result.row.uid.empty()) {
+        publishChange(ChangeOperation::Update, data.server_uid, result.row.uid);
+    }
+    return result.row;
 }
 
 // ============================================================================
@@ -90,15 +318,20 @@ CompanyData CompanyService::editCompany(const CompanyData& data)
 
 DeleteResult CompanyService::deleteCompany(string_view uid)
 {
+    DeleteResult result;
     if (!m_useInternalRepo) {
-        return m_repo->remove(uid);
+        result = m_repo->remove(uid);
+    } else {
+        // The tenant is not known up front: try each shard until one owns the row
+        for (size_t i = 0; i < m_shards->shardCount() && !result.success; ++i) {
+            result = writeShard(m_shards->shard(i), [&](CompanyRepository& repo) {
+                return repo.remove(uid);
+            });
+        }
+    }
+    if (result.success) {
+        publishChange(ChangeOperation::Delete, result.server_uid, result.uid);
     }
-
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    TransactionScope tx(*m_conn);
-    DeleteResult result = repo.remove(uid);
-    tx.commit();
     return result;
 }
 
@@ -108,13 +341,9 @@ DeleteResult CompanyService::deleteCompany(string_view uid)
 
 std::vector<CompanyData> CompanyService::queryCompanies(const CompanyFilter& filter)
 {
-    if (!m_useInternalRepo) {
-        return m_repo->query(filter);
-    }
-
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    return repo.query(filter);
+    return read(filter.server_uid, [&](CompanyRepository& repo) {
+        return repo.query(filter);
+    });
 }
 
 // ============================================================================
@@ -127,9 +356,63 @@ std::optional<CompanyData> CompanyService::getCompanyByUid(string_view uid)
         return m_repo->findByUid(uid);
     }
 
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    return repo.findByUid(uid);
+    // Tenant unknown: ask every shard; reads stay on the primary after any recent write
+    for (size_t i = 0; i < m_shards->shardCount(); ++i) {
+        auto found = readShard(m_shards->shard(i), std::nullopt, [&](CompanyRepository& repo) {
+            return repo.findByUid(uid);
+        });
+        if (found) {
+            return found;
+        }
+    }
+    return std::nullopt;
+}
+
+CompanyLookupData CompanyService::getCompaniesByUids(const std::vector<string>& uids)
+{
+    std::vector<string> pending;
+    std::unordered_set<string> requested;
+    for (const auto& uid : uids) {
+        if (requested.insert(uid).second) {
+            pending.push_back(uid);
+        }
+    }
+
+    std::unordered_map<string, CompanyData> found;
+    auto collect = [&](std::vector<CompanyData> rows) {
+        for (auto& row : rows) {
+            string uid = row.uid;
+            found.try_emplace(std::move(uid), std::move(row));
+        }
+        std::erase_if(pending, [&](const string& uid) { return found.contains(uid); });
+    };
+
+    if (!m_useInternalRepo) {
+        if (!pending.empty()) {
+            collect(m_repo->findByUids(pending));
+        }
+    } else {
+        for (size_t i = 0; i < m_shards->shardCount() && !pending.empty(); ++i) {
+            collect(readShard(m_shards->shard(i), std::nullopt, [&](CompanyRepository& repo) {
+                return repo.findByUids(pending);
+            }));
+        }
+    }
+
+    CompanyLookupData result;
+    result.rows.reserve(found.size());
+    requested.clear();
+    for (const auto& uid : uids) {
+        if (!requested.insert(uid).second) {
+            continue;
+        }
+        if (auto it = found.find(uid); it != found.end()) {
+            result.rows.push_back(std::move(it->second));
+        } else {
+            result.missing_uids.push_back(uid);
+        }
+    }
+    return result;
 }
 
 // ============================================================================
@@ -138,11 +421,81 @@ std::optional<CompanyData> CompanyService::getCompanyByUid(string_view uid)
 
 int64_t CompanyService::countCompanies(const CompanyFilter& filter)
 {
+    // Unfiltered listing: the tenant's row counter answers without a scan
+    if (m_options.rowCounters && filter.value.empty()) {
+        return read(filter.server_uid, [&](CompanyRepository& repo) {
+            return repo.rowCount(filter.server_uid);
+        });
+    }
+
+    if (auto cached = m_countCache.find(filter)) {
+        return *cached;
+    }
+
+    const int64_t count = read(filter.server_uid, [&](CompanyRepository& repo) {
+        return repo.count(filter);
+    });
+    m_countCache.store(filter, count);
+    return count;
+}
+
+CompanyCount CompanyService::countCompanies(const CompanyFilter& filter, CountAccuracy accuracy)
+{
+    const bool counterAnswers = m_options.rowCounters && filter.value.empty();
+    if (accuracy == CountAccuracy::Estimate && !counterAnswers && !m_countCache.find(filter)) {
+        const std::optional<int64_t> estimate = read(filter.server_uid, [&](CompanyRepository& repo) {
+            return repo.estimateCount(filter);
+        });
+        if (estimate && *estimate >= m_countCache.threshold()) {
+            return {*estimate, true};
+        }
+    }
+    return {countCompanies(filter), false};
+}
+
+CompanyPageData CompanyService::queryCompanyPage(const CompanyFilter& filter)
+{
+    const bool counterAnswers = m_options.rowCounters && filter.value.empty();
+    auto page = [&](CompanyRepository& repo) {
+        CompanyPageData result;
+        result.rows = repo.query(filter);
+        result.total = counterAnswers ? repo.rowCount(filter.server_uid) : repo.count(filter);
+        return result;
+    };
+
+    CompanyPageData result;
     if (!m_useInternalRepo) {
-        return m_repo->count(filter);
+        result = page(*m_repo);
+    } else {
+        result = read(filter.server_uid, [&](CompanyRepository& repo) {
+            TransactionScope tx(repo.connection(), TransactionOptions::snapshot());
+            CompanyPageData snapshot = page(repo);
+            tx.commit();
+            return snapshot;
+        });
+    }
+
+    if (!counterAnswers) {
+        m_countCache.store(filter, result.total);
     }
+    return result;
+}
 
-    ensureConnected();
-    CompanyRepository repo(*m_conn, m_appletPath, m_logSql);
-    return repo.count(filter);
+// ============================================================================
+// Delta sync
+// ============================================================================
+
+CompanyDelta CompanyService::syncCompanies(int serverUid, int64_t sinceVersion, int limit, bool snapshot)
+{
+    if (!m_useInternalRepo) {
+        return m_repo->sync(serverUid, sinceVersion, limit, snapshot);
+    }
+    // Horizon, rows and tombstones from one snapshot: a change committed
+    // between the reads could otherwise be skipped by the merged version
+    return read(serverUid, [&](CompanyRepository& repo) {
+        TransactionScope tx(repo.connection(), TransactionOptions::snapshot());
+        CompanyDelta delta = repo.sync(serverUid, sinceVersion, limit, snapshot);
+        tx.commit();
+        return delta;
+    });
 }
@@ -1,23 +1,50 @@
 #pragma once
 
+#include "company_change_feed.h"
+#include "company_count_cache.h"
+#include "company_options.h"
 #include "company_repository.h"
+#include "company_shard_router.h"
 #include "company_types.h"
-#include "sqlconnection.h"
-#include "transactionscope.h"
+#include "company_write_coalescer.h"
 
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+/**
+ * @brief Edit would move a company to a tenant on another shard
+ *
+ * Rows cannot be moved between databases in one transaction; the caller
+ * must delete and re-add instead.
+ */
+class CompanyShardMoveException : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
 /**
  * @brief Business logic layer for company operations
  *
- * Manages SqlConnection lifecycles, coordinates transactions via TransactionScope,
+ * Borrows pooled connections per call from the shard owning the tenant
+ * (CompanyShardRouter) and, within it, from the primary for mutations or a
+ * replica for reads (CompanyDbRoute). Coordinates transactions via TransactionScope,
  * and translates repository-level errors to domain results.
  *
  * Designed for testability: accepts an optional pre-built repository
  * for unit testing with mock data.
+ *
+ * Serialization failures and lost connections are retried with backoff
+ * (TransactionRetry) before an error reaches the caller.
+ *
+ * With CompanyServiceOptions::coalesceWrites, concurrent adds and edits of
+ * one shard are group-committed by a CompanyWriteCoalescer.
+ *
+ * Committed mutations are published to changeFeed() (unless the feed is
+ * driven by PostgreSQL NOTIFY, see CompanyServiceOptions::listenNotify).
  */
 class CompanyService {
 public:
@@ -28,39 +55,153 @@ public:
                    std::string_view dbHost,
                    std::string_view dbUser,
                    std::string_view dbPass,
-                   bool logSql = false);
+                   bool logSql = false,
+                   const CompanyServiceOptions& options = {});
 
     /**
      * @brief Construct with pre-built repository (testing mode)
      */
-    explicit CompanyService(std::unique_ptr<CompanyRepository> repo);
+    explicit CompanyService(std::unique_ptr<CompanyRepository> repo,
+                            const CompanyServiceOptions& options = {});
 
     // CRUD
     CompanyData addCompany(const CompanyData& data);
+    /// @throws CompanyShardMoveException if the new SERVER_UID lives on another shard
     CompanyData editCompany(const CompanyData& data);
     DeleteResult deleteCompany(std::string_view uid);
 
     // Queries
     std::vector<CompanyData> queryCompanies(const CompanyFilter& filter);
     std::optional<CompanyData> getCompanyByUid(std::string_view uid);
+
+    /**
+     * @brief Many companies by UID, one set-based query per shard
+     *
+     * Duplicate UIDs are looked up and returned once. Shards are asked in
+     * turn for the UIDs not found so far.
+     */
+    CompanyLookupData getCompaniesByUids(const std::vector<std::string>& uids);
     int64_t countCompanies(const CompanyFilter& filter);
 
+    /**
+     * @brief Count with an accuracy hint
+     *
+     * Cached exact counts are returned as they are. With
+     * CountAccuracy::Estimate the planner estimate is returned when it
+     * reaches CompanyServiceOptions::countCacheThreshold; smaller results
+     * are counted exactly because that is cheap.
+     */
+    CompanyCount countCompanies(const CompanyFilter& filter, CountAccuracy accuracy);
+
+    /**
+     * @brief Page and exact total in one REPEATABLE READ, READ ONLY transaction
+     *
+     * queryCompanies() + countCompanies() run as separate autocommit
+     * statements and may disagree under concurrent writes; here both see
+     * the same snapshot. The total bypasses (but refreshes) the count cache.
+     */
+    CompanyPageData queryCompanyPage(const CompanyFilter& filter);
+
+    // Delta sync
+    CompanyDelta syncCompanies(int serverUid, int64_t sinceVersion, int limit, bool snapshot = false);
+
+    /**
+     * @brief Run @p fn on every shard's primary and collect the results
+     *
+     * Scatter-gather for admin queries that are not scoped to one tenant.
+     * Testing mode calls @p fn once with the injected repository.
+     */
+    template <typename Fn>
+    auto gather(Fn&& fn) -> std::vector<std::invoke_result_t<Fn&, CompanyRepository&>>;
+
+    /**
+     * @brief Open CompanyServiceOptions::poolMin connections on every pool
+     *
+     * All primaries and replicas are connected in parallel. A replica that
+     * cannot be reached is logged and left to its failover cooldown.
+     * Testing mode does nothing.
+     * @return number of open connections afterwards
+     * @throws SAException if a primary cannot be reached
+     */
+    size_t warmConnections();
+
+    /// Primary and replica pools of all shards (empty in testing mode)
+    std::vector<SqlConnectionPool*> pools();
+
+    /**
+     * @brief Run the hot read applets once on every idle pooled connection
+     *
+     * Fills each backend's catalog caches and the page cache before the
+     * first client request. Failures are logged, not thrown.
+     */
+    void warmStatements();
+
+    /// Retry counters of all database work done by this service
+    const RetryStats& retryStats() const noexcept { return m_retryStats; }
+
+    /// Shard map in internal mode, nullptr in testing mode
+    CompanyShardRouter* shards() noexcept { return m_shards.get(); }
+
+    // Change feed (WatchCompanies)
+    const std::shared_ptr<CompanyChangeFeed>& changeFeed() const noexcept { return m_changeFeed; }
+    const CompanyServiceOptions& options() const noexcept { return m_options; }
+
 private:
+    /// Publish a committed change unless NOTIFY triggers do it for us
+    void publishChange(ChangeOperation op, int serverUid, std::string_view uid);
+
+    /// Run @p fn in a transaction on the primary of @p serverUid's shard,
+    /// through the shard's coalescer when group commit is enabled
+    template <typename Fn>
+    auto write(int serverUid, Fn&& fn);
+
+    /// Run @p fn on the read pool of @p serverUid's shard
+    template <typename Fn>
+    auto read(int serverUid, Fn&& fn);
+
+    /// write() on one shard
+    template <typename Fn>
+    auto writeShard(CompanyDbRoute& route, Fn&& fn);
+
     /**
-     * @brief Ensure a shared database connection is established (lazy + reconnect)
+     * @brief read() on one shard
      *
-     * Creates the connection on first call and reconnects if the connection
-     * was dropped. No-op in testing mode (injected repository).
-     * @throws SAException if connection fails
+     * A replica whose connection died is reported to its pool and the read
+     * is retried once on the primary. SQL errors are not retried.
+     * @param pinKey tenant for read-your-writes; nullopt when unknown
      */
-    void ensureConnected();
+    template <typename Fn>
+    auto readShard(CompanyDbRoute& route, std::optional<int> pinKey, Fn&& fn);
 
-    std::unique_ptr<SqlConnection> m_conn;  ///< Shared connection (internal mode)
+    std::unique_ptr<CompanyShardRouter> m_shards;  ///< Connection pools (internal mode)
+    std::vector<std::unique_ptr<CompanyWriteCoalescer>> m_coalescers;  ///< One per shard
     std::unique_ptr<CompanyRepository> m_repo;  ///< Injected repo (for testing)
     std::string m_appletPath;
-    std::string m_dbHost;
-    std::string m_dbUser;
-    std::string m_dbPass;
     bool m_logSql = false;
     bool m_useInternalRepo = true;  ///< false when repo is injected
+    CompanyServiceOptions m_options;
+    CompanyCountCache m_countCache;
+    RetryStats m_retryStats;
+    TransactionRetry m_retry{m_options.retry, &m_retryStats};
+    std::shared_ptr<CompanyChangeFeed> m_changeFeed = std::make_shared<CompanyChangeFeed>();
 };
+
+template <typename Fn>
+auto CompanyService::gather(Fn&& fn) -> std::vector<std::invoke_result_t<Fn&, CompanyRepository&>>
+{
+    std::vector<std::invoke_result_t<Fn&, CompanyRepository&>> results;
+    if (!m_useInternalRepo) {
+        results.push_back(fn(*m_repo));
+        return results;
+    }
+
+    results.reserve(m_shards->shardCount());
+    for (size_t i = 0; i < m_shards->shardCount(); ++i) {
+        auto conn = m_shards->shard(i).primary().acquire();
+        results.push_back(m_retry.run(*conn, [&](SqlConnection& c) {
+            CompanyRepository repo(c, m_appletPath, m_logSql, m_options.rowCounters);
+            return fn(repo);
+        }));
+    }
+    return results;
+}
@@ -0,0 +1,174 @@
+#include "company_shard_router.h"
+
+#include <nlohmann/json.hpp>
+
+#include <stdexcept>
+
+using std::string;
+using std::string_view;
+using json = nlohmann::json;
+
+namespace {
+
+eSAClient toClient(const string& name)
+{
+    if (name == "postgresql") {
+        return SA_PostgreSQL_Client;
+    }
+    if (name == "sqlite") {
+        return SA_SQLite_Client;
+    }
+    throw std::invalid_argument("shard client must be \"postgresql\" or \"sqlite\": " + name);
+}
+
+void validate(const std::vector<CompanyShardSpec>& specs)
+{
+    if (specs.empty()) {
+        throw std::invalid_argument("shard map is empty");
+    }
+    for (size_t i = 0; i < specs.size(); ++i) {
+        const CompanyShardSpec& a = specs[i];
+        if (a.host.empty()) {
+            throw std::invalid_argument("shard '" + a.name + "' has no host");
+        }
+        if (a.from.has_value() != a.to.has_value()) {
+            throw std::invalid_argument("shard '" + a.name + "' needs both from and to");
+        }
+        if (!a.from) {
+            continue;
+        }
+        if (*a.from > *a.to) {
+            throw std::invalid_argument("shard '" + a.name + "' has from > to");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            const CompanyShardSpec& b = specs[j];
+            if (b.from && *a.from <= *b.to && *b.from <= *a.to) {
+                throw std::invalid_argument("shards '" + b.name + "' and '" + a.name + "' overlap");
+            }
+        }
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+eSAClient CompanyShardRouter::clientOf(const CompanyShardSpec& spec)
+{
+    return toClient(spec.client);
+}
+
+CompanyShardRouter::CompanyShardRouter(const std::vector<CompanyShardSpec>& specs,
+                                       size_t poolSize,
+                                       std::chrono::milliseconds replicaRetry,
+                                       std::chrono::milliseconds readYourWrites)
+{
+    validate(specs);
+
+    for (const CompanyShardSpec& spec : specs) {
+        const eSAClient client = toClient(spec.client);
+        auto makePool = [&](const string& host) {
+            return std::make_unique<SqlConnectionPool>(client, host, spec.user, spec.pass,
+                                                       poolSize, replicaRetry);
+        };
+
+        std::vector<std::unique_ptr<SqlConnectionPool>> replicas;
+        for (const auto& host : spec.replicas) {
+            replicas.push_back(makePool(host));
+        }
+
+        if (!spec.from) {
+            m_hashShards.push_back(m_shards.size());
+        }
+        m_shards.push_back({spec, std::make_unique<CompanyDbRoute>(
+                                      makePool(spec.host), std::move(replicas), readYourWrites)});
+    }
+}
+
+// ============================================================================
+// Routing
+// ============================================================================
+
+size_t CompanyShardRouter::shardOf(int serverUid) const
+{
+    for (size_t i = 0; i < m_shards.size(); ++i) {
+        const CompanyShardSpec& spec = m_shards[i].spec;
+        if (spec.from && serverUid >= *spec.from && serverUid <= *spec.to) {
+            return i;
+        }
+    }
+    if (m_hashShards.empty()) {
+        throw std::out_of_range("no shard owns SERVER_UID " + std::to_string(serverUid));
+    }
+    // Unsigned so negative uids still land in a bucket
+    const auto bucket = static_cast<unsigned>(serverUid) % m_hashShards.size();
+    return m_hashShards[bucket];
+}
+
+// ============================================================================
+// provider.json
+// ============================================================================
+
+std::vector<CompanyShardSpec> CompanyShardRouter::parseShardMap(string_view text,
+                                                                string_view defaultUser,
+                                                                string_view defaultPass)
+{
+    json doc;
+    try {
+        doc = json::parse(text);
+    } catch (const json::parse_error& e) {
+        throw std::invalid_argument(string("shards: ") + e.what());
+    }
+    if (!doc.is_array()) {
+        throw std::invalid_argument("shards must be an array");
+    }
+
+    std::vector<CompanyShardSpec> specs;
+    try {
+        for (const auto& entry : doc) {
+            CompanyShardSpec spec;
+            spec.name = entry.value("name", "shard" + std::to_string(specs.size()));
+            if (entry.contains("from")) {
+                spec.from = entry.at("from").get<int>();
+            }
+            if (entry.contains("to")) {
+                spec.to = entry.at("to").get<int>();
+            }
+            spec.host = entry.value("host", "");
+            spec.user = entry.value("user", string(defaultUser));
+            spec.pass = entry.value("pass", string(defaultPass));
+            spec.replicas = entry.value("replicas", std::vector<string>{});
+            spec.client = entry.value("client", spec.client);
+            toClient(spec.client);  // reject unknown clients while parsing
+            specs.push_back(std::move(spec));
+        }
+    } catch (const json::exception& e) {
+        throw std::invalid_argument(string("shards: ") + e.what());
+    }
+
+    validate(specs);
+    return specs;
+}
+
+std::vector<string> CompanyShardRouter::parseReplicas(string_view text)
+{
+    json doc;
+    try {
+        doc = json::parse(text);
+    } catch (const json::parse_error&) {
+        doc = json();  // a plain "host" string is not JSON
+    }
+    if (!doc.is_array()) {
+        throw std::invalid_argument("replicas must be an array of hosts");
+    }
+    std::vector<string> hosts;
+    for (const auto& host : doc) {
+        if (!host.is_string() || host.get<string>().empty()) {
+            throw std::invalid_argument("replicas: every entry must be a non-empty host string");
+        }
+        hosts.push_back(host.get<string>());
+    }
+    return hosts;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "company_db_route.h"
+#include "company_options.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Sends a tenant's requests to the shard that owns its SERVER_UID
+ *
+ * Each shard is a CompanyDbRoute (primary + replicas, each with its own
+ * connection pool). Range shards are matched first; every other tenant
+ * goes to hash shard (server_uid mod number-of-hash-shards). Adding a hash
+ * shard therefore moves tenants — grow with range shards instead.
+ *
+ * Requests without a tenant (lookup or delete by uid, admin jobs) visit
+ * every shard, see shardCount() / shard().
+ */
+class CompanyShardRouter {
+public:
+    CompanyShardRouter(const std::vector<CompanyShardSpec>& specs,
+                       size_t poolSize,
+                       std::chrono::milliseconds replicaRetry,
+                       std::chrono::milliseconds readYourWrites);
+
+    CompanyShardRouter(const CompanyShardRouter&) = delete;
+    CompanyShardRouter& operator=(const CompanyShardRouter&) = delete;
+
+    /**
+     * @brief Index of the shard owning @p serverUid
+     * @throws std::out_of_range if no range matches and there are no hash shards
+     */
+    size_t shardOf(int serverUid) const;
+
+    /// Route of the shard owning @p serverUid
+    CompanyDbRoute& route(int serverUid) { return *m_shards[shardOf(serverUid)].route; }
+
+    size_t shardCount() const noexcept { return m_shards.size(); }
+    CompanyDbRoute& shard(size_t index) { return *m_shards.at(index).route; }
+    const CompanyShardSpec& spec(size_t index) const { return m_shards.at(index).spec; }
+
+    /**
+     * @brief Parse the "shards" array of provider.json
+     *
+     * @code
+     * "shards": [
+     *   { "name": "eu", "from": 1, "to": 29999, "host": "db-eu@medicon",
+     *     "replicas": ["db-eu-r1@medicon"] },
+     *   { "name": "rest", "host": "db-2@medicon" }
+     * ]
+     * @endcode
+     *
+     * "user"/"pass" default to @p defaultUser / @p defaultPass; "client" is
+     * "postgresql" (default) or "sqlite".
+     * @throws std::invalid_argument for malformed maps or overlapping ranges
+     */
+    static std::vector<CompanyShardSpec> parseShardMap(std::string_view json,
+                                                       std::string_view defaultUser,
+                                                       std::string_view defaultPass);
+
+    /**
+     * @brief Parse the top-level "replicas" array of provider.json
+     *
+     * @code
+     * "replicas": ["db-r1@medicon", "db-r2@medicon"]
+     * @endcode
+     *
+     * @throws std::invalid_argument unless @p json is an array of non-empty
+     *         host strings (a plain "host" string is rejected)
+     */
+    static std::vector<std::string> parseReplicas(std::string_view json);
+
+    /**
+     * @brief SQLAPI++ client of @p spec ("postgresql" or "sqlite")
+     * @throws std::invalid_argument for any other client name
+     */
+    static eSAClient clientOf(const CompanyShardSpec& spec);
+
+private:
+    struct Shard {
+        CompanyShardSpec spec;
+        std::unique_ptr<CompanyDbRoute> route;
+    };
+
+    std::vector<Shard> m_shards;
+    std::vector<size_t> m_hashShards;  ///< indexes into m_shards
+};
@@ -0,0 +1,108 @@
+#include "company_tombstone_pruner.h"
+
+#include "company_repository.h"
+#include "sqlconnection.h"
+#include "transactionscope.h"
+
+#include <SQLAPI.h>
+#include <easylogging++.h>
+
+using std::string_view;
+
+// ============================================================================
+// Construction
+// ============================================================================
+
+CompanyTombstonePruner::CompanyTombstonePruner(string_view appletPath,
+                                               string_view dbHost,
+                                               string_view dbUser,
+                                               string_view dbPass,
+                                               std::chrono::seconds retention,
+                                               std::chrono::seconds interval,
+                                               bool logSql)
+    : m_appletPath(appletPath)
+    , m_dbHost(dbHost)
+    , m_dbUser(dbUser)
+    , m_dbPass(dbPass)
+    , m_retention(retention)
+    , m_interval(interval)
+    , m_logSql(logSql)
+{
+}
+
+CompanyTombstonePruner::~CompanyTombstonePruner()
+{
+    stop();
+}
+
+void CompanyTombstonePruner::setKeepalive(int idleSeconds, int intervalSeconds, int probes)
+{
+    m_keepaliveIdle = idleSeconds;
+    m_keepaliveInterval = intervalSeconds;
+    m_keepaliveProbes = probes;
+}
+
+void CompanyTombstonePruner::start()
+{
+    if (m_thread.joinable() || m_retention.count() <= 0 || m_interval.count() <= 0) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&CompanyTombstonePruner::run, this);
+}
+
+void CompanyTombstonePruner::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+void CompanyTombstonePruner::sleepFor(std::chrono::milliseconds duration)
+{
+    std::unique_lock lock(m_mutex);
+    m_wakeup.wait_for(lock, duration, [this] { return m_stopping.load(); });
+}
+
+// ============================================================================
+// Pruning thread
+// ============================================================================
+
+void CompanyTombstonePruner::prune(SqlConnection& conn)
+{
+    if (!conn.isConnected()) {
+        conn.connect();
+    }
+    CompanyRepository repo(conn, m_appletPath, m_logSql);
+    TransactionScope tx(conn);
+    const int64_t removed = repo.pruneTombstones(m_retention);
+    tx.commit();
+    LOG_IF(m_logSql || removed > 0, INFO) << "[TOMBSTONE] pruned " << removed << " tombstone(s)";
+}
+
+void CompanyTombstonePruner::run()
+{
+    SqlConnection conn(SA_PostgreSQL_Client, m_dbHost.c_str(), m_dbUser.c_str(), m_dbPass.c_str());
+    conn.setKeepalive(m_keepaliveIdle, m_keepaliveInterval, m_keepaliveProbes);
+
+    while (!m_stopping) {
+        sleepFor(m_interval);
+        if (m_stopping) {
+            break;
+        }
+        try {
+            prune(conn);
+        } catch (const SAException& e) {
+            LOG(ERROR) << "[TOMBSTONE] " << e.ErrText().GetMultiByteChars();
+            conn.disconnect();
+        } catch (const std::exception& e) {
+            LOG(ERROR) << "[TOMBSTONE] " << e.what();
+            conn.disconnect();
+        }
+    }
+}
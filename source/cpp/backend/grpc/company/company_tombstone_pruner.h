@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+class SqlConnection;
+
+/**
+ * @brief Background job that drops expired company_tombstone rows
+ *
+ * Deletes and tenant moves leave a tombstone for SyncCompanies. Every
+ * @c interval this job removes those older than @c retention on its own
+ * connection (CompanyRepository::pruneTombstones()); clients that synced
+ * before a removed tombstone get a reset from SyncCompanies.
+ * Requires schema/005_company_tombstone_retention.sql (PostgreSQL).
+ */
+class CompanyTombstonePruner {
+public:
+    CompanyTombstonePruner(std::string_view appletPath,
+                           std::string_view dbHost,
+                           std::string_view dbUser,
+                           std::string_view dbPass,
+                           std::chrono::seconds retention,
+                           std::chrono::seconds interval,
+                           bool logSql = false);
+    ~CompanyTombstonePruner();
+
+    CompanyTombstonePruner(const CompanyTombstonePruner&) = delete;
+    CompanyTombstonePruner& operator=(const CompanyTombstonePruner&) = delete;
+
+    /// TCP keepalive for the job's connection and its reconnects; call before start()
+    void setKeepalive(int idleSeconds, int intervalSeconds, int probes);
+
+    void start();
+    void stop();
+
+private:
+    void run();
+    void prune(SqlConnection& conn);
+
+    /// Sleep until @p duration elapsed or stop() was called
+    void sleepFor(std::chrono::milliseconds duration);
+
+    std::string m_appletPath;
+    std::string m_dbHost;
+    std::string m_dbUser;
+    std::string m_dbPass;
+    std::chrono::seconds m_retention;
+    std::chrono::seconds m_interval;
+    bool m_logSql = false;
+    int m_keepaliveIdle = 0;
+    int m_keepaliveInterval = 0;
+    int m_keepaliveProbes = 0;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_stopping{false};
+};
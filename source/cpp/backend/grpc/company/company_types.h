@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
@@ -21,6 +22,19 @@ struct CompanyData {
     std::chrono::milliseconds joint_date{0};
     std::string license;
     std::string logo;
+    int64_t row_version = 0;  ///< Per-tenant change version (ROW_VERSION column)
+};
+
+/**
+ * @brief How CompanyFilter::value is matched against CompanyFilter::field
+ *
+ * Trigram and Similar need the pg_trgm indexes of schema/003; on other
+ * databases they fall back to Like.
+ */
+enum class CompanySearchMode {
+    Like = 0,      ///< LIKE '%value%' — portable, sequential scan
+    Trigram = 1,   ///< ILIKE '%value%' served by a GIN trigram index
+    Similar = 2    ///< pg_trgm similarity (%), best match first
 };
 
 /**
@@ -29,16 +43,74 @@ struct CompanyData {
 struct CompanyFilter {
     int server_uid = 0;      ///< Owner server id (matches SERVER_UID column)
     std::string field;       ///< Column name to filter by (validated via allow-list)
-    std::string value;       ///< Search term (LIKE match)
+    std::string value;       ///< Search term (matched according to @c mode)
+    CompanySearchMode mode = CompanySearchMode::Like;
     int offset = 0;
     int limit = 100;
 };
 
+/**
+ * @brief Requested precision of a company count
+ */
+enum class CountAccuracy {
+    Exact = 0,     ///< COUNT(*) (possibly served from CompanyCountCache)
+    Estimate = 1   ///< Planner row estimate when the result is large
+};
+
+/**
+ * @brief Result of CompanyService::countCompanies()
+ */
+struct CompanyCount {
+    int64_t count = 0;
+    bool estimated = false;  ///< true when @c count is a planner estimate
+};
+
+/**
+ * @brief One page of companies with the total it belongs to
+ *
+ * Result of CompanyService::queryCompanyPage(); both come from one snapshot.
+ */
+struct CompanyPageData {
+    std::vector<CompanyData> rows;
+    int64_t total = 0;  ///< Matches of the filter, ignoring limit/cursor
+};
+
+/**
+ * @brief Result of CompanyService::getCompaniesByUids()
+ */
+struct CompanyLookupData {
+    std::vector<CompanyData> rows;          ///< Found companies, in request order
+    std::vector<std::string> missing_uids;  ///< Requested UIDs without a row, in request order
+};
+
+/**
+ * @brief Result of an update operation
+ */
+struct UpdateResult {
+    CompanyData row;          ///< Updated record (UID empty if no such row)
+    int old_server_uid = 0;   ///< SERVER_UID the row had before the update
+
+    /// The update moved the row to another tenant
+    bool moved() const noexcept { return !row.uid.empty() && old_server_uid != row.server_uid; }
+};
+
 /**
  * @brief Result of a delete operation
  */
 struct DeleteResult {
     bool success = false;
     std::string uid;         ///< UID of deleted record (if RETURNING)
+    int server_uid = 0;      ///< SERVER_UID of deleted record (if RETURNING)
     std::string error;
 };
+
+/**
+ * @brief Changes of one tenant since a known row version (SyncCompanies)
+ */
+struct CompanyDelta {
+    std::vector<CompanyData> changed;        ///< Inserted or updated rows, by version
+    std::vector<std::string> deleted_uids;   ///< Tombstones, by version
+    int64_t version = 0;     ///< Pass as since_version on the next call
+    bool has_more = false;   ///< More changes exist beyond @c version
+    bool reset = false;      ///< Tombstones after since_version were pruned: reload from 0
+};
@@ -0,0 +1,192 @@
+#include "company_write_coalescer.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+constexpr size_t NO_FAILURE = std::numeric_limits<size_t>::max();
+
+/// How far the last attempt of a batch transaction got
+enum class Stage {
+    Begin,   ///< Body not entered (e.g. no connection)
+    Jobs,    ///< Inside the jobs: a failure rolls the transaction back
+    Commit   ///< Jobs done: a failure leaves the commit outcome unknown
+};
+}
+
+CompanyWriteCoalescer::CompanyWriteCoalescer(Executor executor,
+                                             std::chrono::microseconds window,
+                                             size_t maxBatch,
+                                             Isolator isolator)
+    : m_executor(std::move(executor))
+    , m_isolator(std::move(isolator))
+    , m_window(window)
+    , m_maxBatch(std::max<size_t>(maxBatch, 1))
+{
+}
+
+// ============================================================================
+// Leader / follower
+// ============================================================================
+
+void CompanyWriteCoalescer::submit(Job job)
+{
+    Pending item{std::move(job)};
+
+    std::unique_lock lock(m_mutex);
+    m_queue.push_back(&item);
+    m_changed.notify_all();  // a waiting leader may now have a full batch
+
+    while (!item.done) {
+        if (m_leaderActive) {
+            m_changed.wait(lock);
+            continue;
+        }
+
+        m_leaderActive = true;
+        m_changed.wait_for(lock, m_window, [this] { return m_queue.size() >= m_maxBatch; });
+
+        const size_t take = std::min(m_queue.size(), m_maxBatch);
+        std::vector<Pending*> batch(m_queue.begin(), m_queue.begin() + take);
+        m_queue.erase(m_queue.begin(), m_queue.begin() + take);
+
+        lock.unlock();
+        runBatch(std::move(batch));
+        lock.lock();
+
+        // Our own job may have missed this batch; the loop leads the next one
+        m_leaderActive = false;
+        m_changed.notify_all();
+    }
+
+    if (item.error) {
+        std::rethrow_exception(item.error);
+    }
+}
+
+// ============================================================================
+// Batch execution
+// ============================================================================
+
+void CompanyWriteCoalescer::runBatch(std::vector<Pending*> batch)
+{
+    if (m_isolator) {
+        runIsolated(std::move(batch));
+        return;
+    }
+
+    while (!batch.empty()) {
+        Stage stage = Stage::Begin;
+        size_t failed = NO_FAILURE;
+        try {
+            {
+                std::lock_guard lock(m_mutex);
+                ++m_transactions;
+            }
+            m_executor([&](CompanyRepository& repo) {
+                stage = Stage::Jobs;
+                for (size_t i = 0; i < batch.size(); ++i) {
+                    failed = i;
+                    batch[i]->job(repo);
+                }
+                failed = NO_FAILURE;
+                stage = Stage::Commit;
+            });
+            complete(batch);
+            return;
+        } catch (...) {
+            if (stage == Stage::Commit) {
+                failAll(batch, std::current_exception());
+                return;
+            }
+            if (failed == NO_FAILURE) {
+                // Rolled back before any job ran: no single job to blame
+                for (Pending* item : batch) {
+                    runAlone(*item);
+                }
+                complete(batch);
+                return;
+            }
+            Pending* culprit = batch[failed];
+            batch.erase(batch.begin() + static_cast<std::ptrdiff_t>(failed));
+            runAlone(*culprit);
+            complete({culprit});
+        }
+    }
+}
+
+void CompanyWriteCoalescer::runIsolated(std::vector<Pending*> batch)
+{
+    Stage stage = Stage::Begin;
+    try {
+        {
+            std::lock_guard lock(m_mutex);
+            ++m_transactions;
+        }
+        m_executor([&](CompanyRepository& repo) {
+            stage = Stage::Jobs;
+            for (Pending* item : batch) {
+                // Rolled back to its savepoint on failure; the others carry on
+                item->error = m_isolator(repo, item->job);
+            }
+            stage = Stage::Commit;
+        });
+    } catch (...) {
+        if (stage == Stage::Commit) {
+            failAll(batch, std::current_exception());
+            return;
+        }
+        // Rolled back before COMMIT (no connection, or a transient error
+        // outlasted the executor's retries): no single job to blame
+        for (Pending* item : batch) {
+            runAlone(*item);
+        }
+    }
+    complete(batch);
+}
+
+void CompanyWriteCoalescer::runAlone(Pending& item)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        ++m_transactions;
+    }
+    try {
+        m_executor(item.job);
+        item.error = nullptr;
+    } catch (...) {
+        item.error = std::current_exception();
+    }
+}
+
+void CompanyWriteCoalescer::failAll(const std::vector<Pending*>& items, std::exception_ptr error)
+{
+    for (Pending* item : items) {
+        item->error = error;
+    }
+    complete(items);
+}
+
+void CompanyWriteCoalescer::complete(const std::vector<Pending*>& items)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        for (Pending* item : items) {
+            item->done = true;
+        }
+        m_jobs += items.size();
+    }
+    m_changed.notify_all();
+}
+
+uint64_t CompanyWriteCoalescer::transactions() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_transactions;
+}
+
+uint64_t CompanyWriteCoalescer::jobs() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_jobs;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+class CompanyRepository;
+
+/**
+ * @brief Group commit for concurrent single-row writes
+ *
+ * Callers of submit() that arrive within window (or until maxBatch jobs are
+ * queued) share one transaction, so the commit cost is paid once per batch.
+ * There is no background thread: the first caller becomes the leader, waits
+ * for the window, runs the batch and wakes the others.
+ *
+ * With an Isolator (savepoints), a job that fails is rolled back on its
+ * own, its caller gets the error, and the batch carries on. Without one,
+ * the batch is rolled back, the failing job is run again alone and the
+ * remaining jobs are retried as a batch.
+ *
+ * Jobs are only run again when the batch transaction certainly rolled
+ * back, i.e. it failed before COMMIT was sent. If the executor throws
+ * after the jobs ran, the commit may have gone through, so every caller
+ * of the batch gets that error instead (as TransactionRetry does).
+ */
+class CompanyWriteCoalescer {
+public:
+    /// Repository work of one caller; must be safe to run more than once
+    using Job = std::function<void(CompanyRepository&)>;
+
+    /// Runs @p body in one transaction and commits; throws if either fails
+    using Executor = std::function<void(const Job& body)>;
+
+    /// Runs one job inside the batch transaction so that its failure can be
+    /// undone alone (SavepointScope) and returns that failure. Errors that
+    /// lose the whole transaction (serialization, connection) are thrown
+    /// instead, so the executor can retry the batch.
+    using Isolator = std::function<std::exception_ptr(CompanyRepository&, const Job&)>;
+
+    CompanyWriteCoalescer(Executor executor,
+                          std::chrono::microseconds window,
+                          size_t maxBatch,
+                          Isolator isolator = {});
+
+    CompanyWriteCoalescer(const CompanyWriteCoalescer&) = delete;
+    CompanyWriteCoalescer& operator=(const CompanyWriteCoalescer&) = delete;
+
+    /**
+     * @brief Run @p job in the next batch and wait until it is committed
+     * @throws whatever @p job (or its isolated retry) threw, or the commit
+     *         error of its batch
+     */
+    void submit(Job job);
+
+    /// Transactions committed or attempted (batches and isolated retries)
+    uint64_t transactions() const;
+
+    /// Jobs completed, successfully or not
+    uint64_t jobs() const;
+
+private:
+    struct Pending {
+        Job job;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    void runBatch(std::vector<Pending*> batch);
+    void runIsolated(std::vector<Pending*> batch);
+    void runAlone(Pending& item);
+    /// Complete @p items with @p error (commit outcome unknown)
+    void failAll(const std::vector<Pending*>& items, std::exception_ptr error);
+    void complete(const std::vector<Pending*>& items);
+
+    Executor m_executor;
+    Isolator m_isolator;
+    std::chrono::microseconds m_window;
+    size_t m_maxBatch;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_changed;
+    std::vector<Pending*> m_queue;
+    bool m_leaderActive = false;
+    uint64_t m_transactions = 0;
+    uint64_t m_jobs = 0;
+};
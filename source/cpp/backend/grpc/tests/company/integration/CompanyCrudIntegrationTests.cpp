@@ -17,11 +17,13 @@
 #include "sqlconnection.h"
 #include "column_allowlist.h"
 #include "configfile.h"
+#include "TypeToStringFormatter.h"
 #include "gtest/gtest.h"
 
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 
 namespace fs = std::filesystem;
 
@@ -64,7 +66,9 @@ protected:
  */
 TEST_F(CompanyCrudIntegrationTest, InsertTemplate_GeneratesCorrectSql)
 {
+    const std::string uid = timeFormatter::generateUuidV7();
     SqlTemplate tpl(m_appletPath + "company_insert.sql");
+    tpl.addParameter("UID", uid.c_str());
     tpl.addParameter("SERVER_UID", 1);
     tpl.addParameter("COMPANY_TYPE", 2);
     tpl.addParameter("NAME", "TestCorp");
@@ -73,17 +77,21 @@ TEST_F(CompanyCrudIntegrationTest, InsertTemplate_GeneratesCorrectSql)
     tpl.addParameter("JOINT_DATE", "2020-06-20", DataInfo::Date);
     tpl.addParameter("LICENSE", "LIC-001");
     tpl.addParameter("LOGO", "");
+    tpl.addParameter("ROW_VERSION", int64_t{7});
 
     ASSERT_NO_THROW(tpl.parse());
 
     // Verify :name markers in output SQL
     std::string sql = tpl.sql();
+    EXPECT_NE(sql.find(":UID,"), std::string::npos);
     EXPECT_NE(sql.find(":SERVER_UID"), std::string::npos);
+    EXPECT_NE(sql.find(":ROW_VERSION"), std::string::npos);
     EXPECT_NE(sql.find(":NAME"), std::string::npos);
     EXPECT_NE(sql.find(":ADDRESS"), std::string::npos);
 
     // Verify debug SQL has substituted values
     std::string debug = tpl.getDebugSql();
+    EXPECT_NE(debug.find(uid), std::string::npos);
     EXPECT_NE(debug.find("TestCorp"), std::string::npos);
     EXPECT_NE(debug.find("123 Main St"), std::string::npos);
     EXPECT_NE(debug.find("LIC-001"), std::string::npos);
@@ -287,3 +295,100 @@ TEST_F(CompanyCrudIntegrationTest, DeleteRow)
     ASSERT_TRUE(verify.FetchNext());
     EXPECT_EQ(verify.Field(1).asLong(), 0);
 }
+
+/**
+ * @test The write applets of one CompanyRepository transaction run on SQLite
+ *
+ * Clock bump, insert, row lock, update, delete and tombstone are separate
+ * plain statements, so SQLite shards take them as well as PostgreSQL. The
+ * templates' debug SQL (values inlined) stands in for named binding.
+ */
+TEST_F(CompanyCrudIntegrationTest, WriteApplets_RunOnSqlite)
+{
+    const char* skipEnv = std::getenv("MEDICON_SKIP_DB_TESTS");
+    if (skipEnv && skipEnv[0] != '\0') {
+        GTEST_SKIP() << "MEDICON_SKIP_DB_TESTS is set";
+    }
+
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "admin", "pass");
+    ASSERT_NO_THROW(conn.connect());
+
+    for (const char* ddl : {
+             "CREATE TABLE company (\"UID\" TEXT PRIMARY KEY, \"SERVER_UID\" INTEGER,"
+             " \"COMPANY_TYPE\" INTEGER, \"NAME\" TEXT, \"ADDRESS\" TEXT, \"REG_DATE\" TEXT,"
+             " \"JOINT_DATE\" TEXT, \"LICENSE\" TEXT, \"LOGO\" BLOB, \"ROW_VERSION\" BIGINT)",
+             "CREATE TABLE company_sync_clock (\"SERVER_UID\" INTEGER PRIMARY KEY,"
+             " \"ROW_VERSION\" BIGINT NOT NULL, \"PRUNED_VERSION\" BIGINT NOT NULL DEFAULT 0)",
+             "CREATE TABLE company_tombstone (\"UID\" TEXT NOT NULL, \"SERVER_UID\" INTEGER NOT NULL,"
+             " \"ROW_VERSION\" BIGINT NOT NULL, \"DELETED_AT\" TEXT NOT NULL DEFAULT CURRENT_TIMESTAMP)"}) {
+        SqlDirectCommand create(conn, SAString(ddl));
+        ASSERT_NO_THROW(create.execute());
+    }
+
+    // Runs the applet and returns @p column of its first row, if any
+    auto run = [&](const char* applet, auto&& bind, const char* column) -> std::optional<int64_t> {
+        SqlTemplate tpl(m_appletPath + applet);
+        bind(tpl);
+        tpl.parse();
+        SqlDirectCommand cmd(conn, SAString(tpl.getDebugSql().c_str()));
+        cmd.execute();
+        if (column && cmd.isResultSet() && cmd.FetchNext()) {
+            return cmd.Field(column).asInt64();
+        }
+        return std::nullopt;
+    };
+    auto scalar = [&](const char* sql) {
+        SqlDirectCommand cmd(conn, SAString(sql));
+        cmd.execute();
+        return cmd.FetchNext() ? cmd.Field(1).asInt64() : -1;
+    };
+    auto bump = [&](int serverUid) {
+        return run("company_sync_clock_bump.sql",
+                   [&](SqlTemplate& t) { t.addParameter("SERVER_UID", serverUid); }, "ROW_VERSION");
+    };
+    auto company = [](int serverUid, int64_t version) {
+        return [=](SqlTemplate& t) {
+            t.addParameter("UID", "uid-1");
+            t.addParameter("SERVER_UID", serverUid);
+            t.addParameter("NAME", "Moving Corp");
+            t.addParameter("LOGO", "");
+            t.addParameter("ROW_VERSION", version);
+        };
+    };
+    auto byUid = [](SqlTemplate& t) { t.addParameter("UID", "uid-1"); };
+    auto tombstone = [&](int serverUid) {
+        const std::optional<int64_t> version = bump(serverUid);
+        ASSERT_TRUE(version.has_value());
+        run("company_tombstone_insert.sql", [&](SqlTemplate& t) {
+            byUid(t);
+            t.addParameter("SERVER_UID", serverUid);
+            t.addParameter("ROW_VERSION", *version);
+        }, nullptr);
+    };
+
+    const std::optional<int64_t> inserted = bump(1);
+    ASSERT_EQ(inserted, 1);
+    ASSERT_NO_THROW(run("company_insert.sql", company(1, *inserted), nullptr));
+
+    // Move to tenant 2: the row lock hands back the old tenant for its tombstone
+    EXPECT_EQ(run("company_lock_row_sqlite.sql", byUid, "SERVER_UID"), 1);
+    const std::optional<int64_t> moved = bump(2);
+    ASSERT_EQ(moved, 1);
+    ASSERT_NO_THROW(run("company_update.sql", company(2, *moved), nullptr));
+    ASSERT_NO_FATAL_FAILURE(tombstone(1));
+
+    EXPECT_EQ(run("company_delete.sql", byUid, "SERVER_UID"), 2);
+    ASSERT_NO_FATAL_FAILURE(tombstone(2));
+
+    EXPECT_EQ(scalar("SELECT COUNT(*) FROM company"), 0);
+    EXPECT_EQ(scalar("SELECT \"ROW_VERSION\" FROM company_tombstone WHERE \"SERVER_UID\" = 1"), 2);
+    EXPECT_EQ(scalar("SELECT \"ROW_VERSION\" FROM company_tombstone WHERE \"SERVER_UID\" = 2"), 2);
+
+    // Prune drops what the horizon (PostgreSQL only) released
+    SqlDirectCommand horizon(conn, SAString(
+        "UPDATE company_sync_clock SET \"PRUNED_VERSION\" = 2 WHERE \"SERVER_UID\" = 1"));
+    horizon.execute();
+    ASSERT_NO_THROW(run("company_tombstone_prune.sql", [](SqlTemplate&) {}, nullptr));
+    EXPECT_EQ(scalar("SELECT COUNT(*) FROM company_tombstone WHERE \"SERVER_UID\" = 1"), 0);
+    EXPECT_EQ(scalar("SELECT COUNT(*) FROM company_tombstone WHERE \"SERVER_UID\" = 2"), 1);
+}
@@ -20,6 +20,7 @@
 #include "configfile.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
@@ -29,6 +30,7 @@
 namespace {
 
 constexpr int TEST_SERVER_UID = 30001;
+constexpr int TEST_MOVE_SERVER_UID = 30002;  ///< target of tenant moves
 constexpr const char* TEST_LICENSE = "LIC-TEST";
 
 CompanyData makeCompany(const std::string& name, const std::string& logo = "")
@@ -82,10 +84,16 @@ protected:
     {
         if (m_conn && m_conn->isConnected()) {
             try {
-                std::string sql = "DELETE FROM company WHERE \"SERVER_UID\" = " +
-                                  std::to_string(TEST_SERVER_UID);
+                std::string sql = "DELETE FROM company WHERE \"SERVER_UID\" IN (" +
+                                  std::to_string(TEST_SERVER_UID) + ", " +
+                                  std::to_string(TEST_MOVE_SERVER_UID) + ")";
                 SqlDirectCommand cleanup(*m_conn, SAString(sql.c_str()));
                 cleanup.execute();
+                sql = "DELETE FROM company_tombstone WHERE \"SERVER_UID\" IN (" +
+                      std::to_string(TEST_SERVER_UID) + ", " +
+                      std::to_string(TEST_MOVE_SERVER_UID) + ")";
+                SqlDirectCommand tombstones(*m_conn, SAString(sql.c_str()));
+                tombstones.execute();
             } catch (...) {
                 // Best-effort cleanup — never fail the test here
             }
@@ -125,7 +133,7 @@ TEST_F(CompanyRepositoryPostgresTest, Update_ModifiesRow)
 
     added.name = "After Name";
     added.address = "456 New Ave";
-    CompanyData updated = repo.update(added);
+    CompanyData updated = repo.update(added).row;
     ASSERT_FALSE(updated.uid.empty());
 
     auto found = repo.findByUid(added.uid);
@@ -203,6 +211,268 @@ TEST_F(CompanyRepositoryPostgresTest, Query_WithFilterValue_FiltersRows)
     EXPECT_EQ(results[0].name, "Alpha");
 }
 
+// ============================================================================
+// Trigram search (schema/003_company_trigram.sql)
+// ============================================================================
+
+TEST_F(CompanyRepositoryPostgresTest, TrigramSearch_IsCaseInsensitive)
+{
+    CompanyRepository repo(conn(), m_appletPath, false);
+    repo.add(makeCompany("Gamma Clinic"));
+    repo.add(makeCompany("Delta"));
+
+    CompanyFilter filter;
+    filter.server_uid = TEST_SERVER_UID;
+    filter.field = "NAME";
+    filter.value = "clin";
+    filter.mode = CompanySearchMode::Trigram;
+
+    auto results = repo.query(filter);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].name, "Gamma Clinic");
+    EXPECT_EQ(repo.count(filter), 1);
+}
+
+TEST_F(CompanyRepositoryPostgresTest, TrigramSearch_UsesGinIndex)
+{
+    {
+        SqlDirectQuery probe(conn(), SAString(
+            "SELECT 1 FROM pg_indexes WHERE indexname = 'company_name_trgm_idx'"));
+        if (!probe.query()) {
+            GTEST_SKIP() << "schema/003_company_trigram.sql not applied";
+        }
+    }
+
+    SqlTemplate tpl(m_appletPath + "company_search_count.sql");
+    tpl.addParameter("SERVER_UID", TEST_SERVER_UID);
+    tpl.addParameter("FILTER_FIELD", "NAME");
+    tpl.addParameter("FILTER_VALUE", "clinic");
+    tpl.setColumnValidator("FILTER_FIELD", &COMPANY_COLUMNS);
+    tpl.parse();
+
+    // The test table is tiny; make the planner show whether the index
+    // is usable at all instead of picking a cheaper sequential scan.
+    SqlDirectCommand(conn(), SAString("SET enable_seqscan = off")).execute();
+
+    SqlDirectQuery explain(conn(), SAString(("EXPLAIN " + tpl.getDebugSql()).c_str()));
+    std::string plan;
+    while (explain.query()) {
+        plan += explain.Field(1).asString().GetMultiByteChars();
+        plan += '\n';
+    }
+    SqlDirectCommand(conn(), SAString("RESET enable_seqscan")).execute();
+
+    EXPECT_NE(plan.find("company_name_trgm_idx"), std::string::npos) << plan;
+}
+
+// ============================================================================
+// Row counters (schema/004_company_row_counter.sql)
+// ============================================================================
+
+TEST_F(CompanyRepositoryPostgresTest, RowCounters_TrackAddRemoveAndReconcile)
+{
+    {
+        SqlDirectQuery probe(conn(), SAString(
+            "SELECT 1 FROM pg_tables WHERE tablename = 'company_row_counter'"));
+        if (!probe.query()) {
+            GTEST_SKIP() << "schema/004_company_row_counter.sql not applied";
+        }
+    }
+
+    CompanyRepository repo(conn(), m_appletPath, false, /*rowCounters=*/true);
+    {
+        TransactionScope tx(conn());
+        repo.reconcileRowCounts(TEST_SERVER_UID);  // start from a clean slate
+        tx.commit();
+    }
+    conn().setAutoCommit(true);  // TransactionScope leaves autocommit off
+    const int64_t before = repo.rowCount(TEST_SERVER_UID);
+
+    CompanyData a = repo.add(makeCompany("Counter A"));
+    repo.add(makeCompany("Counter B"));
+    EXPECT_EQ(repo.rowCount(TEST_SERVER_UID), before + 2);
+
+    repo.remove(a.uid);
+    EXPECT_EQ(repo.rowCount(TEST_SERVER_UID), before + 1);
+
+    // Rows deleted behind the provider's back cause drift until reconciled
+    std::string sql = "DELETE FROM company WHERE \"SERVER_UID\" = " +
+                      std::to_string(TEST_SERVER_UID);
+    SqlDirectCommand(conn(), SAString(sql.c_str())).execute();
+
+    TransactionScope tx(conn());
+    EXPECT_EQ(repo.reconcileRowCounts(TEST_SERVER_UID), 1);
+    tx.commit();
+    conn().setAutoCommit(true);
+    EXPECT_EQ(repo.rowCount(TEST_SERVER_UID), 0);
+}
+
+// ============================================================================
+// Delta sync tombstones (schema/002, schema/005)
+// ============================================================================
+
+TEST_F(CompanyRepositoryPostgresTest, Sync_MoveLeavesTombstoneAndPruneForcesReset)
+{
+    {
+        SqlDirectQuery probe(conn(), SAString(
+            "SELECT 1 FROM information_schema.columns "
+            "WHERE table_name = 'company_sync_clock' AND column_name = 'PRUNED_VERSION'"));
+        if (!probe.query()) {
+            GTEST_SKIP() << "schema/005_company_tombstone_retention.sql not applied";
+        }
+    }
+
+    CompanyRepository repo(conn(), m_appletPath, false);
+    CompanyData moved = repo.add(makeCompany("Moving Corp"));
+    ASSERT_FALSE(moved.uid.empty());
+    const int64_t seen = repo.sync(TEST_SERVER_UID, 0, 1000, false).version;
+
+    moved.server_uid = TEST_MOVE_SERVER_UID;
+    UpdateResult updated = repo.update(moved);
+    ASSERT_FALSE(updated.row.uid.empty());
+    EXPECT_TRUE(updated.moved());
+    EXPECT_EQ(updated.old_server_uid, TEST_SERVER_UID);
+
+    CompanyDelta oldTenant = repo.sync(TEST_SERVER_UID, seen, 1000, false);
+    EXPECT_TRUE(std::find(oldTenant.deleted_uids.begin(), oldTenant.deleted_uids.end(), moved.uid)
+                != oldTenant.deleted_uids.end()) << "the old tenant must see the move as a delete";
+    CompanyDelta newTenant = repo.sync(TEST_MOVE_SERVER_UID, 0, 1000, false);
+    EXPECT_TRUE(std::any_of(newTenant.changed.begin(), newTenant.changed.end(),
+                            [&](const CompanyData& d) { return d.uid == moved.uid; }));
+
+    // Zero retention releases every tombstone; a client that synced before it is reset
+    {
+        TransactionScope tx(conn());
+        EXPECT_GE(repo.pruneTombstones(std::chrono::seconds(0)), 1);
+        tx.commit();
+    }
+    conn().setAutoCommit(true);  // TransactionScope leaves autocommit off
+    EXPECT_TRUE(repo.sync(TEST_SERVER_UID, seen, 1000, false).reset);
+    EXPECT_FALSE(repo.sync(TEST_SERVER_UID, seen, 1000, /*snapshot=*/true).reset);
+    EXPECT_FALSE(repo.sync(TEST_SERVER_UID, oldTenant.version, 1000, false).reset);
+}
+
+TEST_F(CompanyRepositoryPostgresTest, Sync_InSnapshotIgnoresChangesCommittedBetweenReads)
+{
+    CompanyRepository repo(conn(), m_appletPath, false);
+    CompanyData edited = repo.add(makeCompany("Edited Corp"));
+    CompanyData deleted = repo.add(makeCompany("Deleted Corp"));
+    ASSERT_FALSE(edited.uid.empty());
+    ASSERT_FALSE(deleted.uid.empty());
+    const int64_t seen = repo.sync(TEST_SERVER_UID, 0, 1000, false).version;
+
+    SqlConnection other(SA_PostgreSQL_Client, m_host.c_str(), m_user.c_str(), m_pass.c_str());
+    other.connect();
+    CompanyRepository otherRepo(other, m_appletPath, false);
+
+    CompanyDelta inSnapshot;
+    {
+        TransactionScope tx(conn(), TransactionOptions::snapshot());
+        EXPECT_TRUE(repo.sync(TEST_SERVER_UID, seen, 1000, false).changed.empty());
+
+        // An update and then a delete commit while the sync is under way
+        edited.name = "Edited Corp v2";
+        ASSERT_FALSE(otherRepo.update(edited).row.uid.empty());
+        ASSERT_TRUE(otherRepo.remove(deleted.uid).success);
+
+        inSnapshot = repo.sync(TEST_SERVER_UID, seen, 1000, false);
+        tx.commit();
+    }
+    conn().setAutoCommit(true);  // TransactionScope leaves autocommit off
+
+    // Neither change is half-seen, so the next sync from the returned version gets both
+    EXPECT_TRUE(inSnapshot.changed.empty());
+    EXPECT_TRUE(inSnapshot.deleted_uids.empty());
+    EXPECT_EQ(inSnapshot.version, seen);
+
+    CompanyDelta next = repo.sync(TEST_SERVER_UID, inSnapshot.version, 1000, false);
+    ASSERT_EQ(next.changed.size(), 1u);
+    EXPECT_EQ(next.changed[0].name, "Edited Corp v2");
+    EXPECT_EQ(next.deleted_uids, std::vector<std::string>{deleted.uid});
+}
+
+TEST_F(CompanyRepositoryPostgresTest, RowCounters_MoveShiftsCountBetweenTenants)
+{
+    {
+        SqlDirectQuery probe(conn(), SAString(
+            "SELECT 1 FROM pg_tables WHERE tablename = 'company_row_counter'"));
+        if (!probe.query()) {
+            GTEST_SKIP() << "schema/004_company_row_counter.sql not applied";
+        }
+    }
+
+    CompanyRepository repo(conn(), m_appletPath, false, /*rowCounters=*/true);
+    {
+        TransactionScope tx(conn());
+        repo.reconcileRowCounts(TEST_SERVER_UID);
+        repo.reconcileRowCounts(TEST_MOVE_SERVER_UID);
+        tx.commit();
+    }
+    conn().setAutoCommit(true);  // TransactionScope leaves autocommit off
+    const int64_t from = repo.rowCount(TEST_SERVER_UID);
+    const int64_t to = repo.rowCount(TEST_MOVE_SERVER_UID);
+
+    CompanyData moved = repo.add(makeCompany("Counter Move"));
+    moved.server_uid = TEST_MOVE_SERVER_UID;
+    ASSERT_FALSE(repo.update(moved).row.uid.empty());
+
+    EXPECT_EQ(repo.rowCount(TEST_SERVER_UID), from);
+    EXPECT_EQ(repo.rowCount(TEST_MOVE_SERVER_UID), to + 1);
+
+    // Nothing left for the reconciler to correct
+    TransactionScope tx(conn());
+    EXPECT_EQ(repo.reconcileRowCounts(TEST_SERVER_UID), 0);
+    EXPECT_EQ(repo.reconcileRowCounts(TEST_MOVE_SERVER_UID), 0);
+    tx.commit();
+    conn().setAutoCommit(true);
+}
+
+TEST_F(CompanyRepositoryPostgresTest, FindByUids_OneQueryForManyUids)
+{
+    CompanyRepository repo(conn(), m_appletPath, false);
+    CompanyData first = repo.add(makeCompany("MultiGet One"));
+    CompanyData second = repo.add(makeCompany("MultiGet Two"));
+    ASSERT_FALSE(first.uid.empty());
+    ASSERT_FALSE(second.uid.empty());
+
+    auto rows = repo.findByUids({second.uid, "no-such-uid", first.uid});
+    ASSERT_EQ(rows.size(), 2u);
+    std::vector<std::string> names{rows[0].name, rows[1].name};
+    std::sort(names.begin(), names.end());
+    EXPECT_EQ(names, (std::vector<std::string>{"MultiGet One", "MultiGet Two"}));
+
+    EXPECT_TRUE(repo.findByUids({}).empty());
+}
+
+// ============================================================================
+// Server-side cursor streaming (SqlDirectQuery::setServerCursor)
+// ============================================================================
+
+TEST_F(CompanyRepositoryPostgresTest, ServerCursor_StreamsInBatches)
+{
+    auto sumRows = [this] {
+        SqlDirectQuery query(conn(), SAString("SELECT n FROM generate_series(1, 10) AS n ORDER BY n;"));
+        query.setServerCursor(3);  // 3 + 3 + 3 + 1 rows
+        EXPECT_EQ(query.sql().rfind("DECLARE ", 0), 0u) << query.sql();
+        long sum = 0;
+        for (SqlDirectQuery& row : query.rows()) {
+            sum += row.Field(1).asLong();
+        }
+        return sum;
+    };
+
+    // Autocommit: declared WITH HOLD
+    EXPECT_EQ(sumRows(), 55);
+
+    // Inside a transaction: ends with it
+    {
+        TransactionScope tx(conn());
+        EXPECT_EQ(sumRows(), 55);
+        tx.commit();
+    }
+    conn().setAutoCommit(true);  // TransactionScope leaves autocommit off
+}
+
 // ============================================================================
 // bytea LOGO regression
 // ============================================================================
@@ -259,3 +529,67 @@ TEST_F(CompanyRepositoryPostgresTest, Service_QueryCompanies_WithServerUidAndEmp
     auto list = service.queryCompanies(filter);
     EXPECT_EQ(list.size(), 2u);
 }
+
+TEST_F(CompanyRepositoryPostgresTest, Service_ShardMap_RoutesTenantToOwningShard)
+{
+    // Only the test tenant's shard is reachable; a request routed anywhere
+    // else would fail to connect (pools connect lazily)
+    CompanyShardSpec elsewhere;
+    elsewhere.name = "elsewhere";
+    elsewhere.from = 1;
+    elsewhere.to = TEST_SERVER_UID - 1;
+    elsewhere.host = "127.0.0.1,1@unreachable";
+    elsewhere.user = m_user;
+    elsewhere.pass = m_pass;
+
+    CompanyShardSpec tenant = elsewhere;
+    tenant.name = "tenant";
+    tenant.from = TEST_SERVER_UID;
+    tenant.to = TEST_SERVER_UID;
+    tenant.host = m_host;
+
+    CompanyServiceOptions options;
+    options.shards = {elsewhere, tenant};
+    CompanyService service(m_appletPath, m_host, m_user, m_pass, false, options);
+
+    service.addCompany(makeCompany("Sharded"));
+
+    CompanyFilter filter;
+    filter.server_uid = TEST_SERVER_UID;
+    filter.field = "NAME";
+    filter.value = "Sharded";
+    EXPECT_EQ(service.queryCompanies(filter).size(), 1u);
+    EXPECT_EQ(service.countCompanies(filter), 1);
+}
+
+TEST_F(CompanyRepositoryPostgresTest, Service_ShardMap_RejectsCrossShardMove)
+{
+    // Both shards are this database; only the map tells them apart
+    CompanyShardSpec from;
+    from.name = "from";
+    from.from = TEST_SERVER_UID;
+    from.to = TEST_SERVER_UID;
+    from.host = m_host;
+    from.user = m_user;
+    from.pass = m_pass;
+
+    CompanyShardSpec to = from;
+    to.name = "to";
+    to.from = TEST_MOVE_SERVER_UID;
+    to.to = TEST_MOVE_SERVER_UID;
+
+    CompanyServiceOptions options;
+    options.shards = {from, to};
+    CompanyService service(m_appletPath, m_host, m_user, m_pass, false, options);
+
+    CompanyData company = makeCompany("Stays Put");
+    company.uid = service.addCompany(company).uid;
+    ASSERT_FALSE(company.uid.empty());
+
+    company.server_uid = TEST_MOVE_SERVER_UID;
+    EXPECT_THROW(service.editCompany(company), CompanyShardMoveException);
+
+    auto found = service.getCompanyByUid(company.uid);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->server_uid, TEST_SERVER_UID);
+}
@@ -0,0 +1,202 @@
+/**
+ * @file CompanyChangeFeedTests.cpp
+ * @brief Tests for the WatchCompanies change feed
+ *
+ * Verifies:
+ * - CompanyChangeFeed sequencing, tenant filtering, resume and heartbeat timeout
+ * - CompanyChangeListener::parsePayload() for NOTIFY trigger payloads
+ * - CompanyService publishes committed mutations to its feed
+ *
+ * No database needed.
+ */
+#include "company/company_change_feed.h"
+#include "company/company_change_listener.h"
+#include "company/company_service.h"
+#include "company_repository_mock.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+// ============================================================================
+// CompanyChangeFeed
+// ============================================================================
+
+TEST(CompanyChangeFeedTest, Publish_AssignsIncreasingSequences)
+{
+    CompanyChangeFeed feed;
+    EXPECT_EQ(feed.publish(ChangeOperation::Insert, 1, "a"), 1u);
+    EXPECT_EQ(feed.publish(ChangeOperation::Update, 1, "a"), 2u);
+    EXPECT_EQ(feed.lastSequence(), 2u);
+    EXPECT_NE(feed.epoch(), 0u);
+}
+
+TEST(CompanyChangeFeedTest, Wait_ReturnsOnlyMatchingTenant)
+{
+    CompanyChangeFeed feed;
+    feed.publish(ChangeOperation::Insert, 1, "a");
+    feed.publish(ChangeOperation::Insert, 2, "b");
+    feed.publish(ChangeOperation::Delete, 1, "c");
+
+    auto batch = feed.waitForChanges(1, 0, 0ms);
+
+    ASSERT_EQ(batch.events.size(), 2u);
+    EXPECT_EQ(batch.events[0].uid, "a");
+    EXPECT_EQ(batch.events[1].uid, "c");
+    EXPECT_EQ(batch.events[1].op, ChangeOperation::Delete);
+    EXPECT_EQ(batch.lastSequence, 3u);
+    EXPECT_FALSE(batch.resumeGap);
+}
+
+TEST(CompanyChangeFeedTest, Wait_ResumesAfterSequence)
+{
+    CompanyChangeFeed feed;
+    feed.publish(ChangeOperation::Insert, 1, "a");
+    const uint64_t seen = feed.publish(ChangeOperation::Insert, 1, "b");
+    feed.publish(ChangeOperation::Insert, 1, "c");
+
+    auto batch = feed.waitForChanges(1, seen, 0ms);
+
+    ASSERT_EQ(batch.events.size(), 1u);
+    EXPECT_EQ(batch.events[0].uid, "c");
+}
+
+TEST(CompanyChangeFeedTest, Wait_ReportsGapWhenSequenceNoLongerRetained)
+{
+    CompanyChangeFeed feed(2);
+    for (int i = 0; i < 5; ++i) {
+        feed.publish(ChangeOperation::Update, 1, "a");
+    }
+
+    auto batch = feed.waitForChanges(1, 1, 0ms);
+
+    EXPECT_TRUE(batch.resumeGap);
+    EXPECT_EQ(batch.lastSequence, 5u);
+}
+
+TEST(CompanyChangeFeedTest, Wait_ReportsGapForUnknownFutureSequence)
+{
+    CompanyChangeFeed feed;
+    feed.publish(ChangeOperation::Insert, 1, "a");
+
+    auto batch = feed.waitForChanges(1, 99, 0ms);
+
+    EXPECT_TRUE(batch.resumeGap);
+}
+
+TEST(CompanyChangeFeedTest, Wait_ResetReachesEveryTenant)
+{
+    CompanyChangeFeed feed;
+    feed.publish(ChangeOperation::Reset, 0, "");
+
+    auto batch = feed.waitForChanges(7, 0, 0ms);
+
+    ASSERT_EQ(batch.events.size(), 1u);
+    EXPECT_EQ(batch.events[0].op, ChangeOperation::Reset);
+}
+
+TEST(CompanyChangeFeedTest, Wait_TimesOutWithEmptyBatch)
+{
+    CompanyChangeFeed feed;
+    feed.publish(ChangeOperation::Insert, 2, "other-tenant");
+
+    auto batch = feed.waitForChanges(1, 0, 20ms);
+
+    EXPECT_TRUE(batch.events.empty());
+    EXPECT_FALSE(batch.resumeGap);
+    EXPECT_EQ(batch.lastSequence, 1u);  // other tenant's event was skipped
+}
+
+TEST(CompanyChangeFeedTest, Wait_WakesOnPublish)
+{
+    CompanyChangeFeed feed;
+    std::thread producer([&feed] {
+        std::this_thread::sleep_for(20ms);
+        feed.publish(ChangeOperation::Insert, 1, "late");
+    });
+
+    auto batch = feed.waitForChanges(1, 0, 5s);
+    producer.join();
+
+    ASSERT_EQ(batch.events.size(), 1u);
+    EXPECT_EQ(batch.events[0].uid, "late");
+}
+
+TEST(CompanyChangeFeedTest, Close_WakesWaiters)
+{
+    CompanyChangeFeed feed;
+    std::thread closer([&feed] {
+        std::this_thread::sleep_for(20ms);
+        feed.close();
+    });
+
+    auto batch = feed.waitForChanges(1, 0, 5s);
+    closer.join();
+
+    EXPECT_TRUE(batch.closed);
+}
+
+// ============================================================================
+// NOTIFY payload parsing
+// ============================================================================
+
+TEST(CompanyChangeListenerTest, ParsePayload_Valid)
+{
+    ChangeOperation op;
+    int serverUid = 0;
+    std::string uid;
+
+    ASSERT_TRUE(CompanyChangeListener::parsePayload("U|30001|abc-123", op, serverUid, uid));
+    EXPECT_EQ(op, ChangeOperation::Update);
+    EXPECT_EQ(serverUid, 30001);
+    EXPECT_EQ(uid, "abc-123");
+
+    ASSERT_TRUE(CompanyChangeListener::parsePayload("D|1|x", op, serverUid, uid));
+    EXPECT_EQ(op, ChangeOperation::Delete);
+}
+
+TEST(CompanyChangeListenerTest, ParsePayload_RejectsMalformed)
+{
+    ChangeOperation op;
+    int serverUid = 0;
+    std::string uid;
+
+    EXPECT_FALSE(CompanyChangeListener::parsePayload("", op, serverUid, uid));
+    EXPECT_FALSE(CompanyChangeListener::parsePayload("X|1|uid", op, serverUid, uid));
+    EXPECT_FALSE(CompanyChangeListener::parsePayload("I|abc|uid", op, serverUid, uid));
+    EXPECT_FALSE(CompanyChangeListener::parsePayload("I|1|", op, serverUid, uid));
+    EXPECT_FALSE(CompanyChangeListener::parsePayload("INSERT|1|uid", op, serverUid, uid));
+}
+
+// ============================================================================
+// CompanyService → feed
+// ============================================================================
+
+TEST(CompanyChangeFeedTest, Service_PublishesCommittedMutations)
+{
+    auto mock = std::make_unique<MockCompanyRepository>();
+    CompanyService service(std::move(mock));
+    auto feed = service.changeFeed();
+
+    CompanyData data;
+    data.server_uid = 5;
+    data.name = "Watched";
+    CompanyData added = service.addCompany(data);
+    added.server_uid = 5;
+    service.editCompany(added);
+    service.deleteCompany(added.uid);
+    service.deleteCompany("missing");  // failed delete is not published
+
+    auto batch = feed->waitForChanges(5, 0, 0ms);
+
+    ASSERT_EQ(batch.events.size(), 3u);
+    EXPECT_EQ(batch.events[0].op, ChangeOperation::Insert);
+    EXPECT_EQ(batch.events[1].op, ChangeOperation::Update);
+    EXPECT_EQ(batch.events[2].op, ChangeOperation::Delete);
+    for (const auto& event : batch.events) {
+        EXPECT_EQ(event.uid, added.uid);
+        EXPECT_EQ(event.server_uid, 5);
+    }
+}
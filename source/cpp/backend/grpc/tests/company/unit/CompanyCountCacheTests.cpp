@@ -0,0 +1,218 @@
+/**
+ * @file CompanyCountCacheTests.cpp
+ * @brief Tests for cached and estimated company counts
+ *
+ * Verifies:
+ * - CompanyCountCache threshold, TTL, key normalization and invalidation
+ * - CompanyService::countCompanies() with CountAccuracy::Estimate
+ * - Unfiltered counts answered by the row counters
+ *
+ * No database needed.
+ */
+#include "company/company_count_cache.h"
+#include "company/company_service.h"
+#include "company_repository_mock.h"
+#include "gtest/gtest.h"
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+CompanyFilter makeFilter(int serverUid, const std::string& value)
+{
+    CompanyFilter filter;
+    filter.server_uid = serverUid;
+    filter.value = value;
+    return filter;
+}
+
+} // namespace
+
+// ============================================================================
+// CompanyCountCache
+// ============================================================================
+
+TEST(CompanyCountCacheTest, SmallCountsAreNotCached)
+{
+    CompanyCountCache cache(10s, 100);
+    cache.store(makeFilter(1, "a"), 99);
+    EXPECT_FALSE(cache.find(makeFilter(1, "a")).has_value());
+
+    cache.store(makeFilter(1, "a"), 100);
+    EXPECT_EQ(cache.find(makeFilter(1, "a")), 100);
+}
+
+TEST(CompanyCountCacheTest, EntriesExpireAfterTtl)
+{
+    CompanyCountCache cache(10s, 1);
+    const auto now = CompanyCountCache::Clock::now();
+    cache.store(makeFilter(1, "a"), 500, now);
+
+    EXPECT_EQ(cache.find(makeFilter(1, "a"), now + 9s), 500);
+    EXPECT_FALSE(cache.find(makeFilter(1, "a"), now + 10s).has_value());
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(CompanyCountCacheTest, KeyIgnoresPagingAndDefaultsColumn)
+{
+    CompanyCountCache cache(10s, 1);
+    CompanyFilter stored = makeFilter(1, "a");
+    stored.offset = 200;
+    cache.store(stored, 700);
+
+    CompanyFilter lookup = makeFilter(1, "a");
+    lookup.field = "name";
+    EXPECT_EQ(cache.find(lookup), 700);
+
+    lookup.mode = CompanySearchMode::Trigram;
+    EXPECT_FALSE(cache.find(lookup).has_value());
+}
+
+TEST(CompanyCountCacheTest, InvalidateDropsOnlyThatTenant)
+{
+    CompanyCountCache cache(10s, 1);
+    cache.store(makeFilter(1, "a"), 10);
+    cache.store(makeFilter(1, "b"), 10);
+    cache.store(makeFilter(2, "a"), 10);
+
+    cache.invalidate(1);
+
+    EXPECT_FALSE(cache.find(makeFilter(1, "a")).has_value());
+    EXPECT_FALSE(cache.find(makeFilter(1, "b")).has_value());
+    EXPECT_EQ(cache.find(makeFilter(2, "a")), 10);
+}
+
+TEST(CompanyCountCacheTest, ZeroTtlDisablesCaching)
+{
+    CompanyCountCache cache(0s, 1);
+    cache.store(makeFilter(1, "a"), 10);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+// ============================================================================
+// CompanyService counts
+// ============================================================================
+
+class CompanyServiceCountTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        CompanyServiceOptions options;
+        options.countCacheThreshold = 3;
+        auto mock = std::make_unique<MockCompanyRepository>();
+        m_mock = mock.get();
+        m_service = std::make_unique<CompanyService>(std::move(mock), options);
+
+        for (int i = 0; i < 4; ++i) {
+            CompanyData d;
+            d.name = "Counted";
+            m_mock->addPreExisting(d);
+        }
+    }
+
+    MockCompanyRepository* m_mock = nullptr;
+    std::unique_ptr<CompanyService> m_service;
+};
+
+TEST_F(CompanyServiceCountTest, ExactCountAboveThresholdIsCached)
+{
+    EXPECT_EQ(m_service->countCompanies(makeFilter(0, "Counted")), 4);
+    EXPECT_EQ(m_service->countCompanies(makeFilter(0, "Counted")), 4);
+    EXPECT_EQ(m_mock->countCalls(), 1);
+}
+
+TEST_F(CompanyServiceCountTest, MutationInvalidatesTenantCounts)
+{
+    m_service->countCompanies(makeFilter(0, "Counted"));
+
+    CompanyData d;
+    d.name = "Counted";
+    m_service->addCompany(d);
+
+    EXPECT_EQ(m_service->countCompanies(makeFilter(0, "Counted")), 5);
+    EXPECT_EQ(m_mock->countCalls(), 2);
+}
+
+TEST_F(CompanyServiceCountTest, EstimateReturnedWhenLarge)
+{
+    m_mock->setEstimate(12400);
+
+    CompanyCount count = m_service->countCompanies(makeFilter(0, "Counted"), CountAccuracy::Estimate);
+
+    EXPECT_TRUE(count.estimated);
+    EXPECT_EQ(count.count, 12400);
+    EXPECT_EQ(m_mock->countCalls(), 0);
+}
+
+TEST_F(CompanyServiceCountTest, SmallEstimateFallsBackToExact)
+{
+    m_mock->setEstimate(2);
+
+    CompanyCount count = m_service->countCompanies(makeFilter(0, "Counted"), CountAccuracy::Estimate);
+
+    EXPECT_FALSE(count.estimated);
+    EXPECT_EQ(count.count, 4);
+}
+
+TEST_F(CompanyServiceCountTest, NoEstimateFallsBackToExact)
+{
+    CompanyCount count = m_service->countCompanies(makeFilter(0, "Counted"), CountAccuracy::Estimate);
+
+    EXPECT_FALSE(count.estimated);
+    EXPECT_EQ(count.count, 4);
+}
+
+TEST_F(CompanyServiceCountTest, CachedExactCountBeatsEstimate)
+{
+    m_service->countCompanies(makeFilter(0, "Counted"));
+    m_mock->setEstimate(12400);
+
+    CompanyCount count = m_service->countCompanies(makeFilter(0, "Counted"), CountAccuracy::Estimate);
+
+    EXPECT_FALSE(count.estimated);
+    EXPECT_EQ(count.count, 4);
+}
+
+// ============================================================================
+// Row counters
+// ============================================================================
+
+TEST(CompanyServiceRowCounterTest, UnfilteredCountUsesRowCounter)
+{
+    CompanyServiceOptions options;
+    options.rowCounters = true;
+    auto mock = std::make_unique<MockCompanyRepository>();
+    MockCompanyRepository* repo = mock.get();
+    CompanyService service(std::move(mock), options);
+
+    CompanyData d;
+    d.server_uid = 9;
+    d.name = "Tenant9";
+    repo->addPreExisting(d);
+    repo->addPreExisting(d);
+
+    EXPECT_EQ(service.countCompanies(makeFilter(9, "")), 2);
+    CompanyCount estimated = service.countCompanies(makeFilter(9, ""), CountAccuracy::Estimate);
+    EXPECT_EQ(estimated.count, 2);
+    EXPECT_FALSE(estimated.estimated);
+    EXPECT_EQ(repo->rowCountCalls(), 2);
+    EXPECT_EQ(repo->countCalls(), 0);
+
+    // A search term still needs COUNT(*)
+    service.countCompanies(makeFilter(9, "Tenant"));
+    EXPECT_EQ(repo->countCalls(), 1);
+}
+
+TEST(CompanyServiceRowCounterTest, DisabledByDefault)
+{
+    auto mock = std::make_unique<MockCompanyRepository>();
+    MockCompanyRepository* repo = mock.get();
+    CompanyService service(std::move(mock));
+
+    service.countCompanies(makeFilter(9, ""));
+
+    EXPECT_EQ(repo->rowCountCalls(), 0);
+    EXPECT_EQ(repo->countCalls(), 1);
+}
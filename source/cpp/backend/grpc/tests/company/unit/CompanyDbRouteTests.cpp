@@ -0,0 +1,87 @@
+/**
+ * @file CompanyDbRouteTests.cpp
+ * @brief Tests for primary/replica read routing
+ *
+ * Verifies:
+ * - Reads go to the primary without replicas
+ * - Replicas are used round-robin and skipped while unhealthy
+ * - Read-your-writes pins a tenant (and uid lookups) to the primary
+ *
+ * No database needed — pools are never asked for a connection.
+ */
+#include "company/company_db_route.h"
+#include "gtest/gtest.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::unique_ptr<SqlConnectionPool> makePool(const char* host)
+{
+    return std::make_unique<SqlConnectionPool>(SA_PostgreSQL_Client, host, "user", "pass", 1, 1s);
+}
+
+CompanyDbRoute makeRoute(size_t replicas, std::chrono::milliseconds readYourWrites = 2s)
+{
+    std::vector<std::unique_ptr<SqlConnectionPool>> pools;
+    for (size_t i = 0; i < replicas; ++i) {
+        pools.push_back(makePool(i == 0 ? "replica-a" : "replica-b"));
+    }
+    return CompanyDbRoute(makePool("primary"), std::move(pools), readYourWrites);
+}
+
+} // namespace
+
+TEST(CompanyDbRouteTest, NoReplicas_ReadsFromPrimary)
+{
+    CompanyDbRoute route = makeRoute(0);
+    EXPECT_EQ(&route.readPool(1), &route.primary());
+    EXPECT_EQ(&route.readPool(std::nullopt), &route.primary());
+}
+
+TEST(CompanyDbRouteTest, Reads_AlternateBetweenReplicas)
+{
+    CompanyDbRoute route = makeRoute(2);
+
+    const std::string first = route.readPool(1).host();
+    const std::string second = route.readPool(1).host();
+
+    EXPECT_NE(first, "primary");
+    EXPECT_NE(second, "primary");
+    EXPECT_NE(first, second);
+}
+
+TEST(CompanyDbRouteTest, UnhealthyReplica_IsSkipped)
+{
+    CompanyDbRoute route = makeRoute(2);
+    SqlConnectionPool& failed = route.readPool(1);
+    failed.reportFailure();
+
+    for (int i = 0; i < 4; ++i) {
+        SqlConnectionPool& pool = route.readPool(1);
+        EXPECT_NE(&pool, &failed);
+        EXPECT_NE(&pool, &route.primary());
+    }
+}
+
+TEST(CompanyDbRouteTest, AllReplicasUnhealthy_FallsBackToPrimary)
+{
+    CompanyDbRoute route = makeRoute(1);
+    route.readPool(1).reportFailure();
+
+    EXPECT_EQ(&route.readPool(1), &route.primary());
+    // Cooldown over: the replica is tried again
+    EXPECT_NE(&route.readPool(1, SqlConnectionPool::Clock::now() + 2s), &route.primary());
+}
+
+TEST(CompanyDbRouteTest, Write_PinsTenantToPrimary)
+{
+    CompanyDbRoute route = makeRoute(1, 100ms);
+    const auto now = SqlConnectionPool::Clock::now();
+    route.noteWrite(7, now);
+
+    EXPECT_EQ(&route.readPool(7, now), &route.primary());
+    EXPECT_NE(&route.readPool(8, now), &route.primary());   // other tenant
+    EXPECT_EQ(&route.readPool(std::nullopt, now), &route.primary());  // unknown tenant
+    EXPECT_NE(&route.readPool(7, now + 200ms), &route.primary());     // window over
+}
@@ -0,0 +1,83 @@
+/**
+ * @file CompanyHealthServiceTests.cpp
+ * @brief Tests for CompanyHealthService (grpc.health.v1)
+ *
+ * Verifies that the service reports NOT_SERVING until setServing(true),
+ * rejects unknown service names and streams status changes to Watch.
+ * Watch runs against an in-process server; no database needed.
+ */
+#include "company/company_health_service.h"
+#include "gtest/gtest.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <memory>
+
+using grpc::health::v1::Health;
+using grpc::health::v1::HealthCheckRequest;
+using grpc::health::v1::HealthCheckResponse;
+
+TEST(CompanyHealthServiceTest, Check_NotServingUntilSet)
+{
+    CompanyHealthService health({"CompanyEdit.CompanyEditor"});
+    HealthCheckRequest request;
+    HealthCheckResponse response;
+
+    ASSERT_TRUE(health.Check(nullptr, &request, &response).ok());
+    EXPECT_EQ(response.status(), HealthCheckResponse::NOT_SERVING);
+
+    health.setServing(true);
+    request.set_service("CompanyEdit.CompanyEditor");
+    ASSERT_TRUE(health.Check(nullptr, &request, &response).ok());
+    EXPECT_EQ(response.status(), HealthCheckResponse::SERVING);
+}
+
+TEST(CompanyHealthServiceTest, Check_UnknownServiceIsNotFound)
+{
+    CompanyHealthService health({"CompanyEdit.CompanyEditor"});
+    health.setServing(true);
+
+    HealthCheckRequest request;
+    request.set_service("Other.Service");
+    HealthCheckResponse response;
+    EXPECT_EQ(health.Check(nullptr, &request, &response).error_code(), grpc::StatusCode::NOT_FOUND);
+}
+
+TEST(CompanyHealthServiceTest, Shutdown_StaysNotServing)
+{
+    CompanyHealthService health;
+    health.setServing(true);
+    health.shutdown();
+    health.setServing(true);
+    EXPECT_FALSE(health.serving());
+}
+
+TEST(CompanyHealthServiceTest, Watch_StreamsStatusChanges)
+{
+    CompanyHealthService health;
+    grpc::ServerBuilder builder;
+    builder.RegisterService(&health);
+    std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+    ASSERT_NE(server, nullptr);
+
+    auto stub = Health::NewStub(server->InProcessChannel(grpc::ChannelArguments()));
+    grpc::ClientContext context;
+    auto reader = stub->Watch(&context, HealthCheckRequest());
+
+    HealthCheckResponse response;
+    ASSERT_TRUE(reader->Read(&response));
+    EXPECT_EQ(response.status(), HealthCheckResponse::NOT_SERVING);
+
+    health.setServing(true);
+    ASSERT_TRUE(reader->Read(&response));
+    EXPECT_EQ(response.status(), HealthCheckResponse::SERVING);
+
+    // Shutdown sends the final NOT_SERVING and ends the stream
+    health.shutdown();
+    ASSERT_TRUE(reader->Read(&response));
+    EXPECT_EQ(response.status(), HealthCheckResponse::NOT_SERVING);
+    EXPECT_FALSE(reader->Read(&response));
+    EXPECT_TRUE(reader->Finish().ok());
+
+    server->Shutdown();
+}
@@ -4,7 +4,8 @@
  *
  * Verifies the pure conversion helpers:
  * - toCompanyData():  protobuf Company → domain CompanyData
- * - toCompanyFilter(): JsonParameters → domain CompanyFilter
+ * - toCompanyFilter(): JsonParameters / CompanyQuery → domain CompanyFilter
+ * - encodeCursor()/decodeCursor(): opaque paging cursor round-trip
  * - toProto():         domain CompanyData → protobuf Company
  *
  * No database or gRPC server needed — these are pure static functions.
@@ -194,3 +195,163 @@ TEST(CompanyServiceImplTest, ToCompanyFilter_MissingServerUid_DefaultsZero)
     EXPECT_EQ(filter.server_uid, 0);
     EXPECT_EQ(filter.value, "search");
 }
+
+// ============================================================================
+// toCompanyFilter — typed CompanyQuery → domain filter
+// ============================================================================
+
+TEST(CompanyServiceImplTest, ToCompanyFilter_Query_AllFieldsMapped)
+{
+    CompanyQuery query;
+    query.set_server_uid(1001);
+    query.set_filter_field(FILTER_FIELD_ADDRESS);
+    query.set_filter_value("Main");
+    query.set_limit(25);
+    query.set_cursor(CompanyServiceImpl::encodeCursor(50));
+
+    CompanyFilter filter = CompanyServiceImpl::toCompanyFilter(query);
+
+    EXPECT_EQ(filter.server_uid, 1001);
+    EXPECT_EQ(filter.field, "ADDRESS");
+    EXPECT_EQ(filter.value, "Main");
+    EXPECT_EQ(filter.offset, 50);
+    EXPECT_EQ(filter.limit, 25);
+}
+
+TEST(CompanyServiceImplTest, ToCompanyFilter_Query_EmptyProducesDefaults)
+{
+    CompanyQuery query;
+
+    CompanyFilter filter = CompanyServiceImpl::toCompanyFilter(query);
+
+    EXPECT_EQ(filter.server_uid, 0);
+    EXPECT_TRUE(filter.field.empty());  // template default column
+    EXPECT_TRUE(filter.value.empty());
+    EXPECT_EQ(filter.offset, 0);
+    EXPECT_EQ(filter.limit, CompanyServiceImpl::DEFAULT_PAGE_SIZE);
+}
+
+TEST(CompanyServiceImplTest, ToCompanyFilter_Query_LimitIsClamped)
+{
+    CompanyQuery query;
+    query.set_limit(1'000'000);
+    EXPECT_EQ(CompanyServiceImpl::toCompanyFilter(query).limit,
+              CompanyServiceImpl::MAX_PAGE_SIZE);
+
+    query.set_limit(-5);
+    EXPECT_EQ(CompanyServiceImpl::toCompanyFilter(query).limit,
+              CompanyServiceImpl::DEFAULT_PAGE_SIZE);
+}
+
+TEST(CompanyServiceImplTest, ToColumnName_MapsEveryFilterField)
+{
+    EXPECT_STREQ(CompanyServiceImpl::toColumnName(FILTER_FIELD_NAME), "NAME");
+    EXPECT_STREQ(CompanyServiceImpl::toColumnName(FILTER_FIELD_ADDRESS), "ADDRESS");
+    EXPECT_STREQ(CompanyServiceImpl::toColumnName(FILTER_FIELD_LICENSE), "LICENSE");
+    EXPECT_STREQ(CompanyServiceImpl::toColumnName(FILTER_FIELD_UID), "UID");
+    EXPECT_STREQ(CompanyServiceImpl::toColumnName(FILTER_FIELD_UNSPECIFIED), "");
+}
+
+TEST(CompanyServiceImplTest, ToCompanyFilter_Query_SearchModeMapped)
+{
+    CompanyQuery query;
+    EXPECT_EQ(CompanyServiceImpl::toCompanyFilter(query).mode, ::CompanySearchMode::Like);
+
+    query.set_search_mode(SEARCH_MODE_TRIGRAM);
+    EXPECT_EQ(CompanyServiceImpl::toCompanyFilter(query).mode, ::CompanySearchMode::Trigram);
+
+    query.set_search_mode(SEARCH_MODE_SIMILAR);
+    EXPECT_EQ(CompanyServiceImpl::toCompanyFilter(query).mode, ::CompanySearchMode::Similar);
+}
+
+TEST(CompanyServiceImplTest, ToSearchMode_JsonNames)
+{
+    EXPECT_EQ(CompanyServiceImpl::toSearchMode("TRIGRAM"), ::CompanySearchMode::Trigram);
+    EXPECT_EQ(CompanyServiceImpl::toSearchMode("SIMILAR"), ::CompanySearchMode::Similar);
+    EXPECT_EQ(CompanyServiceImpl::toSearchMode("LIKE"), ::CompanySearchMode::Like);
+    EXPECT_EQ(CompanyServiceImpl::toSearchMode("bogus"), ::CompanySearchMode::Like);
+}
+
+// ============================================================================
+// Paging cursor
+// ============================================================================
+
+TEST(CompanyServiceImplTest, Cursor_RoundTrip)
+{
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor(CompanyServiceImpl::encodeCursor(0)), 0);
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor(CompanyServiceImpl::encodeCursor(300)), 300);
+}
+
+TEST(CompanyServiceImplTest, Cursor_InvalidRestartsFromFirstPage)
+{
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor(""), 0);
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor("garbage"), 0);
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor("o:"), 0);
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor("o:12x"), 0);
+    EXPECT_EQ(CompanyServiceImpl::decodeCursor("o:-10"), 0);
+}
+
+TEST(CompanyServiceImplTest, SyncBatchSize_DefaultsAndClamps)
+{
+    EXPECT_EQ(CompanyServiceImpl::syncBatchSize(0), CompanyServiceImpl::DEFAULT_SYNC_BATCH);
+    EXPECT_EQ(CompanyServiceImpl::syncBatchSize(-4), CompanyServiceImpl::DEFAULT_SYNC_BATCH);
+    EXPECT_EQ(CompanyServiceImpl::syncBatchSize(42), 42);
+    EXPECT_EQ(CompanyServiceImpl::syncBatchSize(1'000'000), CompanyServiceImpl::MAX_SYNC_BATCH);
+}
+
+TEST(CompanyServiceImplTest, ToProto_Delta)
+{
+    CompanyDelta delta;
+    CompanyData changed;
+    changed.uid = "u-1";
+    changed.row_version = 41;
+    delta.changed.push_back(changed);
+    delta.deleted_uids.push_back("u-2");
+    delta.version = 42;
+    delta.has_more = true;
+    delta.reset = true;
+
+    SyncResponse proto;
+    CompanyServiceImpl::toProto(delta, &proto);
+
+    ASSERT_EQ(proto.changed_size(), 1);
+    EXPECT_EQ(proto.changed(0).uid(), "u-1");
+    EXPECT_EQ(proto.changed(0).row_version(), 41);
+    ASSERT_EQ(proto.deleted_uids_size(), 1);
+    EXPECT_EQ(proto.deleted_uids(0), "u-2");
+    EXPECT_EQ(proto.version(), 42);
+    EXPECT_TRUE(proto.has_more());
+    EXPECT_TRUE(proto.reset());
+}
+
+TEST(CompanyServiceImplTest, ToProto_Lookup)
+{
+    CompanyLookupData lookup;
+    CompanyData found;
+    found.uid = "u-1";
+    found.name = "Found";
+    lookup.rows.push_back(found);
+    lookup.missing_uids.push_back("u-2");
+
+    CompanyLookup proto;
+    CompanyServiceImpl::toProto(lookup, &proto);
+
+    ASSERT_EQ(proto.companies_size(), 1);
+    EXPECT_EQ(proto.companies(0).uid(), "u-1");
+    EXPECT_EQ(proto.companies(0).name(), "Found");
+    ASSERT_EQ(proto.missing_uids_size(), 1);
+    EXPECT_EQ(proto.missing_uids(0), "u-2");
+}
+
+TEST(CompanyServiceImplTest, ToCountAccuracy_ProtoAndJson)
+{
+    EXPECT_EQ(CompanyServiceImpl::toCountAccuracy(COUNT_EXACT), ::CountAccuracy::Exact);
+    EXPECT_EQ(CompanyServiceImpl::toCountAccuracy(COUNT_ESTIMATE), ::CountAccuracy::Estimate);
+
+    JsonParameters params;
+    params.set_jsonparams(R"({"COUNT_ACCURACY":"ESTIMATE"})");
+    EXPECT_EQ(CompanyServiceImpl::toCountAccuracy(params), ::CountAccuracy::Estimate);
+
+    params.set_jsonparams("");
+    EXPECT_EQ(CompanyServiceImpl::toCountAccuracy(params), ::CountAccuracy::Exact);
+}
@@ -94,6 +94,53 @@ TEST(MockCompanyRepositoryTest, CountWithFilter_ReturnsCorrectCount)
     EXPECT_EQ(repo.count(filter), 1);
 }
 
+// ============================================================================
+// CompanyRepository applet selection
+// ============================================================================
+
+TEST(CompanyRepositoryAppletTest, SearchModes_PickTrigramAppletsOnPostgres)
+{
+    CompanyFilter filter;
+    filter.value = "acme";
+
+    EXPECT_STREQ(CompanyRepository::selectApplet(filter, SA_PostgreSQL_Client), "company_select.sql");
+    EXPECT_STREQ(CompanyRepository::estimateApplet(filter, SA_PostgreSQL_Client), "company_count_estimate.sql");
+
+    filter.mode = CompanySearchMode::Trigram;
+    EXPECT_STREQ(CompanyRepository::selectApplet(filter, SA_PostgreSQL_Client), "company_search.sql");
+    EXPECT_STREQ(CompanyRepository::countApplet(filter, SA_PostgreSQL_Client), "company_search_count.sql");
+    EXPECT_STREQ(CompanyRepository::estimateApplet(filter, SA_PostgreSQL_Client), "company_search_count_estimate.sql");
+
+    filter.mode = CompanySearchMode::Similar;
+    EXPECT_STREQ(CompanyRepository::selectApplet(filter, SA_PostgreSQL_Client), "company_similar.sql");
+    EXPECT_STREQ(CompanyRepository::countApplet(filter, SA_PostgreSQL_Client), "company_similar_count.sql");
+    EXPECT_STREQ(CompanyRepository::estimateApplet(filter, SA_PostgreSQL_Client), "company_similar_count_estimate.sql");
+}
+
+TEST(CompanyRepositoryAppletTest, LockRow_NoOpUpdateOnlyOnSQLite)
+{
+    EXPECT_STREQ(CompanyRepository::lockApplet(SA_PostgreSQL_Client), "company_lock_row.sql");
+    EXPECT_STREQ(CompanyRepository::lockApplet(SA_SQLite_Client), "company_lock_row_sqlite.sql");
+}
+
+TEST(CompanyRepositoryAppletTest, SearchModes_FallBackToLikeOnSQLite)
+{
+    CompanyFilter filter;
+    filter.value = "acme";
+    filter.mode = CompanySearchMode::Trigram;
+    EXPECT_STREQ(CompanyRepository::selectApplet(filter, SA_SQLite_Client), "company_select.sql");
+
+    filter.mode = CompanySearchMode::Similar;
+    EXPECT_STREQ(CompanyRepository::countApplet(filter, SA_SQLite_Client), "company_count.sql");
+}
+
+TEST(CompanyRepositoryAppletTest, SimilarWithEmptyTerm_ListsLikeTrigram)
+{
+    CompanyFilter filter;
+    filter.mode = CompanySearchMode::Similar;
+    EXPECT_STREQ(CompanyRepository::selectApplet(filter, SA_PostgreSQL_Client), "company_search.sql");
+}
+
 // ============================================================================
 // CompanyService tests (with mock repository)
 // ============================================================================
@@ -186,3 +233,173 @@ TEST_F(CompanyServiceTest, CountCompanies_DelegatesToRepository)
     filter.value = "CountMe";
     EXPECT_EQ(m_service->countCompanies(filter), 3);
 }
+
+TEST_F(CompanyServiceTest, GetCompaniesByUids_KeepsRequestOrderAndReportsMisses)
+{
+    for (const char* uid : {"a", "b", "c"}) {
+        CompanyData d;
+        d.uid = uid;
+        d.name = std::string("Company ") + uid;
+        m_mock->addPreExisting(d);
+    }
+
+    CompanyLookupData lookup = m_service->getCompaniesByUids({"c", "x", "a", "c", "y"});
+
+    ASSERT_EQ(lookup.rows.size(), 2u);
+    EXPECT_EQ(lookup.rows[0].uid, "c");
+    EXPECT_EQ(lookup.rows[1].uid, "a");
+    EXPECT_EQ(lookup.missing_uids, (std::vector<std::string>{"x", "y"}));
+    EXPECT_EQ(m_mock->findByUidsCalls(), 1) << "one set-based query, not one per UID";
+}
+
+TEST_F(CompanyServiceTest, GetCompaniesByUids_EmptyRequestSkipsRepository)
+{
+    CompanyLookupData lookup = m_service->getCompaniesByUids({});
+    EXPECT_TRUE(lookup.rows.empty());
+    EXPECT_TRUE(lookup.missing_uids.empty());
+    EXPECT_EQ(m_mock->findByUidsCalls(), 0);
+}
+
+TEST_F(CompanyServiceTest, QueryCompanyPage_ReturnsRowsAndTotal)
+{
+    for (int i = 0; i < 5; ++i) {
+        CompanyData d;
+        d.name = "PageMe";
+        m_mock->addPreExisting(d);
+    }
+
+    CompanyFilter filter;
+    filter.value = "PageMe";
+    filter.limit = 2;
+    CompanyPageData page = m_service->queryCompanyPage(filter);
+
+    EXPECT_EQ(page.rows.size(), 2u);
+    EXPECT_EQ(page.total, 5);
+}
+
+TEST(CompanyServicePageTest, QueryCompanyPage_RefreshesCountCache)
+{
+    auto mock = std::make_unique<MockCompanyRepository>();
+    MockCompanyRepository* repo = mock.get();
+    CompanyServiceOptions options;
+    options.countCacheThreshold = 1;
+    CompanyService service(std::move(mock), options);
+
+    CompanyData d;
+    d.name = "Cached";
+    repo->addPreExisting(d);
+
+    CompanyFilter filter;
+    filter.value = "Cached";
+    EXPECT_EQ(service.queryCompanyPage(filter).total, 1);
+
+    // Plain count requests reuse the total without another COUNT(*)
+    const int calls = repo->countCalls();
+    EXPECT_EQ(service.countCompanies(filter), 1);
+    EXPECT_EQ(repo->countCalls(), calls);
+}
+
+TEST_F(CompanyServiceTest, SyncCompanies_ReturnsChangesAndTombstonesInVersionOrder)
+{
+    CompanyData a; a.name = "A"; a.server_uid = 7;
+    CompanyData b; b.name = "B"; b.server_uid = 7;
+    CompanyData other; other.name = "Other"; other.server_uid = 8;
+    a = m_service->addCompany(a);
+    b = m_service->addCompany(b);
+    m_service->addCompany(other);
+    m_service->deleteCompany(a.uid);
+
+    CompanyDelta delta = m_service->syncCompanies(7, 0, 100);
+
+    ASSERT_EQ(delta.changed.size(), 1u);
+    EXPECT_EQ(delta.changed[0].uid, b.uid);
+    ASSERT_EQ(delta.deleted_uids.size(), 1u);
+    EXPECT_EQ(delta.deleted_uids[0], a.uid);
+    EXPECT_FALSE(delta.has_more);
+    EXPECT_GT(delta.version, b.row_version);
+}
+
+TEST_F(CompanyServiceTest, SyncCompanies_ResumesFromVersionInBatches)
+{
+    for (int i = 0; i < 5; ++i) {
+        CompanyData d;
+        d.name = "Batch";
+        d.server_uid = 3;
+        m_service->addCompany(d);
+    }
+
+    CompanyDelta first = m_service->syncCompanies(3, 0, 3);
+    ASSERT_EQ(first.changed.size(), 3u);
+    EXPECT_TRUE(first.has_more);
+
+    CompanyDelta second = m_service->syncCompanies(3, first.version, 3);
+    EXPECT_EQ(second.changed.size(), 2u);
+    EXPECT_FALSE(second.has_more);
+
+    // Nothing new: version stays put so the client can poll with it
+    CompanyDelta idle = m_service->syncCompanies(3, second.version, 3);
+    EXPECT_TRUE(idle.changed.empty());
+    EXPECT_EQ(idle.version, second.version);
+}
+
+TEST_F(CompanyServiceTest, SyncCompanies_MoveReportsRowAsDeletedToOldTenant)
+{
+    CompanyData d; d.name = "Mover"; d.server_uid = 4;
+    d = m_service->addCompany(d);
+    const int64_t seen = m_service->syncCompanies(4, 0, 100).version;
+
+    d.server_uid = 5;
+    m_service->editCompany(d);
+
+    CompanyDelta oldTenant = m_service->syncCompanies(4, seen, 100);
+    EXPECT_TRUE(oldTenant.changed.empty());
+    ASSERT_EQ(oldTenant.deleted_uids.size(), 1u);
+    EXPECT_EQ(oldTenant.deleted_uids[0], d.uid);
+
+    CompanyDelta newTenant = m_service->syncCompanies(5, 0, 100);
+    ASSERT_EQ(newTenant.changed.size(), 1u);
+    EXPECT_EQ(newTenant.changed[0].uid, d.uid);
+}
+
+TEST_F(CompanyServiceTest, EditCompany_MovePublishesDeleteToOldTenant)
+{
+    CompanyData d; d.name = "Mover"; d.server_uid = 7;
+    d = m_service->addCompany(d);
+    const uint64_t seen = m_service->changeFeed()->lastSequence();
+
+    d.server_uid = 8;
+    m_service->editCompany(d);
+
+    auto oldTenant = m_service->changeFeed()->waitForChanges(7, seen, std::chrono::milliseconds(0));
+    ASSERT_EQ(oldTenant.events.size(), 1u);
+    EXPECT_EQ(oldTenant.events[0].op, ChangeOperation::Delete);
+    EXPECT_EQ(oldTenant.events[0].uid, d.uid);
+
+    auto newTenant = m_service->changeFeed()->waitForChanges(8, seen, std::chrono::milliseconds(0));
+    ASSERT_EQ(newTenant.events.size(), 1u);
+    EXPECT_EQ(newTenant.events[0].op, ChangeOperation::Update);
+    EXPECT_EQ(newTenant.events[0].uid, d.uid);
+}
+
+TEST_F(CompanyServiceTest, SyncCompanies_ResetsClientsBehindPrunedTombstones)
+{
+    CompanyData a; a.name = "A"; a.server_uid = 6;
+    CompanyData b; b.name = "B"; b.server_uid = 6;
+    a = m_service->addCompany(a);
+    b = m_service->addCompany(b);
+    m_service->deleteCompany(a.uid);
+    m_mock->pruneTombstones(std::chrono::seconds(0));
+
+    // A client that had seen only the first insert missed the delete
+    CompanyDelta stale = m_service->syncCompanies(6, a.row_version, 100);
+    EXPECT_TRUE(stale.reset);
+    EXPECT_TRUE(stale.changed.empty());
+
+    // Paging on through a fresh snapshot is not a reset
+    CompanyDelta first = m_service->syncCompanies(6, 0, 1);
+    ASSERT_EQ(first.changed.size(), 1u);
+    EXPECT_FALSE(first.reset);
+    CompanyDelta next = m_service->syncCompanies(6, first.version, 1, /*snapshot=*/true);
+    EXPECT_FALSE(next.reset);
+    EXPECT_TRUE(m_service->syncCompanies(6, first.version, 1).reset);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file CompanyShardRouterTests.cpp
+ * @brief Tests for SERVER_UID → shard routing
+ *
+ * Verifies:
+ * - parseShardMap() defaults and validation
+ * - Range shards win over hash shards; hash shards split the rest
+ * - Every shard gets its own pools (checked with SQLite files)
+ * - CompanyService::gather() in testing mode
+ */
+#include "company/company_service.h"
+#include "company/company_shard_router.h"
+#include "company_repository_mock.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+namespace fs = std::filesystem;
+
+namespace {
+
+CompanyShardSpec makeShard(const char* name, std::optional<int> from = {}, std::optional<int> to = {})
+{
+    CompanyShardSpec spec;
+    spec.name = name;
+    spec.from = from;
+    spec.to = to;
+    spec.host = std::string(name) + "@medicon";
+    spec.user = "user";
+    spec.pass = "pass";
+    return spec;
+}
+
+CompanyShardRouter makeRouter(const std::vector<CompanyShardSpec>& specs)
+{
+    return CompanyShardRouter(specs, 1, 1s, 1s);
+}
+
+} // namespace
+
+// ============================================================================
+// provider.json
+// ============================================================================
+
+TEST(CompanyShardRouterTest, ParseShardMap_AppliesDefaults)
+{
+    auto specs = CompanyShardRouter::parseShardMap(R"([
+        { "name": "low", "from": 1, "to": 999, "host": "db1@medicon", "replicas": ["db1r@medicon"] },
+        { "host": "db2@medicon", "user": "other", "client": "sqlite" }
+    ])", "admin", "secret");
+
+    ASSERT_EQ(specs.size(), 2u);
+    EXPECT_EQ(specs[0].name, "low");
+    EXPECT_EQ(specs[0].from, 1);
+    EXPECT_EQ(specs[0].to, 999);
+    EXPECT_EQ(specs[0].user, "admin");
+    EXPECT_EQ(specs[0].pass, "secret");
+    ASSERT_EQ(specs[0].replicas.size(), 1u);
+    EXPECT_EQ(specs[0].client, "postgresql");
+
+    EXPECT_EQ(specs[1].name, "shard1");
+    EXPECT_FALSE(specs[1].from.has_value());
+    EXPECT_EQ(specs[1].user, "other");
+    EXPECT_EQ(specs[1].client, "sqlite");
+
+    // Background jobs open their own connection with the shard's client
+    EXPECT_EQ(CompanyShardRouter::clientOf(specs[0]), SA_PostgreSQL_Client);
+    EXPECT_EQ(CompanyShardRouter::clientOf(specs[1]), SA_SQLite_Client);
+}
+
+TEST(CompanyShardRouterTest, ParseReplicas_TakesArrayOfHosts)
+{
+    EXPECT_EQ(CompanyShardRouter::parseReplicas(R"(["r1@medicon", "r2@medicon"])"),
+              (std::vector<std::string>{"r1@medicon", "r2@medicon"}));
+    EXPECT_TRUE(CompanyShardRouter::parseReplicas("[]").empty());
+
+    // ConfigFile hands string values over unquoted
+    EXPECT_THROW(CompanyShardRouter::parseReplicas("r1@medicon,r2@medicon"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseReplicas(R"("r1@medicon")"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseReplicas(R"(["r1@medicon", ""])"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseReplicas("[1]"), std::invalid_argument);
+}
+
+TEST(CompanyShardRouterTest, ParseShardMap_RejectsInvalidMaps)
+{
+    EXPECT_THROW(CompanyShardRouter::parseShardMap("{}", "u", "p"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseShardMap("[]", "u", "p"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseShardMap("[{}]", "u", "p"), std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseShardMap(R"([{"host": "a", "from": 1}])", "u", "p"),
+                 std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseShardMap(R"([{"host": "a", "client": "mysql"}])", "u", "p"),
+                 std::invalid_argument);
+    EXPECT_THROW(CompanyShardRouter::parseShardMap(R"([
+        {"host": "a", "from": 1, "to": 100},
+        {"host": "b", "from": 100, "to": 200}
+    ])", "u", "p"), std::invalid_argument);
+}
+
+// ============================================================================
+// Routing
+// ============================================================================
+
+TEST(CompanyShardRouterTest, Ranges_RouteByServerUid)
+{
+    CompanyShardRouter router = makeRouter({makeShard("a", 1, 100), makeShard("b", 101, 200)});
+
+    EXPECT_EQ(router.shardOf(1), 0u);
+    EXPECT_EQ(router.shardOf(100), 0u);
+    EXPECT_EQ(router.shardOf(101), 1u);
+    EXPECT_EQ(&router.route(150), &router.shard(1));
+    EXPECT_THROW(router.shardOf(201), std::out_of_range);
+}
+
+TEST(CompanyShardRouterTest, HashShards_TakeTenantsOutsideRanges)
+{
+    CompanyShardRouter router = makeRouter({makeShard("h0"), makeShard("vip", 500, 500), makeShard("h1")});
+
+    EXPECT_EQ(router.shardOf(500), 1u);
+    EXPECT_EQ(router.shardOf(10), 0u);  // 10 mod 2 → first hash shard
+    EXPECT_EQ(router.shardOf(11), 2u);
+    EXPECT_NE(router.shardOf(-3), 1u);
+}
+
+TEST(CompanyShardRouterTest, EachShardHasItsOwnPools)
+{
+    const fs::path dir = fs::temp_directory_path() / "medicon_shard_router_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    CompanyShardSpec low = makeShard("low", 1, 100);
+    CompanyShardSpec high = makeShard("high", 101, 200);
+    low.client = high.client = "sqlite";
+    low.host = (dir / "low.db").string();
+    high.host = (dir / "high.db").string();
+    {
+        CompanyShardRouter router = makeRouter({low, high});
+
+        {
+            auto conn = router.route(42).primary().acquire();
+            SACommand(conn->connectionSa(), _TSA("CREATE TABLE marker(shard TEXT)")).Execute();
+        }
+
+        auto other = router.route(142).primary().acquire();
+        SACommand probe(other->connectionSa(),
+                        _TSA("SELECT COUNT(*) FROM sqlite_master WHERE name = 'marker'"));
+        probe.Execute();
+        ASSERT_TRUE(probe.FetchNext());
+        EXPECT_EQ(probe.Field(1).asLong(), 0) << "table created on shard 'low' must not exist on 'high'";
+        EXPECT_NE(&router.route(42).primary(), &router.route(142).primary());
+    }
+    fs::remove_all(dir);
+}
+
+// ============================================================================
+// Scatter-gather
+// ============================================================================
+
+TEST(CompanyShardRouterTest, Gather_TestingModeRunsOnce)
+{
+    CompanyService service(std::make_unique<MockCompanyRepository>());
+    EXPECT_EQ(service.shards(), nullptr);
+
+    auto results = service.gather([](CompanyRepository& repo) {
+        CompanyFilter filter;
+        filter.server_uid = 1;
+        return repo.query(filter).size();
+    });
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], 0u);
+}
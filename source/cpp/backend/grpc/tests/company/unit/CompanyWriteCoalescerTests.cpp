@@ -0,0 +1,245 @@
+/**
+ * @file CompanyWriteCoalescerTests.cpp
+ * @brief Tests for group commit of concurrent writes
+ *
+ * Verifies:
+ * - Concurrent submits share transactions and each caller gets its result
+ * - A failing job is isolated; the rest of its batch still commits
+ * - A batch that failed before COMMIT retries every job alone
+ * - A failed commit (outcome unknown) is reported to every caller, not rerun
+ * - With an isolator (savepoints) a failing job does not cost extra transactions
+ * - An error the isolator rethrows fails the whole batch
+ * - CompanyService::addCompany() through the coalescer
+ *
+ * No database needed — the executor simulates a transaction.
+ */
+#include "company/company_service.h"
+#include "company/company_write_coalescer.h"
+#include "company_repository_mock.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+/// Executor that stages job effects and keeps them only if the body succeeds
+struct FakeTransactions {
+    MockCompanyRepository repo;
+    std::vector<int> staged;
+    std::vector<int> committed;
+    bool failNextBegin = false;
+    bool failNextCommit = false;
+
+    CompanyWriteCoalescer::Executor executor()
+    {
+        return [this](const CompanyWriteCoalescer::Job& body) {
+            if (failNextBegin) {
+                failNextBegin = false;
+                throw std::runtime_error("no connection");
+            }
+            staged.clear();
+            body(repo);
+            if (failNextCommit) {
+                failNextCommit = false;
+                throw std::runtime_error("commit failed");
+            }
+            committed.insert(committed.end(), staged.begin(), staged.end());
+        };
+    }
+};
+
+/// Submit ids from separate threads; ids listed in @p failing throw
+std::vector<std::exception_ptr> submitConcurrently(CompanyWriteCoalescer& coalescer,
+                                                   FakeTransactions& tx, int count,
+                                                   const std::set<int>& failing = {})
+{
+    std::vector<std::exception_ptr> errors(count);
+    std::vector<std::thread> threads;
+    for (int id = 0; id < count; ++id) {
+        threads.emplace_back([&, id] {
+            try {
+                coalescer.submit([&, id](CompanyRepository&) {
+                    if (failing.contains(id)) {
+                        throw std::runtime_error("job failed");
+                    }
+                    tx.staged.push_back(id);
+                });
+            } catch (...) {
+                errors[id] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return errors;
+}
+
+} // namespace
+
+TEST(CompanyWriteCoalescerTest, ConcurrentSubmits_ShareTransactions)
+{
+    FakeTransactions tx;
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 8);
+
+    auto errors = submitConcurrently(coalescer, tx, 8);
+
+    for (const auto& error : errors) {
+        EXPECT_FALSE(error);
+    }
+    EXPECT_EQ(coalescer.jobs(), 8u);
+    EXPECT_LT(coalescer.transactions(), 8u);
+    std::sort(tx.committed.begin(), tx.committed.end());
+    EXPECT_EQ(tx.committed, (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST(CompanyWriteCoalescerTest, SingleSubmit_RunsAfterWindow)
+{
+    FakeTransactions tx;
+    CompanyWriteCoalescer coalescer(tx.executor(), 1ms, 8);
+
+    coalescer.submit([&](CompanyRepository&) { tx.staged.push_back(42); });
+
+    EXPECT_EQ(tx.committed, std::vector<int>{42});
+    EXPECT_EQ(coalescer.transactions(), 1u);
+}
+
+TEST(CompanyWriteCoalescerTest, FailingJob_IsIsolated)
+{
+    FakeTransactions tx;
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 4);
+
+    auto errors = submitConcurrently(coalescer, tx, 4, {2});
+
+    EXPECT_TRUE(errors[2]);
+    EXPECT_FALSE(errors[0]);
+    EXPECT_FALSE(errors[1]);
+    EXPECT_FALSE(errors[3]);
+    std::sort(tx.committed.begin(), tx.committed.end());
+    EXPECT_EQ(tx.committed, (std::vector<int>{0, 1, 3}));
+    EXPECT_EQ(coalescer.jobs(), 4u);
+}
+
+TEST(CompanyWriteCoalescerTest, FailedBegin_RetriesEachJobAlone)
+{
+    FakeTransactions tx;
+    tx.failNextBegin = true;
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 3);
+
+    auto errors = submitConcurrently(coalescer, tx, 3);
+
+    for (const auto& error : errors) {
+        EXPECT_FALSE(error);
+    }
+    std::sort(tx.committed.begin(), tx.committed.end());
+    EXPECT_EQ(tx.committed, (std::vector<int>{0, 1, 2}));
+}
+
+TEST(CompanyWriteCoalescerTest, FailedCommit_ReportsErrorToEveryCaller)
+{
+    FakeTransactions tx;
+    tx.failNextCommit = true;
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 3);
+
+    auto errors = submitConcurrently(coalescer, tx, 3);
+
+    // The commit may have gone through: running the jobs again could duplicate them
+    for (const auto& error : errors) {
+        ASSERT_TRUE(error);
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::runtime_error& e) {
+            EXPECT_STREQ(e.what(), "commit failed");
+        }
+    }
+    EXPECT_EQ(coalescer.jobs(), 3u);
+    EXPECT_EQ(coalescer.transactions(), 1u);
+}
+
+TEST(CompanyWriteCoalescerTest, Isolator_UndoesOnlyFailingJob)
+{
+    FakeTransactions tx;
+    // Savepoint stand-in: drop what the failing job staged
+    auto isolator = [&tx](CompanyRepository& repo, const CompanyWriteCoalescer::Job& job) {
+        const size_t mark = tx.staged.size();
+        try {
+            job(repo);
+        } catch (...) {
+            tx.staged.resize(mark);
+            return std::current_exception();
+        }
+        return std::exception_ptr();
+    };
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 4, isolator);
+
+    auto errors = submitConcurrently(coalescer, tx, 4, {1});
+
+    EXPECT_TRUE(errors[1]);
+    EXPECT_FALSE(errors[0]);
+    EXPECT_FALSE(errors[2]);
+    EXPECT_FALSE(errors[3]);
+    std::sort(tx.committed.begin(), tx.committed.end());
+    EXPECT_EQ(tx.committed, (std::vector<int>{0, 2, 3}));
+    EXPECT_EQ(coalescer.transactions(), 1u);
+}
+
+TEST(CompanyWriteCoalescerTest, Isolator_RethrownErrorFailsWholeBatch)
+{
+    FakeTransactions tx;
+    // Stand-in for a serialization failure: the isolator rethrows it once
+    bool transient = true;
+    auto isolator = [&](CompanyRepository& repo, const CompanyWriteCoalescer::Job& job) {
+        if (std::exchange(transient, false)) {
+            throw std::runtime_error("could not serialize access");
+        }
+        job(repo);
+        return std::exception_ptr();
+    };
+    CompanyWriteCoalescer coalescer(tx.executor(), 200ms, 3, isolator);
+
+    auto errors = submitConcurrently(coalescer, tx, 3);
+
+    // Not recorded as job 0's failure: the batch rolled back and every job ran again
+    for (const auto& error : errors) {
+        EXPECT_FALSE(error);
+    }
+    std::sort(tx.committed.begin(), tx.committed.end());
+    EXPECT_EQ(tx.committed, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(coalescer.transactions(), 4u);
+}
+
+TEST(CompanyWriteCoalescerTest, Service_AddCompanyThroughCoalescer)
+{
+    CompanyServiceOptions options;
+    options.coalesceWrites = true;
+    options.coalesceWindow = 50ms;
+    options.coalesceMaxBatch = 4;
+    CompanyService service(std::make_unique<MockCompanyRepository>(), options);
+
+    std::vector<std::string> uids(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            CompanyData data;
+            data.server_uid = 1;
+            data.name = "Coalesced " + std::to_string(i);
+            uids[i] = service.addCompany(data).uid;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> unique(uids.begin(), uids.end());
+    EXPECT_EQ(unique.size(), 4u);
+    EXPECT_FALSE(unique.contains(""));
+    for (const auto& uid : uids) {
+        EXPECT_TRUE(service.getCompanyByUid(uid).has_value());
+    }
+}
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "company/company_repository.h"
+#include <algorithm>
 #include <map>
+#include <tuple>
 #include <vector>
 
 /**
@@ -24,6 +26,7 @@ public:
         if (d.uid.empty()) {
             d.uid = "pre-" + std::to_string(m_nextPreId++);
         }
+        d.row_version = ++m_version;
         m_storage[d.uid] = d;
     }
 
@@ -32,6 +35,12 @@ public:
     int addCount() const { return m_addCount; }
     int updateCount() const { return m_updateCount; }
     int removeCount() const { return m_removeCount; }
+    int countCalls() const { return m_countCalls; }
+    int rowCountCalls() const { return m_rowCountCalls; }
+    int findByUidsCalls() const { return m_findByUidsCalls; }
+
+    /// Value returned by estimateCount(); std::nullopt = no estimate (SQLite)
+    void setEstimate(std::optional<int64_t> estimate) { m_estimate = estimate; }
 
     // Overrides
     CompanyData add(const CompanyData& data) override
@@ -41,15 +50,28 @@ public:
         if (result.uid.empty()) {
             result.uid = "mock-uid-" + std::to_string(m_addCount);
         }
+        result.row_version = ++m_version;
         m_storage[result.uid] = result;
         return result;
     }
 
-    CompanyData update(const CompanyData& data) override
+    UpdateResult update(const CompanyData& data) override
     {
         ++m_updateCount;
-        m_storage[data.uid] = data;
-        return data;
+        UpdateResult result;
+        result.row = data;
+        result.row.row_version = ++m_version;
+        result.old_server_uid = data.server_uid;
+        auto it = m_storage.find(data.uid);
+        if (it != m_storage.end()) {
+            result.old_server_uid = it->second.server_uid;
+        }
+        if (result.moved()) {
+            // Moved: the old tenant sees it as deleted
+            m_tombstones.push_back({++m_version, result.old_server_uid, data.uid});
+        }
+        m_storage[data.uid] = result.row;
+        return result;
     }
 
     DeleteResult remove(std::string_view uid) override
@@ -59,7 +81,9 @@ public:
         auto it = m_storage.find(std::string(uid));
         if (it != m_storage.end()) {
             result.uid = it->second.uid;
+            result.server_uid = it->second.server_uid;
             result.success = true;
+            m_tombstones.push_back({++m_version, it->second.server_uid, it->second.uid});
             m_storage.erase(it);
         } else {
             result.success = false;
@@ -98,8 +122,21 @@ public:
         return std::nullopt;
     }
 
+    std::vector<CompanyData> findByUids(const std::vector<std::string>& uids) override
+    {
+        ++m_findByUidsCalls;
+        std::vector<CompanyData> results;
+        for (const auto& [uid, data] : m_storage) {
+            if (std::find(uids.begin(), uids.end(), uid) != uids.end()) {
+                results.push_back(data);
+            }
+        }
+        return results;
+    }
+
     int64_t count(const CompanyFilter& filter) override
     {
+        ++m_countCalls;
         int64_t cnt = 0;
         for (const auto& [uid, data] : m_storage) {
             if (filter.value.empty() ||
@@ -110,7 +147,76 @@ public:
         return cnt;
     }
 
+    int64_t rowCount(int serverUid) override
+    {
+        ++m_rowCountCalls;
+        return std::count_if(m_storage.begin(), m_storage.end(),
+                             [serverUid](const auto& item) { return item.second.server_uid == serverUid; });
+    }
+
+    std::optional<int64_t> estimateCount(const CompanyFilter&) override
+    {
+        return m_estimate;
+    }
+
+    /// Drops every tombstone regardless of @p retention (the mock has no clock)
+    int64_t pruneTombstones(std::chrono::seconds) override
+    {
+        for (const auto& tomb : m_tombstones) {
+            int64_t& pruned = m_prunedVersion[tomb.server_uid];
+            pruned = std::max(pruned, tomb.version);
+        }
+        const auto removed = static_cast<int64_t>(m_tombstones.size());
+        m_tombstones.clear();
+        return removed;
+    }
+
+    CompanyDelta sync(int serverUid, int64_t sinceVersion, int limit, bool snapshot) override
+    {
+        if (sinceVersion > 0 && !snapshot && sinceVersion < m_prunedVersion[serverUid]) {
+            CompanyDelta reset;
+            reset.reset = true;
+            return reset;
+        }
+
+        // (version, uid, isTombstone) of every change after sinceVersion
+        std::vector<std::tuple<int64_t, std::string, bool>> changes;
+        for (const auto& [uid, data] : m_storage) {
+            if (data.server_uid == serverUid && data.row_version > sinceVersion) {
+                changes.emplace_back(data.row_version, uid, false);
+            }
+        }
+        for (const auto& tomb : m_tombstones) {
+            if (tomb.server_uid == serverUid && tomb.version > sinceVersion) {
+                changes.emplace_back(tomb.version, tomb.uid, true);
+            }
+        }
+        std::sort(changes.begin(), changes.end());
+
+        CompanyDelta delta;
+        delta.version = sinceVersion;
+        for (const auto& [version, uid, isTombstone] : changes) {
+            if (static_cast<int>(delta.changed.size() + delta.deleted_uids.size()) == limit) {
+                delta.has_more = true;
+                break;
+            }
+            if (isTombstone) {
+                delta.deleted_uids.push_back(uid);
+            } else {
+                delta.changed.push_back(m_storage.at(uid));
+            }
+            delta.version = version;
+        }
+        return delta;
+    }
+
 private:
+    struct Tombstone {
+        int64_t version;
+        int server_uid;
+        std::string uid;
+    };
+
     // Dummy connection (never used, overrides avoid calling it, but base ctor needs valid params)
     SqlConnection m_dummyConn = SqlConnection(
         SA_PostgreSQL_Client, "mockhost", "mockuser", "mockpass");
@@ -120,4 +226,11 @@ private:
     int m_addCount = 0;
     int m_updateCount = 0;
     int m_removeCount = 0;
+    int m_countCalls = 0;
+    int m_rowCountCalls = 0;
+    int m_findByUidsCalls = 0;
+    std::optional<int64_t> m_estimate;
+    int64_t m_version = 0;
+    std::vector<Tombstone> m_tombstones;
+    std::map<int, int64_t> m_prunedVersion;
 };
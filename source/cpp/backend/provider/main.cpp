@@ -1,8 +1,13 @@
 #include "../grpc/company/company_server.h"
 #include "include_backend_util.h"
+#include "sqlappletbundle.h"
+#include "sqlappletwatcher.h"
+#include "sqltemplatecache.h"
 #include "configfile.h"
+#include "include_util.h"
 
 #include <easylogging++.h>
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <string>
@@ -43,8 +48,23 @@ int main()
     const std::string dbPass   = requireConfig(config, "pass");
     const bool logSql          = config.boolValueOr("log_sql", false);
 
-    // Validate resource paths exist
-    if (!std::filesystem::is_directory(config.appletPath())) {
+    // Optional applet bundle: packed on first start (and again when an
+    // applet is newer), then served from one read-only mapping
+    const std::string appletBundle = config.valueOr("applet_bundle", "");
+    if (!appletBundle.empty()) {
+        try {
+            if (SqlAppletBundle::isStale(config.appletPath(), appletBundle)) {
+                SqlAppletBundle::pack(config.appletPath(), appletBundle);
+            }
+            SqlAppletBundle::install(SqlAppletBundle::open(appletBundle), config.appletPath());
+        } catch (const std::exception& x) {
+            std::cerr << "FATAL: Applet bundle unusable: " << x.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Validate resource paths exist (a bundle may replace the directory)
+    if (appletBundle.empty() && !std::filesystem::is_directory(config.appletPath())) {
         std::cerr << "FATAL: Applet directory not found: " << config.appletPath() << std::endl;
         return 1;
     }
@@ -70,13 +90,109 @@ int main()
         return 1;
     }
 
+    // Optional service tunables (see CompanyServiceOptions)
+    CompanyServiceOptions options;
+    options.listenNotify = config.valueOr("change_feed", "inprocess") == "notify";
+    options.rowCounters = config.boolValueOr("row_counters", false);
+    options.coalesceWrites = config.boolValueOr("write_coalescing", false);
+    options.warmStatements = config.boolValueOr("warmup_statements", false);
+    const char* optionKey = "watch_heartbeat_sec";
+    try {
+        options.watchHeartbeat = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "15")));
+        optionKey = "count_cache_ttl_sec";
+        options.countCacheTtl = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "10")));
+        optionKey = "count_cache_threshold";
+        options.countCacheThreshold = std::stoll(config.valueOr(optionKey, "10000"));
+        optionKey = "row_counter_reconcile_sec";
+        options.rowCounterReconcile = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "3600")));
+        optionKey = "tombstone_retention_days";
+        options.tombstoneRetention = std::chrono::days(
+            std::stoi(config.valueOr(optionKey, "30")));
+        optionKey = "tombstone_prune_sec";
+        options.tombstonePrune = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "3600")));
+        optionKey = "write_coalesce_window_us";
+        options.coalesceWindow = std::chrono::microseconds(
+            std::stoi(config.valueOr(optionKey, "2000")));
+        optionKey = "write_coalesce_max";
+        options.coalesceMaxBatch = static_cast<size_t>(
+            std::max(1, std::stoi(config.valueOr(optionKey, "32"))));
+        optionKey = "retry_attempts";
+        options.retry.maxAttempts = std::max(1, std::stoi(config.valueOr(optionKey, "3")));
+        optionKey = "retry_base_ms";
+        options.retry.baseDelay = std::chrono::milliseconds(
+            std::stoi(config.valueOr(optionKey, "20")));
+        optionKey = "retry_max_ms";
+        options.retry.maxDelay = std::chrono::milliseconds(
+            std::stoi(config.valueOr(optionKey, "500")));
+        optionKey = "pool_size";
+        options.poolSize = static_cast<size_t>(
+            std::max(1, std::stoi(config.valueOr(optionKey, "4"))));
+        optionKey = "pool_min";
+        options.poolMin = std::min(options.poolSize, static_cast<size_t>(
+            std::max(0, std::stoi(config.valueOr(optionKey, "1")))));
+        optionKey = "read_your_writes_ms";
+        options.readYourWrites = std::chrono::milliseconds(
+            std::stoi(config.valueOr(optionKey, "2000")));
+        optionKey = "replica_retry_sec";
+        options.replicaRetry = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "5")));
+        optionKey = "pool_check_sec";
+        options.poolCheck = std::chrono::seconds(
+            std::stoi(config.valueOr(optionKey, "30")));
+        optionKey = "tcp_keepalive_idle_sec";
+        options.keepaliveIdle = std::stoi(config.valueOr(optionKey, "60"));
+        optionKey = "tcp_keepalive_interval_sec";
+        options.keepaliveInterval = std::stoi(config.valueOr(optionKey, "10"));
+        optionKey = "tcp_keepalive_count";
+        options.keepaliveProbes = std::stoi(config.valueOr(optionKey, "3"));
+    } catch (const std::exception&) {
+        std::cerr << "FATAL: Invalid '" << optionKey << "' value in config" << std::endl;
+        return 1;
+    }
+    if (config.contains("replicas")) {
+        try {
+            options.replicaHosts = CompanyShardRouter::parseReplicas(config.value("replicas"));
+        } catch (const std::exception& x) {
+            std::cerr << "FATAL: Invalid 'replicas' value in config: " << x.what()
+                      << " (expected e.g. [\"db-r1@medicon\"])" << std::endl;
+            return 1;
+        }
+    }
+    if (config.contains("shards")) {
+        try {
+            options.shards = CompanyShardRouter::parseShardMap(config.value("shards"), dbUser, dbPass);
+        } catch (const std::exception& x) {
+            std::cerr << "FATAL: Invalid 'shards' value in config: " << x.what() << std::endl;
+            return 1;
+        }
+    }
+
+    // Optional hot reload: applets are parsed once and kept, and re-parsed
+    // in the background when edited; a broken edit keeps the old version
+    SqlAppletWatcher appletWatcher(config.appletPath(), SqlTemplateCache::instance(),
+        [](const std::string& filePath, const std::string& error) {
+            LOG(ERROR) << "[APPLET] kept previous version of " << filePath << ": " << error;
+        });
+    if (config.boolValueOr("applet_watch", false)) {
+        SqlTemplateCache::instance().setEnabled(true);
+        if (!appletWatcher.start()) {
+            SqlTemplateCache::instance().setEnabled(false);
+            LOG(WARNING) << "[APPLET] cannot watch " << config.appletPath()
+                         << "; applets are read on every request";
+        }
+    }
+
     // ========================================================================
     // Phase 3: Start gRPC server
     // ========================================================================
 
     RunCompanyServer(port, logSql,
                      config.appletPath(),
-                     dbHost, dbUser, dbPass);
+                     dbHost, dbUser, dbPass, options);
 
     return 0;
 }
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -108,4 +110,125 @@ private:
     std::array<std::string_view, N> m_valid;
 };
 
+/**
+ * @brief Collision-free name → index table built at compile time
+ *
+ * The constructor searches a seed for which the hashes of all names land in
+ * distinct slots of a table at least twice the size of the list, so a lookup
+ * is one hash and one string comparison. Duplicate names, or no seed found,
+ * fail the constant evaluation.
+ */
+template <std::size_t N>
+class PerfectHashIndex {
+public:
+    static constexpr std::size_t SLOTS = std::bit_ceil(std::max<std::size_t>(2 * N, 1));
+
+    constexpr PerfectHashIndex(std::array<std::string_view, N> names)
+        : m_names(names)
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = i + 1; j < N; ++j) {
+                if (m_names[i] == m_names[j]) {
+                    throw std::logic_error("PerfectHashIndex: duplicate name");
+                }
+            }
+        }
+        for (uint32_t seed = 0; seed < MAX_SEED; ++seed) {
+            if (tryFill(seed)) {
+                m_seed = seed;
+                return;
+            }
+        }
+        throw std::logic_error("PerfectHashIndex: no collision-free seed");
+    }
+
+    /// Position of @p name in the constructor list, or N if absent
+    [[nodiscard]] constexpr std::size_t indexOf(std::string_view name) const noexcept
+    {
+        const std::size_t index = m_slots[hash(name, m_seed) & (SLOTS - 1)];
+        return (index < N && m_names[index] == name) ? index : N;
+    }
+
+    [[nodiscard]] constexpr std::string_view name(std::size_t index) const noexcept { return m_names[index]; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return N; }
+
+private:
+    static constexpr uint32_t MAX_SEED = 1u << 16;
+
+    /// FNV-1a with the seed folded into the offset basis
+    static constexpr uint32_t hash(std::string_view text, uint32_t seed) noexcept
+    {
+        uint32_t h = 2166136261u ^ (seed * 0x9E3779B9u);
+        for (char c : text) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    constexpr bool tryFill(uint32_t seed)
+    {
+        m_slots.fill(N);
+        for (std::size_t i = 0; i < N; ++i) {
+            std::size_t& slot = m_slots[hash(m_names[i], seed) & (SLOTS - 1)];
+            if (slot != N) {
+                return false;
+            }
+            slot = i;
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> m_names{};
+    std::array<std::size_t, SLOTS> m_slots{};
+    uint32_t m_seed = 0;
+};
+
+/**
+ * @brief Column allow-list backed by a PerfectHashIndex
+ *
+ * Same contract as ColumnAllowList; validNames() keeps declaration order.
+ * Usually derived from a table descriptor (see SchemaAllowList in
+ * table_schema.h) rather than listed by hand.
+ */
+template <std::size_t N>
+class PerfectHashAllowList : public ColumnAllowListBase {
+public:
+    constexpr PerfectHashAllowList(std::array<std::string_view, N> valid)
+        : m_index(valid)
+    {
+    }
+
+    [[nodiscard]] std::string_view resolve(std::string_view name) const override
+    {
+        const std::size_t index = m_index.indexOf(name);
+        if (index < N) {
+            return m_index.name(index);
+        }
+        throw std::invalid_argument(
+            std::string("Unknown column '") + std::string(name) +
+            "'. Valid columns: " + validNames());
+    }
+
+    [[nodiscard]] std::string validNames() const override
+    {
+        std::string result;
+        for (size_t i = 0; i < N; ++i) {
+            if (i > 0) result += ", ";
+            result += m_index.name(i);
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr bool contains(std::string_view name) const noexcept
+    {
+        return m_index.indexOf(name) < N;
+    }
+
+    [[nodiscard]] constexpr size_t size() const noexcept { return N; }
+
+private:
+    PerfectHashIndex<N> m_index;
+};
+
 #endif // COLUMN_ALLOWLIST_H
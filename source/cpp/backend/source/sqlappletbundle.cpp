@@ -0,0 +1,331 @@
+#include "sqlappletbundle.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'S', 'Q', 'L', 'A', 'B', '1', '\0'};
+constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(uint32_t);
+
+struct Registry {
+    std::mutex mutex;
+    std::shared_ptr<const SqlAppletBundle> bundle;
+    string appletPath;
+};
+
+Registry& registry()
+{
+    static Registry instance;
+    return instance;
+}
+
+vector<fs::path> appletFiles(const string& appletDir)
+{
+    vector<fs::path> files;
+    for (const auto& item : fs::directory_iterator(appletDir)) {
+        if (item.is_regular_file() && item.path().extension() == ".sql") {
+            files.push_back(item.path());
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const fs::path& a, const fs::path& b) {
+        return a.filename().string() < b.filename().string();
+    });
+    return files;
+}
+
+string readApplet(const fs::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw SqlAppletBundleException("SqlAppletBundle: Cannot read " + path.string());
+    }
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+template <typename T>
+void writeRaw(std::ofstream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+// ============================================================================
+// Packing
+// ============================================================================
+
+void SqlAppletBundle::pack(const string& appletDir, const string& bundlePath)
+{
+    vector<string> names;
+    vector<string> texts;
+    try {
+        for (const auto& path : appletFiles(appletDir)) {
+            names.push_back(path.filename().string());
+            texts.push_back(readApplet(path));
+        }
+    } catch (const fs::filesystem_error& x) {
+        throw SqlAppletBundleException(string("SqlAppletBundle: ") + x.what());
+    }
+
+    const auto count = static_cast<uint32_t>(names.size());
+    vector<Entry> entries(count);
+    size_t offset = HEADER_SIZE + count * sizeof(Entry);
+    for (uint32_t i = 0; i < count; ++i) {
+        entries[i].nameOffset = static_cast<uint32_t>(offset);
+        entries[i].nameLength = static_cast<uint32_t>(names[i].size());
+        offset += names[i].size();
+        entries[i].dataOffset = static_cast<uint32_t>(offset);
+        entries[i].dataLength = static_cast<uint32_t>(texts[i].size());
+        offset += texts[i].size();
+    }
+    if (offset > UINT32_MAX) {
+        throw SqlAppletBundleException("SqlAppletBundle: Applets exceed 4 GiB in " + appletDir);
+    }
+
+    const string tempPath = bundlePath + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            throw SqlAppletBundleException("SqlAppletBundle: Cannot write " + tempPath);
+        }
+        out.write(MAGIC, sizeof(MAGIC));
+        writeRaw(out, count);
+        writeRaw(out, uint32_t{0});
+        for (const auto& e : entries) {
+            writeRaw(out, e);
+        }
+        for (uint32_t i = 0; i < count; ++i) {
+            out << names[i] << texts[i];
+        }
+        if (!out.flush()) {
+            throw SqlAppletBundleException("SqlAppletBundle: Cannot write " + tempPath);
+        }
+    }
+
+    std::error_code error;
+    fs::rename(tempPath, bundlePath, error);
+    if (error) {
+        fs::remove(tempPath, error);
+        throw SqlAppletBundleException("SqlAppletBundle: Cannot replace " + bundlePath);
+    }
+}
+
+bool SqlAppletBundle::isStale(const string& appletDir, const string& bundlePath)
+{
+    std::error_code error;
+    if (!fs::is_regular_file(bundlePath, error)) {
+        return true;
+    }
+    if (!fs::is_directory(appletDir, error)) {
+        return false;  // bundle-only deployment
+    }
+
+    // Compare contents, not mtimes: rollbacks, rsync -a, cp -p and tar all
+    // restore older timestamps on changed files
+    try {
+        auto bundle = open(bundlePath);
+        const auto files = appletFiles(appletDir);
+        if (files.size() != bundle->m_count) {
+            return true;
+        }
+        for (uint32_t i = 0; i < bundle->m_count; ++i) {
+            const Entry e = bundle->entry(i);
+            if (bundle->nameAt(e) != files[i].filename().string() ||
+                fs::file_size(files[i]) != e.dataLength ||
+                readApplet(files[i]) != string_view(bundle->m_data + e.dataOffset, e.dataLength)) {
+                return true;
+            }
+        }
+    } catch (const SqlAppletBundleException&) {
+        return true;  // unreadable bundle or applet: repack (and report what fails there)
+    } catch (const fs::filesystem_error&) {
+        return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+std::shared_ptr<const SqlAppletBundle> SqlAppletBundle::open(const string& bundlePath)
+{
+    std::shared_ptr<SqlAppletBundle> bundle(new SqlAppletBundle());
+
+#ifdef _WIN32
+    bundle->m_file = CreateFileA(bundlePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                 nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (bundle->m_file == INVALID_HANDLE_VALUE) {
+        bundle->m_file = nullptr;
+        throw SqlAppletBundleException("SqlAppletBundle: Cannot open " + bundlePath);
+    }
+    LARGE_INTEGER size{};
+    GetFileSizeEx(bundle->m_file, &size);
+    bundle->m_size = static_cast<size_t>(size.QuadPart);
+    if (bundle->m_size > 0) {
+        bundle->m_mapping = CreateFileMappingA(bundle->m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (bundle->m_mapping) {
+            bundle->m_data = static_cast<const char*>(
+                MapViewOfFile(bundle->m_mapping, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+#else
+    const int fd = ::open(bundlePath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw SqlAppletBundleException("SqlAppletBundle: Cannot open " + bundlePath);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        bundle->m_size = static_cast<size_t>(info.st_size);
+        void* data = mmap(nullptr, bundle->m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            bundle->m_data = static_cast<const char*>(data);
+        }
+    }
+    ::close(fd);  // the mapping keeps the file alive
+#endif
+
+    if (!bundle->m_data || bundle->m_size < HEADER_SIZE ||
+        std::memcmp(bundle->m_data, MAGIC, sizeof(MAGIC)) != 0) {
+        throw SqlAppletBundleException("SqlAppletBundle: Not an applet bundle: " + bundlePath);
+    }
+    std::memcpy(&bundle->m_count, bundle->m_data + sizeof(MAGIC), sizeof(uint32_t));
+    if (bundle->m_count > (bundle->m_size - HEADER_SIZE) / sizeof(Entry)) {
+        throw SqlAppletBundleException("SqlAppletBundle: Truncated index in " + bundlePath);
+    }
+    // Validate once so lookups never read outside the mapping
+    for (uint32_t i = 0; i < bundle->m_count; ++i) {
+        const Entry e = bundle->entry(i);
+        if (uint64_t{e.nameOffset} + e.nameLength > bundle->m_size ||
+            uint64_t{e.dataOffset} + e.dataLength > bundle->m_size) {
+            throw SqlAppletBundleException("SqlAppletBundle: Corrupt entry in " + bundlePath);
+        }
+    }
+    return bundle;
+}
+
+SqlAppletBundle::~SqlAppletBundle()
+{
+#ifdef _WIN32
+    if (m_data) UnmapViewOfFile(m_data);
+    if (m_mapping) CloseHandle(m_mapping);
+    if (m_file) CloseHandle(m_file);
+#else
+    if (m_data) munmap(const_cast<char*>(m_data), m_size);
+#endif
+}
+
+// ============================================================================
+// Lookup
+// ============================================================================
+
+SqlAppletBundle::Entry SqlAppletBundle::entry(uint32_t index) const
+{
+    Entry e;
+    std::memcpy(&e, m_data + HEADER_SIZE + index * sizeof(Entry), sizeof(Entry));
+    return e;
+}
+
+string_view SqlAppletBundle::nameAt(const Entry& e) const
+{
+    return {m_data + e.nameOffset, e.nameLength};
+}
+
+std::optional<string_view> SqlAppletBundle::find(string_view name) const
+{
+    uint32_t low = 0;
+    uint32_t high = m_count;
+    while (low < high) {
+        const uint32_t mid = low + (high - low) / 2;
+        const Entry e = entry(mid);
+        const int order = nameAt(e).compare(name);
+        if (order == 0) {
+            return string_view(m_data + e.dataOffset, e.dataLength);
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return std::nullopt;
+}
+
+vector<string_view> SqlAppletBundle::names() const
+{
+    vector<string_view> result;
+    result.reserve(m_count);
+    for (uint32_t i = 0; i < m_count; ++i) {
+        result.push_back(nameAt(entry(i)));
+    }
+    return result;
+}
+
+// ============================================================================
+// Registry
+// ============================================================================
+
+void SqlAppletBundle::install(std::shared_ptr<const SqlAppletBundle> bundle, string appletPath)
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    reg.bundle = std::move(bundle);
+    reg.appletPath = std::move(appletPath);
+}
+
+void SqlAppletBundle::uninstall()
+{
+    install(nullptr, {});
+}
+
+std::shared_ptr<const SqlAppletBundle> SqlAppletBundle::installed()
+{
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    return reg.bundle;
+}
+
+std::optional<SqlAppletBundle::Resolved> SqlAppletBundle::resolve(string_view filePath)
+{
+    std::shared_ptr<const SqlAppletBundle> bundle;
+    string_view name;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        if (!reg.bundle || reg.appletPath.empty() || !filePath.starts_with(reg.appletPath)) {
+            return std::nullopt;
+        }
+        bundle = reg.bundle;
+        name = filePath.substr(reg.appletPath.size());
+    }
+    if (auto text = bundle->find(name)) {
+        return Resolved{std::move(bundle), *text};
+    }
+    return std::nullopt;
+}
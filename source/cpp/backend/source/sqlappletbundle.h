@@ -0,0 +1,139 @@
+/**
+ * @file sqlappletbundle.h
+ * @brief Read-only, memory-mapped archive of .sql applets
+ *
+ * A bundle packs every applet of a directory into one indexed file, so a
+ * deployment ships (and the provider opens) a single file instead of one
+ * per statement. Once installed, SqlTemplate resolves applet paths under
+ * the installed applet directory from the bundle and only falls back to
+ * the filesystem for names the bundle does not contain.
+ *
+ * Layout (native byte order; bundles are not meant to move between
+ * architectures):
+ * @code
+ * char     magic[8]        "MSQLAB1\0"
+ * uint32_t count
+ * uint32_t reserved
+ * Entry    entries[count]  sorted by name
+ * ...      names and applet texts, referenced by offset from file start
+ * @endcode
+ */
+
+#ifndef SQLAPPLETBUNDLE_H
+#define SQLAPPLETBUNDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Exception for unreadable or malformed bundles
+ */
+class SqlAppletBundleException : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/**
+ * @class SqlAppletBundle
+ * @brief Memory-mapped applet archive with binary-search lookup by name
+ *
+ * Lookups return views into the mapping; they stay valid as long as the
+ * bundle (a shared_ptr) is alive.
+ */
+class SqlAppletBundle
+{
+public:
+    ~SqlAppletBundle();
+
+    SqlAppletBundle(const SqlAppletBundle&) = delete;
+    SqlAppletBundle& operator=(const SqlAppletBundle&) = delete;
+
+    /**
+     * @brief Pack every *.sql file of @p appletDir into @p bundlePath
+     *
+     * Writes a temporary file next to @p bundlePath and renames it into
+     * place, so a concurrent open() sees the old bundle or the new one.
+     * @throws SqlAppletBundleException if a file cannot be read or written
+     */
+    static void pack(const std::string& appletDir, const std::string& bundlePath);
+
+    /**
+     * @brief True unless @p bundlePath holds exactly the *.sql files of @p appletDir
+     *
+     * Compares names and contents, so an applet restored with an older
+     * modification time still triggers a repack. False when @p appletDir
+     * does not exist (the bundle is all that was deployed).
+     */
+    static bool isStale(const std::string& appletDir, const std::string& bundlePath);
+
+    /**
+     * @brief Map @p bundlePath read-only and validate its index
+     * @throws SqlAppletBundleException if the file is missing or malformed
+     */
+    static std::shared_ptr<const SqlAppletBundle> open(const std::string& bundlePath);
+
+    /// Text of applet @p name (e.g. "company_select.sql"), if bundled
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view name) const;
+
+    /// Applet names in index order
+    [[nodiscard]] std::vector<std::string_view> names() const;
+
+    [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+    // ------------------------------------------------------------------------
+    // Process-wide registry used by SqlTemplate
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief Serve applets under @p appletPath from @p bundle
+     *
+     * A SqlTemplate whose path starts with @p appletPath looks the rest of
+     * the path up in @p bundle. Replaces any previously installed bundle;
+     * templates already parsed keep their text.
+     */
+    static void install(std::shared_ptr<const SqlAppletBundle> bundle, std::string appletPath);
+
+    static void uninstall();
+
+    /// Installed bundle, or nullptr
+    static std::shared_ptr<const SqlAppletBundle> installed();
+
+    /// A bundled applet text together with the bundle that owns it
+    struct Resolved {
+        std::shared_ptr<const SqlAppletBundle> bundle;
+        std::string_view text;
+    };
+
+    /// Bundled text for @p filePath, or nullopt to read the file instead
+    static std::optional<Resolved> resolve(std::string_view filePath);
+
+private:
+    struct Entry {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t dataOffset;
+        uint32_t dataLength;
+    };
+
+    SqlAppletBundle() = default;
+
+    Entry entry(uint32_t index) const;
+    std::string_view nameAt(const Entry& e) const;
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+    uint32_t m_count = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+#endif // SQLAPPLETBUNDLE_H
@@ -0,0 +1,116 @@
+#include "sqlappletwatcher.h"
+#include "sqltemplatecache.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using std::string_view;
+
+namespace {
+/// How often the thread checks for stop() while no event arrives
+constexpr int POLL_TIMEOUT_MS = 200;
+}
+
+SqlAppletWatcher::SqlAppletWatcher(string_view appletPath, SqlTemplateCache& cache,
+                                   ErrorHandler onError)
+    : m_appletPath(appletPath)
+    , m_cache(cache)
+    , m_onError(std::move(onError))
+{
+    if (!m_appletPath.empty() && m_appletPath.back() != '/' && m_appletPath.back() != '\\') {
+        m_appletPath += '/';
+    }
+}
+
+SqlAppletWatcher::~SqlAppletWatcher()
+{
+    stop();
+}
+
+// ============================================================================
+// Start / stop
+// ============================================================================
+
+bool SqlAppletWatcher::start()
+{
+#ifdef __linux__
+    if (m_thread.joinable()) {
+        return true;
+    }
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        return false;
+    }
+    if (inotify_add_watch(m_inotifyFd, m_appletPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return false;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&SqlAppletWatcher::run, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void SqlAppletWatcher::stop()
+{
+    m_stopping = true;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+#ifdef __linux__
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);  // also removes the watch
+        m_inotifyFd = -1;
+    }
+#endif
+}
+
+// ============================================================================
+// Watch thread
+// ============================================================================
+
+void SqlAppletWatcher::run()
+{
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    pollfd fd{m_inotifyFd, POLLIN, 0};
+
+    while (!m_stopping) {
+        if (poll(&fd, 1, POLL_TIMEOUT_MS) <= 0) {
+            continue;
+        }
+        const ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            if (event->len > 0 && !(event->mask & IN_ISDIR)) {
+                reload(event->name);
+            }
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+        }
+    }
+#endif
+}
+
+void SqlAppletWatcher::reload(string_view fileName)
+{
+    if (!fileName.ends_with(".sql")) {
+        return;  // editor swap and backup files
+    }
+    const string filePath = m_appletPath + string(fileName);
+    string error;
+    if (m_cache.reload(filePath, &error)) {
+        ++m_reloads;
+    } else {
+        ++m_failures;
+        if (m_onError) {
+            m_onError(filePath, error);
+        }
+    }
+}
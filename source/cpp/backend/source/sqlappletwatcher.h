@@ -0,0 +1,65 @@
+/**
+ * @file sqlappletwatcher.h
+ * @brief Reloads edited .sql applets into SqlTemplateCache (Linux inotify)
+ */
+
+#ifndef SQLAPPLETWATCHER_H
+#define SQLAPPLETWATCHER_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+class SqlTemplateCache;
+
+/**
+ * @class SqlAppletWatcher
+ * @brief Background thread that re-parses applets when they change on disk
+ *
+ * Watches the applet directory for files closed after writing or renamed
+ * into it (editors that save through a temporary file) and calls
+ * SqlTemplateCache::reload() for every *.sql among them. A file that fails
+ * to parse is reported to the error handler and its previous version stays
+ * in use. Deleted files are ignored: the cached version keeps serving.
+ *
+ * Only Linux has an implementation; elsewhere start() returns false.
+ */
+class SqlAppletWatcher
+{
+public:
+    using ErrorHandler = std::function<void(const std::string& filePath, const std::string& error)>;
+
+    SqlAppletWatcher(std::string_view appletPath, SqlTemplateCache& cache,
+                     ErrorHandler onError = {});
+    ~SqlAppletWatcher();
+
+    SqlAppletWatcher(const SqlAppletWatcher&) = delete;
+    SqlAppletWatcher& operator=(const SqlAppletWatcher&) = delete;
+
+    /// Start watching; false if the directory cannot be watched on this platform
+    bool start();
+    void stop();
+
+    /// Files reloaded successfully / rejected since start()
+    [[nodiscard]] uint64_t reloads() const noexcept { return m_reloads.load(); }
+    [[nodiscard]] uint64_t failures() const noexcept { return m_failures.load(); }
+
+private:
+    void run();
+    void reload(std::string_view fileName);
+
+    std::string m_appletPath;  ///< With trailing separator
+    SqlTemplateCache& m_cache;
+    ErrorHandler m_onError;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    int m_inotifyFd = -1;
+    std::atomic<uint64_t> m_reloads{0};
+    std::atomic<uint64_t> m_failures{0};
+};
+
+#endif // SQLAPPLETWATCHER_H
@@ -20,6 +20,9 @@ SqlDirectCommand::SqlDirectCommand(SqlConnection& connection,
 
 void SqlDirectCommand::execute()
 {
+    if (m_prefetchRows > 0) {
+        setOption(_TSA("PreFetchRows")) = SAString(std::to_string(m_prefetchRows).c_str());
+    }
     Execute(); // Call base class Execute()
     m_executed = true;
 }
@@ -29,6 +32,41 @@ string SqlDirectCommand::sql() const
     return CommandText().GetMultiByteChars();
 }
 
+void SqlDirectCommand::executeWithTimeout(std::optional<std::chrono::milliseconds> timeout)
+{
+    SAConnection* conn = Connection();
+    if (!timeout || !conn || conn->Client() != SA_PostgreSQL_Client) {
+        SqlDirectCommand::execute();
+        return;
+    }
+
+    const string setTimeout = "SET statement_timeout = " + std::to_string(timeout->count());
+    SACommand(conn, SAString(setTimeout.c_str())).Execute();
+    auto resetTimeout = [conn]() noexcept {
+        try {
+            SACommand(conn, _TSA("RESET statement_timeout")).Execute();
+        } catch (...) {
+            // Inside a failed transaction; the rollback reverts the SET
+        }
+    };
+
+    try {
+        SqlDirectCommand::execute();
+    } catch (...) {
+        resetTimeout();
+        throw;
+    }
+    resetTimeout();
+}
+
+void SqlDirectCommand::executeWithDirectives(const SqlTemplate& tpl)
+{
+    if (m_prefetchRows == 0 && tpl.prefetchRows() > 0) {
+        setOption(_TSA("PreFetchRows")) = SAString(std::to_string(tpl.prefetchRows()).c_str());
+    }
+    executeWithTimeout(tpl.timeout());
+}
+
 // ============================================================================
 // SqlCommand implementation
 // ============================================================================
@@ -39,6 +77,9 @@ SqlCommand::SqlCommand(SqlConnection& connection,
     : SqlDirectCommand(connection, SAString(), SA_CmdUnknown)
     , m_template(sqlFilePath, std::move(formattedParamValueList))
 {
+    if (connection.connectionSa()->Client() == SA_PostgreSQL_Client) {
+        m_template.setArrayBinding(SqlTemplate::ArrayBinding::Native);
+    }
 }
 
 void SqlCommand::addParameter(string_view name, const std::chrono::milliseconds paramValue, DataInfo::Type nType)
@@ -100,7 +141,7 @@ void SqlCommand::execute()
         }
     }
 
-    SqlDirectCommand::execute();
+    executeWithDirectives(m_template);
 }
 
 string SqlCommand::sql() const
@@ -6,6 +6,7 @@
 #include <string_view>
 #include <map>
 #include <chrono>
+#include <optional>
 
 #include "sqltemplate.h"
 #include "column_allowlist.h"
@@ -41,8 +42,31 @@ public:
 
     virtual std::string sql() const;
 
+    /**
+     * @brief Execute with a statement timeout
+     * @param timeout statement_timeout on PostgreSQL (set before, reset after
+     *        the statement); ignored by other clients and when empty
+     * @throws SAException if database execution fails
+     */
+    void executeWithTimeout(std::optional<std::chrono::milliseconds> timeout);
+
+    /**
+     * @brief Rows the driver fetches per round trip (SQLAPI++ PreFetchRows)
+     * @param rows 0 keeps the driver default
+     *
+     * Takes precedence over a template's "-- @prefetch". Call before execute().
+     */
+    void setPrefetchRows(int rows) noexcept { m_prefetchRows = rows; }
+
 protected:
+    /**
+     * @brief Execute under the @timeout / @prefetch directives of @p tpl
+     * @throws SAException if database execution fails
+     */
+    void executeWithDirectives(const SqlTemplate& tpl);
+
     bool m_executed = false; ///< TODO: Add re-execution prevention
+    int m_prefetchRows = 0;  ///< setPrefetchRows(); 0 = driver / template default
 };
 
 /**
@@ -13,6 +13,13 @@
 #include <sstream>
 #include <stdexcept>
 
+#ifdef __linux__
+#include <pgAPI.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
 /**
  * Parameterized constructor implementation.
  * Creates a connection with explicit per-instance credentials.
@@ -57,6 +64,9 @@ SqlConnection::~SqlConnection() noexcept
  */
 SqlConnection::SqlConnection(SqlConnection&& other)
     : db_client(other.db_client)
+    , db_keepalive_idle(other.db_keepalive_idle)
+    , db_keepalive_interval(other.db_keepalive_interval)
+    , db_keepalive_probes(other.db_keepalive_probes)
 {
     // Copy credentials from source (SAString doesn't have noexcept move)
     db_host = other.db_host;
@@ -86,6 +96,9 @@ SqlConnection& SqlConnection::operator=(SqlConnection&& other)
         db_user = other.db_user;
         db_pass = other.db_pass;
         db_client = other.db_client;
+        db_keepalive_idle = other.db_keepalive_idle;
+        db_keepalive_interval = other.db_keepalive_interval;
+        db_keepalive_probes = other.db_keepalive_probes;
         
         // Reconfigure connection with new client type
         db_con.setClient(db_client);
@@ -113,6 +126,11 @@ void SqlConnection::connect()
     // Establish new connection with stored credentials
     // SAException will be thrown if connection fails
     db_con.Connect(db_host, db_user, db_pass);
+
+    // Every connect gets a fresh socket; keepalive has to be set again
+    if (db_keepalive_idle > 0) {
+        applyKeepalive();
+    }
 }
 
 /**
@@ -144,6 +162,61 @@ bool SqlConnection::isConnected() const noexcept
     }
 }
 
+/**
+ * Ask the server whether the connection is still usable.
+ */
+bool SqlConnection::ping() noexcept
+{
+    try {
+        return db_con.isConnected() && db_con.isAlive();
+    } catch (...) {
+        return false;
+    }
+}
+
+/**
+ * Remember the keepalive settings for later connects; apply them now if connected.
+ */
+bool SqlConnection::setKeepalive(int idleSeconds, int intervalSeconds, int probes) noexcept
+{
+    db_keepalive_idle = idleSeconds;
+    db_keepalive_interval = intervalSeconds;
+    db_keepalive_probes = probes;
+    return idleSeconds > 0 && applyKeepalive();
+}
+
+/**
+ * Configure TCP keepalive on the libpq socket.
+ */
+bool SqlConnection::applyKeepalive() noexcept
+{
+#ifdef __linux__
+    if (db_client != SA_PostgreSQL_Client || !isConnected()) {
+        return false;
+    }
+    try {
+        auto* api = static_cast<pgAPI*>(db_con.NativeAPI());
+        auto* handles = static_cast<pgConnectionHandles*>(db_con.NativeHandles());
+        if (!api || !handles || !handles->conn) {
+            return false;
+        }
+        const int fd = api->PQsocket(handles->conn);
+        if (fd < 0) {
+            return false;
+        }
+        const int on = 1;
+        return setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on)) == 0
+            && setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &db_keepalive_idle, sizeof(db_keepalive_idle)) == 0
+            && setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &db_keepalive_interval, sizeof(db_keepalive_interval)) == 0
+            && setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &db_keepalive_probes, sizeof(db_keepalive_probes)) == 0;
+    } catch (...) {
+        return false;
+    }
+#else
+    return false;
+#endif
+}
+
 /**
  * Rollback current transaction.
  * Discards all uncommitted changes in the current transaction.
@@ -140,6 +140,39 @@ public:
      * @return true if connection is active, false otherwise
      */
     bool isConnected() const noexcept;
+
+    /**
+     * @brief Check that the server still answers
+     * 
+     * Unlike isConnected(), which reflects client-side state, this makes a
+     * round trip (SAConnection::isAlive()), so it notices a dropped socket
+     * or a restarted server.
+     * 
+     * @return true if connected and the server responded
+     * @note Does not throw exceptions
+     */
+    bool ping() noexcept;
+
+    /**
+     * @brief Enable TCP keepalive probing on the connection socket
+     * 
+     * The kernel then detects a silently dropped peer (NAT timeout, pulled
+     * cable) after idle + interval * probes instead of the much longer
+     * default, and the next statement fails fast instead of stalling.
+     * The settings are kept and applied by every later connect(), so a
+     * reconnect (TransactionRetry, pool idle checks) keeps probing; an open
+     * connection gets them right away. @p idleSeconds of 0 disables it
+     * for later connects.
+     * 
+     * @param idleSeconds Silence before the first probe
+     * @param intervalSeconds Time between unanswered probes
+     * @param probes Unanswered probes before the socket is closed
+     * @return true if the open socket was configured; false if not
+     *         connected yet or the client has no socket to configure
+     *         (only PostgreSQL on Linux is supported)
+     * @note Does not throw exceptions
+     */
+    bool setKeepalive(int idleSeconds, int intervalSeconds, int probes) noexcept;
     
     /**
      * @brief Rollback current transaction
@@ -216,6 +249,9 @@ private:
      */
     void validateCredentials() const;
 
+    /// Apply the keepalive settings to the open socket
+    bool applyKeepalive() noexcept;
+
     /// Database host address (e.g., server IP or hostname)
     SAString  db_host;
     
@@ -228,6 +264,11 @@ private:
     /// Database client type (MySQL, PostgreSQL, etc.)
     eSAClient db_client;
 
+    /// TCP keepalive settings applied by connect() (idle 0 = off)
+    int db_keepalive_idle = 0;
+    int db_keepalive_interval = 0;
+    int db_keepalive_probes = 0;
+
     /// Underlying SQLAPI++ connection object
     SAConnection db_con;
 };
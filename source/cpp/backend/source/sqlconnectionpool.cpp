@@ -0,0 +1,254 @@
+/**
+ * @file sqlconnectionpool.cpp
+ * @brief Implementation of SqlConnectionPool
+ */
+
+#include "sqlconnectionpool.h"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+// ============================================================================
+// Lease
+// ============================================================================
+
+SqlConnectionPool::Lease::Lease(SqlConnectionPool* pool, std::unique_ptr<SqlConnection> conn) noexcept
+    : m_pool(pool)
+    , m_conn(std::move(conn))
+{
+}
+
+SqlConnectionPool::Lease::Lease(Lease&& other) noexcept
+    : m_pool(std::exchange(other.m_pool, nullptr))
+    , m_conn(std::move(other.m_conn))
+    , m_broken(std::exchange(other.m_broken, false))
+{
+}
+
+SqlConnectionPool::Lease& SqlConnectionPool::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        m_pool = std::exchange(other.m_pool, nullptr);
+        m_conn = std::move(other.m_conn);
+        m_broken = std::exchange(other.m_broken, false);
+    }
+    return *this;
+}
+
+SqlConnectionPool::Lease::~Lease()
+{
+    release();
+}
+
+void SqlConnectionPool::Lease::release() noexcept
+{
+    if (m_pool && m_conn) {
+        m_pool->giveBack(std::move(m_conn), m_broken);
+    }
+    m_pool = nullptr;
+    m_broken = false;
+}
+
+// ============================================================================
+// Pool
+// ============================================================================
+
+SqlConnectionPool::SqlConnectionPool(eSAClient client, std::string host, std::string user,
+                                     std::string pass, size_t maxSize,
+                                     std::chrono::milliseconds failureCooldown)
+    : m_client(client)
+    , m_host(std::move(host))
+    , m_user(std::move(user))
+    , m_pass(std::move(pass))
+    , m_maxSize(std::max<size_t>(maxSize, 1))
+    , m_failureCooldown(failureCooldown)
+{
+}
+
+SqlConnectionPool::Lease SqlConnectionPool::acquire(std::chrono::milliseconds timeout)
+{
+    std::unique_ptr<SqlConnection> conn;
+    {
+        std::unique_lock lock(m_mutex);
+        const bool ready = m_available.wait_for(lock, timeout, [this] {
+            return !m_idle.empty() || m_open < m_maxSize;
+        });
+        if (!ready) {
+            throw std::runtime_error("Connection pool exhausted: " + m_host);
+        }
+        if (!m_idle.empty()) {
+            conn = std::move(m_idle.back().conn);
+            m_idle.pop_back();
+        } else {
+            // Reserve the slot now; connect below without holding the lock
+            ++m_open;
+        }
+    }
+
+    try {
+        if (!conn) {
+            conn = std::make_unique<SqlConnection>(m_client, m_host.c_str(), m_user.c_str(), m_pass.c_str());
+        }
+        if (!conn->isConnected()) {
+            open(*conn);
+        }
+    } catch (...) {
+        {
+            std::lock_guard lock(m_mutex);
+            --m_open;
+        }
+        m_available.notify_one();
+        reportFailure();
+        throw;
+    }
+    return Lease(this, std::move(conn));
+}
+
+void SqlConnectionPool::giveBack(std::unique_ptr<SqlConnection> conn, bool broken) noexcept
+{
+    if (!broken) {
+        try {
+            // Never hand out a connection inside someone else's transaction
+            if (conn->isConnected() && conn->connectionSa()->AutoCommit() == SA_AutoCommitOff) {
+                conn->rollback();
+                conn->setAutoCommit(true);
+            }
+        } catch (...) {
+            broken = true;
+        }
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        if (broken) {
+            --m_open;
+        } else {
+            m_idle.push_back({std::move(conn), Clock::now()});
+        }
+    }
+    // A broken connection is closed by its destructor outside the lock
+    conn.reset();
+    m_available.notify_one();
+}
+
+void SqlConnectionPool::reportFailure()
+{
+    std::lock_guard lock(m_mutex);
+    m_unhealthyUntil = Clock::now() + m_failureCooldown;
+}
+
+bool SqlConnectionPool::isHealthy(Clock::time_point now) const
+{
+    std::lock_guard lock(m_mutex);
+    return now >= m_unhealthyUntil;
+}
+
+size_t SqlConnectionPool::warmUp(size_t count)
+{
+    count = std::min(count, m_maxSize);
+    std::vector<std::optional<Lease>> leases(count);
+    std::vector<std::exception_ptr> errors(count);
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            threads.emplace_back([this, &leases, &errors, i] {
+                try {
+                    leases[i].emplace(acquire());
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+    leases.clear();  // all back to idle
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return size();
+}
+
+void SqlConnectionPool::setKeepalive(int idleSeconds, int intervalSeconds, int probes)
+{
+    std::lock_guard lock(m_mutex);
+    m_keepaliveIdle = idleSeconds;
+    m_keepaliveInterval = intervalSeconds;
+    m_keepaliveProbes = probes;
+}
+
+void SqlConnectionPool::open(SqlConnection& conn)
+{
+    {
+        // Kept by the connection, so its own reconnects probe as well
+        std::lock_guard lock(m_mutex);
+        conn.setKeepalive(m_keepaliveIdle, m_keepaliveInterval, m_keepaliveProbes);
+    }
+    conn.connect();
+}
+
+// ============================================================================
+// Idle checks
+// ============================================================================
+
+size_t SqlConnectionPool::checkIdle(std::chrono::milliseconds idleFor)
+{
+    const auto cutoff = Clock::now() - idleFor;
+    size_t replaced = 0;
+
+    // Oldest first; a connection put back below is newer than the cutoff
+    for (;;) {
+        std::unique_ptr<SqlConnection> conn;
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_idle.empty() || m_idle.front().since > cutoff) {
+                break;
+            }
+            conn = std::move(m_idle.front().conn);
+            m_idle.erase(m_idle.begin());
+        }
+
+        if (!conn->ping()) {
+            try {
+                open(*conn);
+                ++replaced;
+            } catch (...) {
+                conn.reset();
+                reportFailure();
+            }
+        }
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (conn) {
+                m_idle.push_back({std::move(conn), Clock::now()});
+            } else {
+                --m_open;
+            }
+        }
+        m_available.notify_one();
+    }
+    return replaced;
+}
+
+size_t SqlConnectionPool::size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_open;
+}
+
+size_t SqlConnectionPool::idleCount() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_idle.size();
+}
@@ -0,0 +1,188 @@
+/**
+ * @file sqlconnectionpool.h
+ * @brief Bounded pool of SqlConnection objects for one database host
+ *
+ * SqlConnection is single-threaded; a server handling requests on several
+ * threads borrows one connection per request from a pool instead of
+ * sharing a single connection.
+ *
+ * Features:
+ * - Lazy connect, at most maxSize connections per pool
+ * - RAII leases that return the connection on scope exit
+ * - Broken connections are dropped instead of being reused
+ * - Simple health state for failover (see reportFailure())
+ * - Idle connection checks and TCP keepalive (see checkIdle())
+ */
+
+#ifndef SQLCONNECTIONPOOL_H
+#define SQLCONNECTIONPOOL_H
+
+#include "sqlconnection.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class SqlConnectionPool
+ * @brief Thread-safe pool of connections to one host
+ *
+ * Example usage:
+ * @code
+ * SqlConnectionPool pool(SA_PostgreSQL_Client, "localhost@medicon", "user", "pass", 8);
+ * {
+ *     SqlConnectionPool::Lease conn = pool.acquire();
+ *     SqlDirectQuery query(*conn, SAString("SELECT 1"));
+ *     query.query();
+ * } // connection goes back to the pool
+ * @endcode
+ *
+ * Connections are returned with auto-commit on, so a lease never starts
+ * inside a transaction left open by the previous borrower.
+ *
+ * The pool must outlive all of its leases.
+ */
+class SqlConnectionPool
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @class Lease
+     * @brief Borrowed connection; returned to the pool on destruction
+     */
+    class Lease
+    {
+    public:
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        SqlConnection& operator*() const noexcept { return *m_conn; }
+        SqlConnection* operator->() const noexcept { return m_conn.get(); }
+
+        /// Do not reuse this connection (e.g. after a network error)
+        void markBroken() noexcept { m_broken = true; }
+
+        /// Pool this lease was taken from
+        SqlConnectionPool& pool() const noexcept { return *m_pool; }
+
+    private:
+        friend class SqlConnectionPool;
+        Lease(SqlConnectionPool* pool, std::unique_ptr<SqlConnection> conn) noexcept;
+        void release() noexcept;
+
+        SqlConnectionPool* m_pool = nullptr;
+        std::unique_ptr<SqlConnection> m_conn;
+        bool m_broken = false;
+    };
+
+    /**
+     * @brief Create an empty pool; connections are opened on demand
+     *
+     * @param client Database client type
+     * @param host Database host (SQLAPI++ connection string)
+     * @param user Database user
+     * @param pass Database password
+     * @param maxSize Upper bound of open connections (at least 1)
+     * @param failureCooldown How long the pool reports unhealthy after a failure
+     */
+    SqlConnectionPool(eSAClient client, std::string host, std::string user, std::string pass,
+                      size_t maxSize = 4,
+                      std::chrono::milliseconds failureCooldown = std::chrono::seconds(5));
+
+    SqlConnectionPool(const SqlConnectionPool&) = delete;
+    SqlConnectionPool& operator=(const SqlConnectionPool&) = delete;
+
+    /**
+     * @brief Borrow a connected connection
+     *
+     * Reuses an idle connection (reconnecting it if it was dropped) or opens
+     * a new one while below maxSize; otherwise waits up to @p timeout.
+     *
+     * @throws SAException if connecting fails (the pool is marked unhealthy)
+     * @throws std::runtime_error if no connection became free in time
+     */
+    Lease acquire(std::chrono::milliseconds timeout = std::chrono::seconds(10));
+
+    /**
+     * @brief Open up to @p count connections in parallel and keep them idle
+     *
+     * For startup, so the first requests do not wait for connects. Holds
+     * @p count leases (at most maxSize) at once, each on its own thread.
+     * @return number of open connections afterwards
+     * @throws SAException of the first connect that failed
+     */
+    size_t warmUp(size_t count);
+
+    /**
+     * @brief Enable TCP keepalive on every connection opened from now on
+     *
+     * See SqlConnection::setKeepalive(); @p idleSeconds of 0 disables it.
+     */
+    void setKeepalive(int idleSeconds, int intervalSeconds, int probes);
+
+    /**
+     * @brief Ping connections idle for at least @p idleFor; reconnect dead ones
+     *
+     * Checked connections are taken out of the pool one at a time, so
+     * borrowers keep getting the others. A connection that does not answer
+     * is reconnected; if that fails it is dropped and the pool reports a
+     * failure. Called periodically by SqlPoolMaintainer.
+     * @return number of connections that had to be replaced
+     */
+    size_t checkIdle(std::chrono::milliseconds idleFor);
+
+    /**
+     * @brief Record a connection-level failure
+     *
+     * The pool reports unhealthy for the cooldown period so routers can
+     * fail over; after that it is tried again.
+     */
+    void reportFailure();
+
+    /// false during the cooldown after reportFailure()
+    bool isHealthy(Clock::time_point now = Clock::now()) const;
+
+    const std::string& host() const noexcept { return m_host; }
+    size_t maxSize() const noexcept { return m_maxSize; }
+
+    /// Number of open connections (idle + leased)
+    size_t size() const;
+
+    /// Number of idle connections
+    size_t idleCount() const;
+
+private:
+    struct IdleConnection {
+        std::unique_ptr<SqlConnection> conn;
+        Clock::time_point since;  ///< When it was returned or last checked
+    };
+
+    /// Hand the keepalive settings to @p conn and connect()
+    void open(SqlConnection& conn);
+    void giveBack(std::unique_ptr<SqlConnection> conn, bool broken) noexcept;
+
+    eSAClient m_client;
+    std::string m_host;
+    std::string m_user;
+    std::string m_pass;
+    size_t m_maxSize;
+    std::chrono::milliseconds m_failureCooldown;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_available;
+    std::vector<IdleConnection> m_idle;  ///< Oldest first
+    size_t m_open = 0;
+    Clock::time_point m_unhealthyUntil{};
+    int m_keepaliveIdle = 0;
+    int m_keepaliveInterval = 0;
+    int m_keepaliveProbes = 0;
+};
+
+#endif // SQLCONNECTIONPOOL_H
@@ -0,0 +1,68 @@
+#include "sqlpoolmaintainer.h"
+#include "sqlconnectionpool.h"
+
+SqlPoolMaintainer::SqlPoolMaintainer(std::vector<SqlConnectionPool*> pools,
+                                     std::chrono::milliseconds interval,
+                                     ReplaceHandler onReplace)
+    : m_pools(std::move(pools))
+    , m_interval(interval)
+    , m_onReplace(std::move(onReplace))
+{
+}
+
+SqlPoolMaintainer::~SqlPoolMaintainer()
+{
+    stop();
+}
+
+// ============================================================================
+// Start / stop
+// ============================================================================
+
+void SqlPoolMaintainer::start()
+{
+    if (m_thread.joinable()) {
+        return;
+    }
+    m_stopping = false;
+    m_thread = std::thread(&SqlPoolMaintainer::run, this);
+}
+
+void SqlPoolMaintainer::stop()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_wakeup.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+// ============================================================================
+// Maintenance thread
+// ============================================================================
+
+void SqlPoolMaintainer::checkNow()
+{
+    for (SqlConnectionPool* pool : m_pools) {
+        const size_t replaced = pool->checkIdle(m_interval);
+        if (replaced > 0) {
+            m_replaced += replaced;
+            if (m_onReplace) {
+                m_onReplace(pool->host(), replaced);
+            }
+        }
+    }
+}
+
+void SqlPoolMaintainer::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_wakeup.wait_for(lock, m_interval, [this] { return m_stopping.load(); })) {
+        lock.unlock();
+        checkNow();
+        lock.lock();
+    }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file sqlpoolmaintainer.h
+ * @brief Background thread that keeps idle pooled connections alive
+ */
+
+#ifndef SQLPOOLMAINTAINER_H
+#define SQLPOOLMAINTAINER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class SqlConnectionPool;
+
+/**
+ * @class SqlPoolMaintainer
+ * @brief Periodically pings idle connections and replaces dead ones
+ *
+ * A connection dropped by a firewall, a NAT timeout or a server restart
+ * otherwise stays in the pool until a request borrows it and fails. Every
+ * @c interval this thread calls SqlConnectionPool::checkIdle() on each pool,
+ * so connections idle for that long are pinged and reconnected before a
+ * request needs them.
+ *
+ * The pools must outlive the maintainer.
+ */
+class SqlPoolMaintainer
+{
+public:
+    /// Called with the pool host and the number of connections replaced
+    using ReplaceHandler = std::function<void(const std::string& host, size_t replaced)>;
+
+    SqlPoolMaintainer(std::vector<SqlConnectionPool*> pools, std::chrono::milliseconds interval,
+                      ReplaceHandler onReplace = {});
+    ~SqlPoolMaintainer();
+
+    SqlPoolMaintainer(const SqlPoolMaintainer&) = delete;
+    SqlPoolMaintainer& operator=(const SqlPoolMaintainer&) = delete;
+
+    void start();
+    void stop();
+
+    /// Run one round on the calling thread
+    void checkNow();
+
+    /// Connections replaced since construction
+    [[nodiscard]] uint64_t replaced() const noexcept { return m_replaced.load(); }
+
+private:
+    void run();
+
+    std::vector<SqlConnectionPool*> m_pools;
+    std::chrono::milliseconds m_interval;
+    ReplaceHandler m_onReplace;
+
+    std::thread m_thread;
+    std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<uint64_t> m_replaced{0};
+};
+
+#endif // SQLPOOLMAINTAINER_H
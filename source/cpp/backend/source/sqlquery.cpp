@@ -1,4 +1,7 @@
 #include "sqlquery.h"
+#include "sqlconnection.h"
+
+#include <atomic>
 
 using std::string;
 using std::string_view;
@@ -15,20 +18,107 @@ SqlDirectQuery::SqlDirectQuery(SqlConnection& connection,
 {
 }
 
+SqlDirectQuery::~SqlDirectQuery()
+{
+    // A cursor without HOLD ends with its transaction; closing it here
+    // could fail inside a later transaction on the same connection
+    if (m_cursorOpen && m_cursorHold) {
+        closeCursor();
+    }
+}
+
 bool SqlDirectQuery::query()
 {
     if(!m_executed) {
         // First call: execute and fetch first row
         execute();
+
+        if (!m_cursorName.empty()) {
+            m_cursorOpen = true;  // DECLARE has run
+            return fetchFromCursor();
+        }
         
         // Check if result set exists before calling FetchNext()
         return isResultSet() && FetchNext();
+    } else if (!m_cursorName.empty()) {
+        // Executed through execute()/executeWithTimeout() by the caller
+        if (m_batchRows < 0) {
+            m_cursorOpen = true;
+        }
+        return fetchFromCursor();
     } else {
         // Subsequent calls: just fetch next row
         return FetchNext();
     }
 }
 
+// ============================================================================
+// Server-side cursor
+// ============================================================================
+
+void SqlDirectQuery::setServerCursor(int fetchRows)
+{
+    setPrefetchRows(fetchRows);
+    SAConnection* conn = Connection();
+    if (fetchRows <= 0 || !conn || conn->Client() != SA_PostgreSQL_Client) {
+        return;
+    }
+
+    static std::atomic<uint64_t> nextCursor{0};
+    m_cursorName = "medicon_cursor_" + std::to_string(++nextCursor);
+    m_cursorFetchRows = fetchRows;
+    m_cursorHold = conn->AutoCommit() == SA_AutoCommitOn;
+
+    // SqlDirectQuery has its text already; SqlQuery sets it in execute()
+    const string text = CommandText().GetMultiByteChars();
+    if (!text.empty()) {
+        setCommandText(cursorText(text));
+    }
+}
+
+SAString SqlDirectQuery::cursorText(const string& sql) const
+{
+    if (m_cursorName.empty()) {
+        return SAString(sql.c_str());
+    }
+    string text = "DECLARE " + m_cursorName + " NO SCROLL CURSOR ";
+    text += m_cursorHold ? "WITH HOLD FOR " : "WITHOUT HOLD FOR ";
+    // A trailing ';' would end the DECLARE early
+    const auto end = sql.find_last_not_of(" \t\r\n;");
+    text.append(sql, 0, end == string::npos ? 0 : end + 1);
+    return SAString(text.c_str());
+}
+
+bool SqlDirectQuery::fetchFromCursor()
+{
+    while (m_cursorOpen) {
+        if (m_batchRows >= 0 && FetchNext()) {
+            ++m_batchRows;
+            return true;
+        }
+        if (m_batchRows >= 0 && m_batchRows < m_cursorFetchRows) {
+            closeCursor();  // a short batch was the last one
+            break;
+        }
+        const string fetch = "FETCH " + std::to_string(m_cursorFetchRows) + " FROM " + m_cursorName;
+        setCommandText(SAString(fetch.c_str()));
+        Execute();
+        m_batchRows = 0;
+    }
+    return false;
+}
+
+void SqlDirectQuery::closeCursor() noexcept
+{
+    m_cursorOpen = false;
+    try {
+        const string close = "CLOSE " + m_cursorName;
+        SACommand(Connection(), SAString(close.c_str())).Execute();
+    } catch (...) {
+        // Transaction already ended or failed; the cursor went with it
+    }
+}
+
 // ============================================================================
 // SqlQuery implementation
 // ============================================================================
@@ -39,6 +129,9 @@ SqlQuery::SqlQuery(SqlConnection& connection,
     : SqlDirectQuery(connection, SAString(), SA_CmdUnknown)
     , m_template(sqlFilePath, std::move(formattedParamValueList))
 {
+    if (connection.connectionSa()->Client() == SA_PostgreSQL_Client) {
+        m_template.setArrayBinding(SqlTemplate::ArrayBinding::Native);
+    }
 }
 
 void SqlQuery::addParameter(string_view name, const std::chrono::milliseconds paramValue, DataInfo::Type nType)
@@ -59,7 +152,7 @@ void SqlQuery::execute()
         throw;
     }
 
-    setCommandText(m_template.sql().c_str());
+    setCommandText(cursorText(m_template.sql()));
 
     for (const auto& binding : m_template.paramBindings()) {
         if (binding.value == "NULL") {
@@ -100,7 +193,7 @@ void SqlQuery::execute()
         }
     }
 
-    SqlDirectCommand::execute();
+    executeWithDirectives(m_template);
 }
 
 string SqlQuery::sql() const
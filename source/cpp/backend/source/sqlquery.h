@@ -2,9 +2,14 @@
 #define SQLQUERY_H
 
 #include "sqlcommand.h"
+#include "sqlresultcache.h"
 #include "sqltemplate.h"
 #include "column_allowlist.h"
 
+#include <iterator>
+#include <memory>
+#include <vector>
+
 class SqlConnection;
 
 /**
@@ -32,10 +37,65 @@ class SqlConnection;
  *     int64_t id = query.Field("id").asInt64();
  * }
  * @endcode
+ *
+ * Streaming a large result with constant memory (PostgreSQL FETCHes 500
+ * rows at a time from a server-side cursor):
+ * @code
+ * SqlDirectQuery query(conn, SAString("SELECT id, name FROM users"));
+ * query.setServerCursor(500);
+ * for (SqlDirectQuery& row : query.rows()) {
+ *     export(row.Field("id").asInt64(), row.Field("name").asString());
+ * }
+ * @endcode
  */
 class SqlDirectQuery : public SqlDirectCommand
 {
 public:
+    /**
+     * @brief Input range over the rows of a query; each step calls query()
+     *
+     * The element is the query itself, positioned on the current row, so
+     * only one row is held at a time. A range can be iterated once.
+     */
+    class RowRange
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = SqlDirectQuery;
+            using difference_type = std::ptrdiff_t;
+            using reference = SqlDirectQuery&;
+
+            iterator() = default;
+            explicit iterator(SqlDirectQuery* query) : m_query(query) {}
+
+            reference operator*() const { return *m_query; }
+            iterator& operator++()
+            {
+                if (!m_query->query()) {
+                    m_query = nullptr;
+                }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+            bool operator==(std::default_sentinel_t) const noexcept { return m_query == nullptr; }
+
+        private:
+            SqlDirectQuery* m_query = nullptr;  ///< nullptr once exhausted
+        };
+
+        explicit RowRange(SqlDirectQuery& query) : m_query(query) {}
+
+        /// Executes the query (if needed) and moves to the first row
+        iterator begin() { return iterator(m_query.query() ? &m_query : nullptr); }
+        std::default_sentinel_t end() const noexcept { return {}; }
+
+    private:
+        SqlDirectQuery& m_query;
+    };
+
     /**
      * @brief Construct direct SQL query without applet
      * @param connection Database connection
@@ -51,6 +111,9 @@ public:
                    const SAString& sCmd,
                    SACommandType_t eCmdType = SA_CmdUnknown) = delete;
 
+    /// Closes a WITH HOLD cursor left open by setServerCursor()
+    ~SqlDirectQuery();
+
     /**
      * @brief Execute query and fetch next row
      * @return true if a row was fetched, false if no more rows
@@ -63,6 +126,39 @@ public:
      * Returns false when no more rows are available or query produced no result set.
      */
     bool query();
+
+    /// Rows for range-for; see RowRange
+    RowRange rows() { return RowRange(*this); }
+
+    /**
+     * @brief Read the result through a server-side cursor, @p fetchRows at a time
+     *
+     * PostgreSQL: the statement runs as "DECLARE ... CURSOR FOR <sql>" and
+     * query() issues "FETCH fetchRows" whenever a batch is used up, so the
+     * client holds at most one batch. Inside a transaction the cursor ends
+     * with it; in autocommit mode it is declared WITH HOLD and closed once
+     * the last row is read or the query is destroyed. The DECLARE must be a
+     * single SELECT (or VALUES) statement.
+     *
+     * Other clients ignore the cursor and use @p fetchRows as prefetch size.
+     * Call before binding parameters and before the first query().
+     */
+    void setServerCursor(int fetchRows);
+
+protected:
+    /// @p sql, wrapped in DECLARE ... CURSOR when setServerCursor() is active
+    [[nodiscard]] SAString cursorText(const std::string& sql) const;
+
+private:
+    /// Next row from the cursor, FETCHing a new batch when needed
+    bool fetchFromCursor();
+    void closeCursor() noexcept;
+
+    std::string m_cursorName;  ///< Empty unless a PostgreSQL cursor is used
+    int m_cursorFetchRows = 0;
+    bool m_cursorHold = false; ///< Declared WITH HOLD (autocommit connection)
+    bool m_cursorOpen = false;
+    int m_batchRows = -1;      ///< Rows read from the current FETCH; -1 before the first
 };
 
 /**
@@ -166,6 +262,41 @@ public:
      */
     std::string getSqlWithParameters();
 
+    /**
+     * @brief Execute and map every row with @p mapRow (Row mapRow(SqlQuery&))
+     * @throws SqlTemplateException if template parsing fails
+     * @throws SAException if database execution fails
+     *
+     * When the template declares "-- @cache", the mapped rows are served
+     * from SqlResultCache::instance() for its ttl and the statement is not
+     * executed on a hit. A SACommand cursor cannot be replayed, so caching
+     * works on mapped rows and only through this method.
+     */
+    template <typename Row, typename MapRow>
+    std::vector<Row> fetchAll(MapRow&& mapRow)
+    {
+        m_template.parse();
+        const auto& policy = m_template.cachePolicy();
+        std::string key;
+        if (policy) {
+            key = m_template.cacheKey();
+            if (auto hit = SqlResultCache::instance().find<std::vector<Row>>(key)) {
+                return *hit;
+            }
+        }
+
+        std::vector<Row> rows;
+        while (query()) {
+            rows.push_back(mapRow(*this));
+        }
+
+        if (policy) {
+            SqlResultCache::instance().store(key, std::make_shared<const std::vector<Row>>(rows),
+                                             policy->ttl);
+        }
+        return rows;
+    }
+
 private:
     SqlTemplate m_template; ///< SQL template (.sql file mode)
 };
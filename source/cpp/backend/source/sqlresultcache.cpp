@@ -0,0 +1,70 @@
+#include "sqlresultcache.h"
+
+#include <algorithm>
+
+SqlResultCache::SqlResultCache(size_t maxEntries)
+    : m_maxEntries(std::max<size_t>(maxEntries, 1))
+{
+}
+
+SqlResultCache& SqlResultCache::instance()
+{
+    static SqlResultCache cache;
+    return cache;
+}
+
+std::shared_ptr<const void> SqlResultCache::findRaw(const std::string& key,
+                                                    std::type_index type,
+                                                    Clock::time_point now)
+{
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        return nullptr;
+    }
+    if (it->second.expires <= now) {
+        m_entries.erase(it);
+        return nullptr;
+    }
+    return it->second.type == type ? it->second.value : nullptr;
+}
+
+void SqlResultCache::storeRaw(const std::string& key, std::type_index type,
+                              std::shared_ptr<const void> value,
+                              std::chrono::milliseconds ttl, Clock::time_point now)
+{
+    if (ttl.count() <= 0) {
+        return;
+    }
+
+    std::lock_guard lock(m_mutex);
+    if (m_entries.size() >= m_maxEntries && !m_entries.contains(key)) {
+        std::erase_if(m_entries, [now](const auto& item) { return item.second.expires <= now; });
+        if (m_entries.size() >= m_maxEntries) {
+            m_entries.clear();
+        }
+    }
+    m_entries.insert_or_assign(key, Entry{type, std::move(value), now + ttl});
+}
+
+void SqlResultCache::invalidate(std::string_view filePath)
+{
+    std::lock_guard lock(m_mutex);
+    std::erase_if(m_entries, [filePath](const auto& item) {
+        const std::string& key = item.first;
+        return key.starts_with(filePath) && key.size() > filePath.size() &&
+               key[filePath.size()] == '\x1f';
+    });
+}
+
+void SqlResultCache::clear()
+{
+    std::lock_guard lock(m_mutex);
+    m_entries.clear();
+}
+
+size_t SqlResultCache::size() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_entries.size();
+}
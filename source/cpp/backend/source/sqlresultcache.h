@@ -0,0 +1,77 @@
+/**
+ * @file sqlresultcache.h
+ * @brief Process-wide TTL cache for results of "-- @cache" templates
+ *
+ * Filled by SqlQuery::fetchAll() when the template declares a cache
+ * policy; the key comes from SqlTemplate::cacheKey(). Values are immutable
+ * and shared, so a hit costs one lookup and one copy.
+ */
+
+#ifndef SQLRESULTCACHE_H
+#define SQLRESULTCACHE_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * @class SqlResultCache
+ * @brief Thread-safe map of cache key → typed result with an expiry time
+ *
+ * Entries of another type under the same key count as a miss. When the
+ * cache is full, expired entries are swept first; if that frees nothing
+ * the cache is emptied (hot keys repopulate within one ttl).
+ */
+class SqlResultCache
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit SqlResultCache(size_t maxEntries = 4096);
+
+    /// Cache shared by every SqlQuery of the process
+    static SqlResultCache& instance();
+
+    template <typename T>
+    std::shared_ptr<const T> find(const std::string& key, Clock::time_point now = Clock::now())
+    {
+        return std::static_pointer_cast<const T>(findRaw(key, typeid(T), now));
+    }
+
+    template <typename T>
+    void store(const std::string& key, std::shared_ptr<const T> value,
+               std::chrono::milliseconds ttl, Clock::time_point now = Clock::now())
+    {
+        storeRaw(key, typeid(T), std::move(value), ttl, now);
+    }
+
+    /// Drop the entries of one template file (keys start with its path)
+    void invalidate(std::string_view filePath);
+
+    void clear();
+    size_t size() const;
+
+private:
+    struct Entry {
+        std::type_index type;
+        std::shared_ptr<const void> value;
+        Clock::time_point expires;
+    };
+
+    std::shared_ptr<const void> findRaw(const std::string& key, std::type_index type,
+                                        Clock::time_point now);
+    void storeRaw(const std::string& key, std::type_index type,
+                  std::shared_ptr<const void> value,
+                  std::chrono::milliseconds ttl, Clock::time_point now);
+
+    size_t m_maxEntries;
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+#endif // SQLRESULTCACHE_H
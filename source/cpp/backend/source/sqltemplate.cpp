@@ -1,6 +1,9 @@
 #include "sqltemplate.h"
+#include "sqlappletbundle.h"
+#include "sqltemplatecache.h"
 
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <fstream>
 #include <sstream>
@@ -10,6 +13,48 @@ using std::string_view;
 using std::vector;
 using std::map;
 
+namespace {
+
+/// 'value' with embedded quotes doubled, for debug SQL
+string quoteSqlLiteral(string_view value)
+{
+    string quoted;
+    quoted.reserve(value.size() + 2);
+    quoted += '\'';
+    for (char c : value) {
+        if (c == '\'') quoted += '\'';
+        quoted += c;
+    }
+    quoted += '\'';
+    return quoted;
+}
+
+bool startsWithNoCase(string_view text, string_view prefix)
+{
+    return text.size() >= prefix.size() &&
+           std::equal(prefix.begin(), prefix.end(), text.begin(), [](char a, char b) {
+               return std::toupper(static_cast<unsigned char>(a)) == b;
+           });
+}
+
+/// Replace a trailing "= ANY(" of @p sql with "IN ("; false if there is none
+bool rewriteAnyToIn(string& sql)
+{
+    constexpr const char* ws = " \t\r\n";
+    size_t pos = sql.find_last_not_of(ws);
+    if (pos == string::npos || sql[pos] != '(' || pos == 0) return false;
+    pos = sql.find_last_not_of(ws, pos - 1);
+    if (pos == string::npos || pos < 3 ||
+        !startsWithNoCase(string_view(sql).substr(pos - 2, 3), "ANY")) return false;
+    const size_t eq = sql.find_last_not_of(ws, pos - 3);
+    if (eq == string::npos || sql[eq] != '=') return false;
+    sql.erase(eq);
+    sql += "IN (";
+    return true;
+}
+
+} // namespace
+
 // ============================================================================
 // Construction
 // ============================================================================
@@ -78,28 +123,131 @@ DataInfo::Type SqlTemplate::parseTypeName(string_view typeName)
     throw SqlTemplateException(
         string("Unknown parameter type '") + string(typeName) +
         "'. Valid types: INT, INT64, STRING, DOUBLE, BOOL, DATETIME, "
-        "DATETIMENOSEC, DATE, TIME");
+        "DATETIMENOSEC, DATE, TIME, ARRAY_INT, ARRAY_INT64, ARRAY_STRING");
+}
+
+// ============================================================================
+// Header directives
+// ============================================================================
+
+std::chrono::milliseconds SqlTemplate::parseDuration(string_view text)
+{
+    size_t digits = 0;
+    while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+        ++digits;
+    }
+    if (digits == 0) {
+        throw SqlTemplateException("SqlTemplate: Invalid duration '" + string(text) + "'");
+    }
+
+    const long long value = std::stoll(string(text.substr(0, digits)));
+    const string_view unit = text.substr(digits);
+    if (unit.empty() || unit == "ms") return std::chrono::milliseconds(value);
+    if (unit == "s")                  return std::chrono::seconds(value);
+    if (unit == "m" || unit == "min") return std::chrono::minutes(value);
+
+    throw SqlTemplateException(
+        "SqlTemplate: Unknown duration unit in '" + string(text) + "'. Use ms, s or m");
+}
+
+void SqlTemplate::parseDirective(Source& source, const string& filePath,
+                                 string_view name, string_view args)
+{
+    std::istringstream iss{string(args)};
+
+    if (name == "timeout") {
+        string value;
+        iss >> value;
+        source.timeout = parseDuration(value);
+        return;
+    }
+
+    if (name == "prefetch") {
+        int rows = 0;
+        if (!(iss >> rows) || rows <= 0) {
+            throw SqlTemplateException(
+                "SqlTemplate: @prefetch needs a positive row count in " + filePath);
+        }
+        source.prefetchRows = rows;
+        return;
+    }
+
+    if (name == "cache") {
+        CachePolicy policy;
+        string token;
+        while (iss >> token) {
+            if (token.starts_with("ttl=")) {
+                policy.ttl = parseDuration(string_view(token).substr(4));
+            } else if (token.starts_with("key=")) {
+                std::istringstream keys(token.substr(4));
+                string key;
+                while (std::getline(keys, key, ',')) {
+                    if (!key.empty()) {
+                        policy.keyParams.push_back(key);
+                    }
+                }
+            } else {
+                throw SqlTemplateException(
+                    "SqlTemplate: Unknown @cache option '" + token + "' in " + filePath);
+            }
+        }
+        if (policy.ttl.count() <= 0) {
+            throw SqlTemplateException("SqlTemplate: @cache needs ttl=<duration> in " + filePath);
+        }
+        source.cachePolicy = std::move(policy);
+        return;
+    }
+
+    throw SqlTemplateException(
+        "SqlTemplate: Unknown directive '@" + string(name) + "' in " + filePath +
+        ". Valid directives: @param, @timeout, @prefetch, @cache");
 }
 
 // ============================================================================
 // File loading and header parsing
 // ============================================================================
 
-void SqlTemplate::loadAndParseFile()
+std::shared_ptr<const SqlTemplate::Source> SqlTemplate::load(const string& filePath)
 {
-    std::ifstream file(m_filePath);
+    // An installed bundle serves the applet from memory; otherwise read the file
+    if (auto applet = SqlAppletBundle::resolve(filePath)) {
+        std::istringstream bundled{string(applet->text)};
+        return parseSource(filePath, bundled);
+    }
+
+    std::ifstream file(filePath);
     if (!file.is_open()) {
         throw SqlTemplateException(
-            string("SqlTemplate: Cannot open file: ") + m_filePath);
+            string("SqlTemplate: Cannot open file: ") + filePath);
     }
+    return parseSource(filePath, file);
+}
+
+std::shared_ptr<const SqlTemplate::Source> SqlTemplate::parseSource(const string& filePath,
+                                                                     std::istream& input)
+{
+    auto source = std::make_shared<Source>();
 
     string line;
     bool inHeader = true;
     bool foundDescription = false;
     string sqlBody;
 
-    while (std::getline(file, line)) {
+    while (std::getline(input, line)) {
         if (inHeader) {
+            // Check for -- @timeout / @prefetch / @cache directives
+            if (line.starts_with("-- @") && !line.starts_with("-- @param")) {
+                string_view directive(line);
+                directive.remove_prefix(4);
+                while (!directive.empty() && std::isspace(static_cast<unsigned char>(directive.back()))) {
+                    directive.remove_suffix(1);
+                }
+                const size_t nameEnd = directive.find_first_of(" \t");
+                parseDirective(*source, filePath, directive.substr(0, nameEnd),
+                               nameEnd == string_view::npos ? string_view() : directive.substr(nameEnd + 1));
+                continue;
+            }
+
             // Check for -- @param declaration
             if (line.size() > 10 &&
                 line[0] == '-' && line[1] == '-' &&
@@ -130,7 +278,18 @@ void SqlTemplate::loadAndParseFile()
 
                 ParamDecl pd;
                 pd.name = paramName;
-                pd.type = parseTypeName(paramType);
+                string_view typeName = paramType;
+                if (startsWithNoCase(typeName, "ARRAY_")) {
+                    pd.isArray = true;
+                    typeName.remove_prefix(6);
+                }
+                pd.type = parseTypeName(typeName);
+                if (pd.isArray && pd.type != DataInfo::Int &&
+                    pd.type != DataInfo::Int64 && pd.type != DataInfo::String) {
+                    throw SqlTemplateException(
+                        "SqlTemplate: Array parameter '" + paramName +
+                        "' must be ARRAY_INT, ARRAY_INT64 or ARRAY_STRING in " + filePath);
+                }
 
                 // Parse default=VALUE
                 string remaining;
@@ -156,7 +315,7 @@ void SqlTemplate::loadAndParseFile()
                     }
                 }
                 
-                m_declarations.push_back(std::move(pd));
+                source->declarations.push_back(std::move(pd));
                 continue;
             }
             
@@ -173,7 +332,7 @@ void SqlTemplate::loadAndParseFile()
                         if (!content.empty() &&
                             content.find("@param") != 0 &&
                             !isFilenameComment) {
-                            m_description = content;
+                            source->description = content;
                             foundDescription = true;
                         }
                     }
@@ -199,11 +358,22 @@ void SqlTemplate::loadAndParseFile()
 
     if (sqlBody.empty()) {
         throw SqlTemplateException(
-            string("SqlTemplate: No SQL body found in: ") + m_filePath);
+            string("SqlTemplate: No SQL body found in: ") + filePath);
     }
 
-    m_rawSql = sqlBody;
-    m_fileLoaded = true;
+    if (source->cachePolicy) {
+        for (const auto& key : source->cachePolicy->keyParams) {
+            const bool declared = std::any_of(source->declarations.begin(), source->declarations.end(),
+                [&](const ParamDecl& d) { return d.name == key; });
+            if (!declared) {
+                throw SqlTemplateException(
+                    "SqlTemplate: @cache key '" + key + "' is not a declared @param in " + filePath);
+            }
+        }
+    }
+
+    source->rawSql = std::move(sqlBody);
+    return source;
 }
 
 // ============================================================================
@@ -271,6 +441,82 @@ string SqlTemplate::formatDefault(const ParamDecl& decl) const
     return decl.defaultValue;
 }
 
+// ============================================================================
+// Array parameters
+// ============================================================================
+
+size_t SqlTemplate::arrayBucket(size_t count) noexcept
+{
+    if (count <= 1) return 1;
+    if (count > 1024) return (count + 1023) / 1024 * 1024;
+    return std::bit_ceil(count);
+}
+
+void SqlTemplate::appendArray(const ParamDecl& decl, const string& formatted,
+                              string& resultSql, string& resultDebug)
+{
+    vector<string> values;
+    if (auto it = m_arrayValues.find(decl.name); it != m_arrayValues.end()) {
+        values = it->second;
+    } else if (!formatted.empty()) {
+        std::istringstream list(formatted);
+        for (string value; std::getline(list, value, ',');) {
+            values.push_back(Trimmer::trim(value));
+        }
+    }
+    const bool isString = decl.type == DataInfo::String;
+
+    if (m_arrayBinding == ArrayBinding::Native) {
+        // One text-format array literal: {1,2} or {"a","b\"c"}
+        string literal = "{";
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0) literal += ',';
+            if (!isString) {
+                literal += values[i];
+                continue;
+            }
+            literal += '"';
+            for (char c : values[i]) {
+                if (c == '"' || c == '\\') literal += '\\';
+                literal += c;
+            }
+            literal += '"';
+        }
+        literal += '}';
+
+        const char* cast = isString ? " AS text[])" : " AS bigint[])";
+        resultSql += "CAST(:" + decl.name + cast;
+        resultDebug += "CAST(" + quoteSqlLiteral(literal) + cast;
+        m_paramBindings.push_back({decl.name, std::move(literal), DataInfo::String});
+        return;
+    }
+
+    // Expand: "= ANY(:X)" → "IN (:X_0, ...)"; a hand-written "IN (:X)" works too
+    rewriteAnyToIn(resultSql);
+    rewriteAnyToIn(resultDebug);
+    if (values.empty()) {
+        // Matches nothing, unlike "IN ()" which only SQLite accepts
+        resultSql += "NULL";
+        resultDebug += "NULL";
+        return;
+    }
+
+    // Pad with the last value: duplicates do not change IN, and the
+    // statement text only changes when the bucket does
+    const size_t bucket = arrayBucket(values.size());
+    for (size_t i = 0; i < bucket; ++i) {
+        const string& value = values[std::min(i, values.size() - 1)];
+        const string name = decl.name + '_' + std::to_string(i);
+        if (i > 0) {
+            resultSql += ", ";
+            resultDebug += ", ";
+        }
+        resultSql += ':' + name;
+        resultDebug += isString ? quoteSqlLiteral(value) : value;
+        m_paramBindings.push_back({name, value, decl.type});
+    }
+}
+
 // ============================================================================
 // Main parse() — the core method
 // ============================================================================
@@ -283,16 +529,15 @@ void SqlTemplate::parse()
     m_paramBindings.clear();
     m_isParsed = false;
 
-    // Load and parse file if not already loaded
-    if (!m_fileLoaded) {
-        loadAndParseFile();
+    // Load the file once per template; a reload swaps in a new Source for
+    // later templates and leaves this one on its version
+    if (!m_source) {
+        m_source = SqlTemplateCache::instance().get(m_filePath);
     }
+    const Source& source = *m_source;
 
-    // Get all formatted values from the formatter
-    auto formattedValues = m_formatter.toMap();
-
-    string sqlText = m_rawSql;
-    string debugText = m_rawSql;
+    const string& sqlText = source.rawSql;
+    const string& debugText = source.rawSql;
 
     // Find all :NAME placeholders in SQL
     auto placeholders = findPlaceholders(sqlText);
@@ -307,10 +552,10 @@ void SqlTemplate::parse()
         resultDebug.append(debugText, lastPos, ph.offset - lastPos);
 
         // Find declaration for this placeholder
-        auto declIt = std::find_if(m_declarations.begin(), m_declarations.end(),
+        auto declIt = std::find_if(source.declarations.begin(), source.declarations.end(),
             [&](const ParamDecl& d) { return d.name == ph.name; });
 
-        if (declIt == m_declarations.end()) {
+        if (declIt == source.declarations.end()) {
             // Unknown placeholder — keep as-is
             char sigil = (ph.sigil == Sigil::Bind) ? ':' : '$';
             resultSql += sigil + ph.name;
@@ -320,12 +565,14 @@ void SqlTemplate::parse()
         }
 
         // Get the formatted value: check addParameter() first, then default
-        auto valIt = formattedValues.find(ph.name);
-        bool hasValue = (valIt != formattedValues.end());
-        string valueStr = hasValue ? valIt->second
+        const auto added = m_formatter.getValue(ph.name);
+        bool hasValue = added.has_value();
+        string valueStr = hasValue ? string(*added)
                         : (declIt->hasDefault ? formatDefault(*declIt) : string());
 
-        if (ph.sigil == Sigil::Identifier) {
+        if (declIt->isArray) {
+            appendArray(*declIt, valueStr, resultSql, resultDebug);
+        } else if (ph.sigil == Sigil::Identifier) {
             // $NAME — identifier: validate against allow-list and inline
             if (valueStr.empty() && !hasValue && !declIt->hasDefault) {
                 throw SqlTemplateException(
@@ -358,18 +605,9 @@ void SqlTemplate::parse()
                     case DataInfo::DateTime:
                     case DataInfo::DateTimeNoSec:
                     case DataInfo::Date:
-                    case DataInfo::Time: {
-                        string escaped;
-                        escaped.reserve(valueStr.size() + 2);
-                        escaped += '\'';
-                        for (char c : valueStr) {
-                            if (c == '\'') escaped += '\'';
-                            escaped += c;
-                        }
-                        escaped += '\'';
-                        resultDebug += escaped;
+                    case DataInfo::Time:
+                        resultDebug += quoteSqlLiteral(valueStr);
                         break;
-                    }
                     default:
                         resultDebug += valueStr;
                         break;
@@ -407,6 +645,31 @@ void SqlTemplate::parse()
 // Debug SQL
 // ============================================================================
 
+string SqlTemplate::cacheKey() const
+{
+    if (!m_isParsed) {
+        throw SqlTemplateException("SqlTemplate: cacheKey() before parse() in " + m_filePath);
+    }
+
+    // Inlined $COLUMN values are part of the SQL text; unit separators split the parts
+    string key = m_filePath;
+    key += '\x1f';
+    key += m_sqlSource;
+    for (const auto& binding : m_paramBindings) {
+        const auto& policy = cachePolicy();
+        const bool inKey = !policy || policy->keyParams.empty() ||
+            std::find(policy->keyParams.begin(), policy->keyParams.end(),
+                      binding.name) != policy->keyParams.end();
+        if (inKey) {
+            key += '\x1f';
+            key += binding.name;
+            key += '=';
+            key += binding.value;
+        }
+    }
+    return key;
+}
+
 string SqlTemplate::getDebugSql() const
 {
     if (!m_isParsed) {
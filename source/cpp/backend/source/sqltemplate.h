@@ -2,8 +2,11 @@
 #define SQLTEMPLATE_H
 
 #include <chrono>
+#include <concepts>
+#include <istream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <stdexcept>
@@ -55,6 +58,20 @@ private:
  *   AND :FILTER_FIELD LIKE '%' || :FILTER_VALUE || '%'
  * @endcode
  *
+ * Execution directives, honored by SqlCommand / SqlQuery so that a DBA can
+ * tune a statement without rebuilding:
+ * @code
+ * -- @timeout  500ms                               statement_timeout (PostgreSQL)
+ * -- @prefetch 500                                 SQLAPI++ PreFetchRows
+ * -- @cache    ttl=30s key=SERVER_UID,FILTER_VALUE  see SqlQuery::fetchAll()
+ * @endcode
+ * Durations take ms, s or m (a bare number is milliseconds). Cached results
+ * may be up to ttl old, including this process's own writes. Unknown
+ * directives are rejected.
+ *
+ * When a SqlAppletBundle is installed for the applet directory, the text
+ * comes from the bundle instead of the file (see SqlAppletBundle::install()).
+ *
  * Usage:
  * @code
  * SqlTemplate tpl("company_select.sql");
@@ -80,6 +97,65 @@ public:
         DataInfo::Type type;    ///< Declared parameter type
     };
 
+    /**
+     * @brief Result caching declared by "-- @cache ttl=... key=..."
+     */
+    struct CachePolicy {
+        std::chrono::milliseconds ttl{0};
+        std::vector<std::string> keyParams;  ///< Bind params in the key; empty = all
+    };
+
+    /**
+     * @brief Parsed parameter declaration from -- @param header lines
+     */
+    struct ParamDecl {
+        std::string name;           ///< e.g., "SERVER_UID"
+        DataInfo::Type type;        ///< Mapped from type string in header (element type of arrays)
+        std::string defaultValue;   ///< Raw default value string
+        bool hasDefault = false;
+        bool isArray = false;       ///< ARRAY_INT / ARRAY_STRING
+    };
+
+    /**
+     * @brief How ARRAY_* parameters reach the database
+     *
+     * Native binds one PostgreSQL array ("= ANY(:UIDS)" becomes
+     * "= ANY(CAST(:UIDS AS bigint[]))"), so the statement text does not
+     * depend on the array length. Expand (any other client) turns
+     * "= ANY(:UIDS)" into "IN (:UIDS_0, ..., :UIDS_n)", padded with the last
+     * value to a bucket size so only a few distinct texts are prepared.
+     */
+    enum class ArrayBinding { Native, Expand };
+
+    /**
+     * @brief Everything read from the .sql file, before parameters are applied
+     *
+     * Immutable once loaded, so one Source is shared by every SqlTemplate of
+     * the same file (see SqlTemplateCache) and a reload never changes a
+     * template that already holds one.
+     */
+    struct Source {
+        std::string description;
+        std::string rawSql;                  ///< SQL body with :NAME / $NAME placeholders
+        std::vector<ParamDecl> declarations;
+        std::optional<std::chrono::milliseconds> timeout;
+        int prefetchRows = 0;
+        std::optional<CachePolicy> cachePolicy;
+    };
+
+    /**
+     * @brief Read @p filePath (or its installed bundle entry) into a Source
+     * @throws SqlTemplateException if the file is missing or its header is invalid
+     */
+    [[nodiscard]] static std::shared_ptr<const Source> load(const std::string& filePath);
+
+    /**
+     * @brief Parse applet text read from @p input; @p filePath is used in errors
+     * @throws SqlTemplateException if the header is invalid or the body is empty
+     */
+    [[nodiscard]] static std::shared_ptr<const Source> parseSource(const std::string& filePath,
+                                                                   std::istream& input);
+
     /**
      * @brief Construct SqlTemplate with a .sql file path
      * @param filePath Path to the .sql template file (absolute or relative to current directory)
@@ -108,6 +184,28 @@ public:
         m_formatter.addParameter(name, data);
     }
     
+    /**
+     * @brief Add the values of an ARRAY_INT parameter
+     */
+    template<std::integral T>
+    void addParameter(std::string_view name, const std::vector<T>& values)
+    {
+        std::vector<std::string> formatted;
+        formatted.reserve(values.size());
+        for (T value : values) {
+            formatted.push_back(std::to_string(value));
+        }
+        m_arrayValues[std::string(name)] = std::move(formatted);
+    }
+
+    /**
+     * @brief Add the values of an ARRAY_STRING parameter
+     */
+    void addParameter(std::string_view name, std::vector<std::string> values)
+    {
+        m_arrayValues[std::string(name)] = std::move(values);
+    }
+
     /**
      * @brief Add a time-based parameter with explicit type formatting
      */
@@ -132,6 +230,20 @@ public:
     void setColumnValidator(std::string_view paramName,
                             const ColumnAllowListBase* validator);
 
+    /**
+     * @brief Choose how ARRAY_* parameters are rendered (default Expand)
+     *
+     * SqlCommand and SqlQuery pick Native for PostgreSQL connections.
+     */
+    void setArrayBinding(ArrayBinding binding) noexcept { m_arrayBinding = binding; }
+
+    /**
+     * @brief Number of values an expanded array of @p count values is padded to
+     *
+     * Powers of two up to 1024, then multiples of 1024; at least 1.
+     */
+    [[nodiscard]] static size_t arrayBucket(size_t count) noexcept;
+
     /**
      * @brief Parse the .sql file, validate parameters, generate SQL with markers
      * @throws SqlTemplateException on file error, missing param, or COLUMN validation failure
@@ -165,8 +277,46 @@ public:
     /**
      * @brief Get applet description (first non-@param comment line)
      */
-    [[nodiscard]] const std::string& description() const noexcept { return m_description; }
+    [[nodiscard]] const std::string& description() const noexcept
+    {
+        static const std::string none;
+        return m_source ? m_source->description : none;
+    }
     
+    /**
+     * @brief "-- @timeout" of the file (valid after parse())
+     */
+    [[nodiscard]] std::optional<std::chrono::milliseconds> timeout() const noexcept
+    {
+        return m_source ? m_source->timeout : std::nullopt;
+    }
+
+    /**
+     * @brief "-- @prefetch" row count of the file, 0 when not set (valid after parse())
+     */
+    [[nodiscard]] int prefetchRows() const noexcept { return m_source ? m_source->prefetchRows : 0; }
+
+    /**
+     * @brief "-- @cache" policy of the file (valid after parse())
+     */
+    [[nodiscard]] const std::optional<CachePolicy>& cachePolicy() const noexcept
+    {
+        static const std::optional<CachePolicy> none;
+        return m_source ? m_source->cachePolicy : none;
+    }
+
+    /**
+     * @brief Result cache key: file, generated SQL and the key parameter values
+     * @throws SqlTemplateException if called before parse()
+     */
+    [[nodiscard]] std::string cacheKey() const;
+
+    /**
+     * @brief Parse a directive duration ("500ms", "30s", "2m", "250")
+     * @throws SqlTemplateException on a malformed or negative value
+     */
+    [[nodiscard]] static std::chrono::milliseconds parseDuration(std::string_view text);
+
     /**
      * @brief Check if the template has been parsed
      */
@@ -178,16 +328,6 @@ public:
     [[nodiscard]] const std::string& filePath() const noexcept { return m_filePath; }
 
 private:
-    /**
-     * @brief Parsed parameter declaration from -- @param header lines
-     */
-    struct ParamDecl {
-        std::string name;           ///< e.g., "SERVER_UID"
-        DataInfo::Type type;        ///< Mapped from type string in header
-        std::string defaultValue;   ///< Raw default value string
-        bool hasDefault = false;
-    };
-
     /**
      * @brief Sigil type for SQL placeholders
      */
@@ -209,9 +349,10 @@ private:
     [[nodiscard]] static DataInfo::Type parseTypeName(std::string_view typeName);
 
     /**
-     * @brief Read the .sql file and parse header + SQL body
+     * @brief Apply one "-- @name args" header directive other than @param
      */
-    void loadAndParseFile();
+    static void parseDirective(Source& source, const std::string& filePath,
+                               std::string_view name, std::string_view args);
 
     /**
      * @brief Find all :NAME placeholders in SQL text
@@ -223,24 +364,28 @@ private:
      */
     [[nodiscard]] std::string formatDefault(const ParamDecl& decl) const;
 
+    /**
+     * @brief Render an ARRAY_* placeholder into the output SQL and bindings
+     * @param formatted value or default when no vector was added: a comma-separated list
+     */
+    void appendArray(const ParamDecl& decl, const std::string& formatted,
+                     std::string& resultSql, std::string& resultDebug);
+
     std::string m_filePath;
-    std::string m_description;
-    std::string m_rawSql;           // SQL body from file (with :NAME placeholders)
+    std::shared_ptr<const Source> m_source;  // File content, shared (null until parse())
     std::string m_sqlSource;        // Output SQL with markers (or inlined COLUMNs)
     std::string m_debugSql;         // For logging
     
     bool m_isParsed = false;
-    bool m_fileLoaded = false;
     
     // Parameters added by caller
     JsonParameterFormatter m_formatter;
-    
-    // Parsed declarations from -- @param lines
-    std::vector<ParamDecl> m_declarations;
+    std::map<std::string, std::vector<std::string>, std::less<>> m_arrayValues;
+    ArrayBinding m_arrayBinding = ArrayBinding::Expand;
     
     // Output bindings for SQLAPI++ Param()
     std::vector<ParamBinding> m_paramBindings;
-    
+
     // Allow-lists for COLUMN-type params
     std::map<std::string, const ColumnAllowListBase*, std::less<>> m_columnValidators;
 };
@@ -0,0 +1,132 @@
+#include "sqltemplatecache.h"
+#include "sqlappletbundle.h"
+#include "sqlresultcache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+using std::string;
+
+SqlTemplateCache& SqlTemplateCache::instance()
+{
+    static SqlTemplateCache cache;
+    return cache;
+}
+
+void SqlTemplateCache::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+    if (!enabled) {
+        clear();
+    }
+}
+
+// ============================================================================
+// Readers
+// ============================================================================
+
+SqlTemplateCache::SourcePtr SqlTemplateCache::get(const string& filePath)
+{
+    if (!enabled()) {
+        return SqlTemplate::load(filePath);
+    }
+
+    const auto snapshot = m_snapshot.load(std::memory_order_acquire);
+    if (auto it = snapshot->find(filePath); it != snapshot->end()) {
+        return it->second;
+    }
+
+    // Load outside the lock; a version published by reload() meanwhile wins
+    return publish(filePath, SqlTemplate::load(filePath), /*replace=*/false);
+}
+
+size_t SqlTemplateCache::preload(const string& appletPath, const ErrorHandler& onError)
+{
+    std::vector<string> files;
+    if (auto bundle = SqlAppletBundle::installed()) {
+        for (auto name : bundle->names()) {
+            files.push_back(appletPath + string(name));
+        }
+    } else {
+        std::error_code error;
+        for (const auto& item : std::filesystem::directory_iterator(appletPath, error)) {
+            if (item.is_regular_file() && item.path().extension() == ".sql") {
+                files.push_back(item.path().string());
+            }
+        }
+        if (error && onError) {
+            onError(appletPath, error.message());
+        }
+    }
+
+    size_t loaded = 0;
+    for (const auto& filePath : files) {
+        try {
+            get(filePath);
+            ++loaded;
+        } catch (const SqlTemplateException& x) {
+            if (onError) {
+                onError(filePath, x.what());
+            }
+        }
+    }
+    return loaded;
+}
+
+size_t SqlTemplateCache::size() const
+{
+    return m_snapshot.load(std::memory_order_acquire)->size();
+}
+
+// ============================================================================
+// Writers
+// ============================================================================
+
+bool SqlTemplateCache::reload(const string& filePath, string* error)
+{
+    if (!enabled()) {
+        return true;
+    }
+
+    SourcePtr source;
+    try {
+        std::ifstream file(filePath);
+        if (!file.is_open()) {
+            throw SqlTemplateException("SqlTemplate: Cannot open file: " + filePath);
+        }
+        source = SqlTemplate::parseSource(filePath, file);
+    } catch (const SqlTemplateException& x) {
+        if (error) {
+            *error = x.what();
+        }
+        return false;
+    }
+
+    publish(filePath, std::move(source), /*replace=*/true);
+    SqlResultCache::instance().invalidate(filePath);
+    m_reloads.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void SqlTemplateCache::clear()
+{
+    std::lock_guard lock(m_writeMutex);
+    m_snapshot.store(std::make_shared<const Snapshot>(), std::memory_order_release);
+}
+
+SqlTemplateCache::SourcePtr SqlTemplateCache::publish(const string& filePath, SourcePtr source,
+                                                      bool replace)
+{
+    std::lock_guard lock(m_writeMutex);
+    const auto current = m_snapshot.load(std::memory_order_acquire);
+    if (!replace) {
+        if (auto it = current->find(filePath); it != current->end()) {
+            return it->second;
+        }
+    }
+    auto next = std::make_shared<Snapshot>(*current);
+    (*next)[filePath] = source;
+    m_snapshot.store(std::move(next), std::memory_order_release);
+    return source;
+}
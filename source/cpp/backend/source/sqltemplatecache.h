@@ -0,0 +1,93 @@
+/**
+ * @file sqltemplatecache.h
+ * @brief Process-wide cache of loaded .sql applets with lock-free reads
+ *
+ * SqlTemplate::parse() asks the cache for the file's Source. While the
+ * cache is enabled a file is read once and kept until reload() publishes a
+ * new version; SqlAppletWatcher calls reload() when the file changes on
+ * disk. Disabled (the default), every get() reads the file, as before.
+ */
+
+#ifndef SQLTEMPLATECACHE_H
+#define SQLTEMPLATECACHE_H
+
+#include "sqltemplate.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class SqlTemplateCache
+ * @brief Copy-on-write map of file path → SqlTemplate::Source
+ *
+ * Readers load the current snapshot and look the path up without taking a
+ * lock. Writers copy the map, change the copy and publish it atomically,
+ * so a reader keeps a consistent snapshot and a template that already holds
+ * a Source keeps that version until it is destroyed.
+ */
+class SqlTemplateCache
+{
+public:
+    using SourcePtr = std::shared_ptr<const SqlTemplate::Source>;
+    using ErrorHandler = std::function<void(const std::string& filePath, const std::string& error)>;
+
+    /// Cache used by every SqlTemplate of the process
+    static SqlTemplateCache& instance();
+
+    /// Keep loaded files until reload(); disabling also empties the cache
+    void setEnabled(bool enabled);
+    [[nodiscard]] bool enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Source of @p filePath, loaded on first use
+     * @throws SqlTemplateException if the file cannot be loaded
+     */
+    SourcePtr get(const std::string& filePath);
+
+    /**
+     * @brief Re-read @p filePath from disk and publish the new version
+     * @param error set to the parse error on failure
+     * @return false if the file could not be loaded; the cached version stays
+     *
+     * Reads the file even when a SqlAppletBundle is installed: an edited
+     * file is newer than the bundle. Also drops the file's entries from
+     * SqlResultCache. Does nothing while the cache is disabled.
+     */
+    bool reload(const std::string& filePath, std::string* error = nullptr);
+
+    /**
+     * @brief Load and validate every applet under @p appletPath
+     * @param appletPath applet directory with trailing separator
+     * @param onError called for each applet that fails to load
+     * @return number of applets that loaded
+     *
+     * Lists the installed SqlAppletBundle when there is one, else the
+     * *.sql files of the directory. Enabled, the cache keeps them;
+     * disabled, this only checks that their headers parse.
+     */
+    size_t preload(const std::string& appletPath, const ErrorHandler& onError = {});
+
+    void clear();
+    [[nodiscard]] size_t size() const;
+
+    /// Versions published by reload()
+    [[nodiscard]] uint64_t reloads() const noexcept { return m_reloads.load(std::memory_order_relaxed); }
+
+private:
+    using Snapshot = std::unordered_map<std::string, SourcePtr>;
+
+    /// Store @p source (or keep the cached one unless @p replace); returns what is cached
+    SourcePtr publish(const std::string& filePath, SourcePtr source, bool replace);
+
+    std::atomic<bool> m_enabled{false};
+    std::atomic<std::shared_ptr<const Snapshot>> m_snapshot{std::make_shared<const Snapshot>()};
+    std::mutex m_writeMutex;  ///< Serializes copy-and-publish
+    std::atomic<uint64_t> m_reloads{0};
+};
+
+#endif // SQLTEMPLATECACHE_H
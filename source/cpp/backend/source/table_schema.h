@@ -0,0 +1,322 @@
+/**
+ * @file table_schema.h
+ * @brief Compile-time table descriptors and the helpers derived from them
+ *
+ * A schema lists each column once: its name, its DataInfo type and the
+ * member of the domain struct that holds it. The column allow-list, the
+ * row mapper, template parameter binding and protobuf conversion are all
+ * generated from that list, so a new table needs one descriptor instead of
+ * a hand-written mapper per layer.
+ *
+ * @code
+ * struct PersonSchema {
+ *     using Row = Person;
+ *     static constexpr std::tuple columns{
+ *         schemaColumn("ID",   DataInfo::Int,    &Person::id,   SchemaFilter),
+ *         schemaColumn("NAME", DataInfo::String, &Person::name, SchemaFilter | SchemaWrite | SchemaTrim),
+ *     };
+ * };
+ *
+ * static constexpr SchemaAllowList<PersonSchema> PERSON_COLUMNS;
+ * std::vector<Person> rows = query.fetchAll<Person>(SchemaRowReader<PersonSchema>());
+ * @endcode
+ */
+
+#ifndef TABLE_SCHEMA_H
+#define TABLE_SCHEMA_H
+
+#include "column_allowlist.h"
+#include "sqltemplate.h"
+#include "TypeToStringFormatter.h"
+
+#include <SQLAPI.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// ============================================================================
+// Descriptor
+// ============================================================================
+
+/// Column properties beyond name and type
+enum SchemaFlags : unsigned {
+    SchemaNone   = 0,
+    SchemaFilter = 1u << 0,  ///< Allowed as a $COLUMN parameter (SchemaAllowList)
+    SchemaWrite  = 1u << 1,  ///< Bound by addSchemaParameters() for insert/update
+    SchemaTrim   = 1u << 2,  ///< CHAR column: trailing blanks are removed on read
+    SchemaBytes  = 1u << 3   ///< Binary column, read with asBytes()
+};
+
+/**
+ * @brief One column of a table descriptor
+ *
+ * @c name is the upper-case column name used by the applets. Supported
+ * member types are std::string, int, int64_t, double, bool and
+ * std::chrono::milliseconds (a date/time column; @c type selects the format).
+ */
+template <typename Row, typename T>
+struct SchemaColumn {
+    using Value = T;
+
+    std::string_view name;
+    DataInfo::Type type;
+    T Row::* member;
+    unsigned flags = SchemaNone;
+
+    [[nodiscard]] constexpr bool has(unsigned flag) const noexcept { return (flags & flag) != 0; }
+};
+
+template <typename Row, typename T>
+constexpr SchemaColumn<Row, T> schemaColumn(std::string_view name, DataInfo::Type type,
+                                            T Row::* member, unsigned flags = SchemaNone)
+{
+    return {name, type, member, flags};
+}
+
+/// Number of columns of @p Schema
+template <typename Schema>
+inline constexpr std::size_t schemaSize = std::tuple_size_v<std::remove_cvref_t<decltype(Schema::columns)>>;
+
+/// Call @p fn(column, index) for every column of @p Schema; index is an integral_constant
+template <typename Schema, typename Fn>
+constexpr void forEachColumn(Fn&& fn)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (fn(std::get<I>(Schema::columns), std::integral_constant<std::size_t, I>{}), ...);
+    }(std::make_index_sequence<schemaSize<Schema>>{});
+}
+
+/// Number of columns of @p Schema carrying every bit of @p Flags
+template <typename Schema, unsigned Flags = SchemaNone>
+consteval std::size_t schemaCount()
+{
+    std::size_t count = 0;
+    forEachColumn<Schema>([&](const auto& column, auto) {
+        count += (column.flags & Flags) == Flags ? 1 : 0;
+    });
+    return count;
+}
+
+/// Names of the columns of @p Schema carrying every bit of @p Flags, in declaration order
+template <typename Schema, unsigned Flags = SchemaNone>
+consteval std::array<std::string_view, schemaCount<Schema, Flags>()> schemaNames()
+{
+    std::array<std::string_view, schemaCount<Schema, Flags>()> names{};
+    std::size_t next = 0;
+    forEachColumn<Schema>([&](const auto& column, auto) {
+        if ((column.flags & Flags) == Flags) {
+            names[next++] = column.name;
+        }
+    });
+    return names;
+}
+
+// ============================================================================
+// Allow-list
+// ============================================================================
+
+/**
+ * @brief Allow-list of the SchemaFilter columns of @p Schema
+ */
+template <typename Schema>
+class SchemaAllowList : public PerfectHashAllowList<schemaCount<Schema, SchemaFilter>()> {
+public:
+    constexpr SchemaAllowList()
+        : PerfectHashAllowList<schemaCount<Schema, SchemaFilter>()>(schemaNames<Schema, SchemaFilter>())
+    {
+    }
+};
+
+// ============================================================================
+// Row mapping
+// ============================================================================
+
+/**
+ * @brief Maps result rows to Schema::Row by field ordinal
+ *
+ * The first row resolves each schema column to its position in the result
+ * set (one hash lookup per field); later rows are read by ordinal without
+ * name lookups. Columns missing from the result keep their default value,
+ * so one reader serves every SELECT list of the table. Use one reader per
+ * result set.
+ */
+template <typename Schema>
+class SchemaRowReader
+{
+public:
+    using Row = typename Schema::Row;
+
+    Row operator()(SACommand& cmd)
+    {
+        if (!m_resolved) {
+            resolve(cmd);
+        }
+        Row row;
+        forEachColumn<Schema>([&](const auto& column, auto index) {
+            if (const int field = m_fields[index]; field > 0) {
+                read(cmd.Field(field), column, row.*column.member);
+            }
+        });
+        return row;
+    }
+
+private:
+    static constexpr std::size_t N = schemaSize<Schema>;
+    static constexpr PerfectHashIndex<N> NAMES{schemaNames<Schema>()};
+
+    void resolve(SACommand& cmd)
+    {
+        const int count = cmd.FieldCount();
+        for (int i = 1; i <= count; ++i) {
+            std::string name = cmd.Field(i).Name().GetMultiByteChars();
+            for (char& c : name) {
+                c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+            }
+            const std::size_t index = NAMES.indexOf(name);
+            if (index < N && m_fields[index] == 0) {
+                m_fields[index] = i;
+            }
+        }
+        m_resolved = true;
+    }
+
+    template <typename Column>
+    static void read(SAField& field, const Column& column, std::string& value)
+    {
+        if (column.has(SchemaBytes)) {
+            // Explicit length: the bytes may contain nulls
+            SAString bytes = field.asBytes();
+            value.assign(bytes.GetMultiByteChars(), static_cast<size_t>(bytes.GetLength()));
+            return;
+        }
+        SAString text = field.asString();
+        if (column.has(SchemaTrim)) {
+            text.TrimRight();
+        }
+        value = text.GetMultiByteChars();
+    }
+
+    template <typename Column>
+    static void read(SAField& field, const Column&, int& value) { value = static_cast<int>(field.asLong()); }
+
+    template <typename Column>
+    static void read(SAField& field, const Column&, int64_t& value) { value = field.asInt64(); }
+
+    template <typename Column>
+    static void read(SAField& field, const Column&, double& value) { value = field.asDouble(); }
+
+    template <typename Column>
+    static void read(SAField& field, const Column&, bool& value) { value = field.asBool(); }
+
+    template <typename Column>
+    static void read(SAField& field, const Column& column, std::chrono::milliseconds& value)
+    {
+        value = TimeFormatHelper::stringTochronoSysSec(field.asString().GetMultiByteChars(), column.type);
+    }
+
+    std::array<int, N> m_fields{};  ///< 1-based field per column; 0 = not in the result
+    bool m_resolved = false;
+};
+
+// ============================================================================
+// Parameter binding
+// ============================================================================
+
+/**
+ * @brief Add every SchemaWrite column of @p row as a template parameter
+ *
+ * Each parameter is named after its column; date/time columns are
+ * formatted according to their DataInfo type.
+ */
+template <typename Schema>
+void addSchemaParameters(SqlTemplate& tpl, const typename Schema::Row& row)
+{
+    forEachColumn<Schema>([&](const auto& column, auto) {
+        if (!column.has(SchemaWrite)) {
+            return;
+        }
+        const auto& value = row.*column.member;
+        using Value = std::remove_cvref_t<decltype(value)>;
+        if constexpr (std::is_same_v<Value, std::chrono::milliseconds>) {
+            tpl.addParameter(column.name, value, column.type);
+        } else if constexpr (std::is_same_v<Value, std::string>) {
+            tpl.addParameter(column.name, value.c_str());
+        } else {
+            tpl.addParameter(column.name, value);
+        }
+    });
+}
+
+// ============================================================================
+// Protobuf conversion
+// ============================================================================
+
+/**
+ * @brief Binding of a schema column to a protobuf message field
+ *
+ * @c getter and @c setter are the generated accessors of the field, e.g.
+ * &Company::name and &Company::set_name. Date/time columns are carried as
+ * milliseconds since the epoch.
+ */
+template <typename Row, typename T, typename Getter, typename Setter>
+struct ProtoField {
+    T Row::* member;
+    Getter getter;
+    Setter setter;
+};
+
+template <typename Row, typename T, typename Getter, typename Setter>
+constexpr ProtoField<Row, T, Getter, Setter> protoField(T Row::* member, Getter getter, Setter setter)
+{
+    return {member, getter, setter};
+}
+
+/// Select the const std::string& overload of a generated string setter
+template <typename Proto>
+constexpr auto protoStringSetter(void (Proto::*setter)(const std::string&))
+{
+    return setter;
+}
+
+/// Copy the fields listed in @p fields (a tuple of ProtoField) from @p row to @p proto
+template <typename Row, typename Proto, typename Fields>
+void copyToProto(const Fields& fields, const Row& row, Proto& proto)
+{
+    std::apply([&](const auto&... field) {
+        auto copy = [&](const auto& f) {
+            const auto& value = row.*f.member;
+            if constexpr (std::is_same_v<std::remove_cvref_t<decltype(value)>, std::chrono::milliseconds>) {
+                (proto.*f.setter)(value.count());
+            } else {
+                (proto.*f.setter)(value);
+            }
+        };
+        (copy(field), ...);
+    }, fields);
+}
+
+/// Copy the fields listed in @p fields (a tuple of ProtoField) from @p proto to @p row
+template <typename Row, typename Proto, typename Fields>
+void copyFromProto(const Fields& fields, const Proto& proto, Row& row)
+{
+    std::apply([&](const auto&... field) {
+        auto copy = [&](const auto& f) {
+            auto& value = row.*f.member;
+            using Value = std::remove_cvref_t<decltype(value)>;
+            if constexpr (std::is_same_v<Value, std::chrono::milliseconds>) {
+                value = std::chrono::milliseconds((proto.*f.getter)());
+            } else {
+                value = static_cast<Value>((proto.*f.getter)());
+            }
+        };
+        (copy(field), ...);
+    }, fields);
+}
+
+#endif // TABLE_SCHEMA_H
@@ -0,0 +1,111 @@
+/**
+ * @file SavepointScopeTests.cpp
+ * @brief Tests for SavepointScope nested in a TransactionScope (SQLite in-memory)
+ *
+ * Verifies that rolling back a savepoint undoes only the work done since it
+ * was set, and that the outer transaction stays usable and commits the rest.
+ */
+
+#include "transactionscope.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+class SavepointScopeTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_conn.connect();
+        exec("CREATE TABLE items(id INTEGER PRIMARY KEY)");
+    }
+
+    void exec(const char* sql)
+    {
+        SACommand cmd(m_conn.connectionSa(), SAString(sql));
+        cmd.Execute();
+    }
+
+    std::vector<long> ids()
+    {
+        std::vector<long> result;
+        SACommand cmd(m_conn.connectionSa(), _TSA("SELECT id FROM items ORDER BY id"));
+        cmd.Execute();
+        while (cmd.FetchNext()) {
+            result.push_back(cmd.Field(1).asLong());
+        }
+        return result;
+    }
+
+    SqlConnection m_conn{SA_SQLite_Client, ":memory:", "admin", "pass"};
+};
+
+/**
+ * @test A failing item is rolled back alone; the batch commits the rest
+ */
+TEST_F(SavepointScopeTest, FailedItem_RolledBackAlone)
+{
+    {
+        TransactionScope tx(m_conn);
+        for (const char* sql : {"INSERT INTO items VALUES(1)",
+                                "INSERT INTO items VALUES(1)",   // duplicate key
+                                "INSERT INTO items VALUES(3)"}) {
+            try {
+                SavepointScope sp(m_conn);
+                exec(sql);
+                sp.release();
+            } catch (const SAException&) {
+                // only this item is undone
+            }
+        }
+        tx.commit();
+    }
+
+    EXPECT_EQ(ids(), (std::vector<long>{1, 3}));
+}
+
+/**
+ * @test An unreleased savepoint rolls back on destruction
+ */
+TEST_F(SavepointScopeTest, Destructor_RollsBackUnreleased)
+{
+    {
+        TransactionScope tx(m_conn);
+        exec("INSERT INTO items VALUES(1)");
+        {
+            SavepointScope sp(m_conn);
+            exec("INSERT INTO items VALUES(2)");
+            EXPECT_TRUE(sp.isActive());
+        }
+        tx.commit();
+    }
+
+    EXPECT_EQ(ids(), std::vector<long>{1});
+}
+
+/**
+ * @test Savepoints nest; releasing the outer keeps the released inner work
+ */
+TEST_F(SavepointScopeTest, NestedSavepoints)
+{
+    {
+        TransactionScope tx(m_conn);
+        SavepointScope outer(m_conn);
+        exec("INSERT INTO items VALUES(1)");
+        {
+            SavepointScope inner(m_conn);
+            EXPECT_NE(inner.name(), outer.name());
+            exec("INSERT INTO items VALUES(2)");
+            inner.release();
+        }
+        {
+            SavepointScope inner(m_conn);
+            exec("INSERT INTO items VALUES(3)");
+            inner.rollback();
+            EXPECT_FALSE(inner.isActive());
+        }
+        outer.release();
+        tx.commit();
+    }
+
+    EXPECT_EQ(ids(), (std::vector<long>{1, 2}));
+}
@@ -0,0 +1,153 @@
+/**
+ * @file SqlAppletBundleTests.cpp
+ * @brief Tests for SqlAppletBundle packing, mapping and SqlTemplate lookup
+ *
+ * Packs the test applets into a temporary bundle and verifies lookups,
+ * staleness, rejection of malformed files, and that SqlTemplate resolves
+ * installed applets without touching the applet directory.
+ */
+#include "sqlappletbundle.h"
+#include "sqltemplate.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+/**
+ * @class SqlAppletBundleTest
+ * @brief Packs the test applet directory into a temporary bundle
+ */
+class SqlAppletBundleTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_bundlePath = (fs::temp_directory_path() / "medicon_applets_test.bundle").string();
+        SqlAppletBundle::pack(ALL_BACKEND_TEST_APPDATA_PATH, m_bundlePath);
+    }
+
+    void TearDown() override
+    {
+        SqlAppletBundle::uninstall();
+        fs::remove(m_bundlePath);
+    }
+
+    static std::string readFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    std::string m_bundlePath;
+};
+
+/**
+ * @test Every .sql file is bundled byte for byte; other files are not
+ */
+TEST_F(SqlAppletBundleTest, Pack_BundlesSqlFilesOnly)
+{
+    auto bundle = SqlAppletBundle::open(m_bundlePath);
+
+    auto text = bundle->find("insert_user_test.sql");
+    ASSERT_TRUE(text.has_value());
+    EXPECT_EQ(*text, readFile(std::string(ALL_BACKEND_TEST_APPDATA_PATH) + "insert_user_test.sql"));
+
+    EXPECT_FALSE(bundle->find("test.xml").has_value());
+    EXPECT_FALSE(bundle->find("missing.sql").has_value());
+
+    const auto names = bundle->names();
+    EXPECT_EQ(names.size(), bundle->size());
+    EXPECT_TRUE(std::is_sorted(names.begin(), names.end()));
+}
+
+/**
+ * @test A fresh bundle is not stale; a missing one is
+ */
+TEST_F(SqlAppletBundleTest, IsStale_FreshOrMissingBundle)
+{
+    EXPECT_FALSE(SqlAppletBundle::isStale(ALL_BACKEND_TEST_APPDATA_PATH, m_bundlePath));
+    EXPECT_TRUE(SqlAppletBundle::isStale(ALL_BACKEND_TEST_APPDATA_PATH, m_bundlePath + ".missing"));
+}
+
+/**
+ * @test Changed, added and removed applets make the bundle stale even when
+ *       the files carry older modification times than the bundle
+ */
+TEST_F(SqlAppletBundleTest, IsStale_ComparesContentsNotModificationTimes)
+{
+    const fs::path dir = fs::temp_directory_path() / "medicon_applets_stale_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string appletDir = dir.string() + "/";
+    const std::string bundlePath = (dir / "applets.bundle").string();
+    auto writeApplet = [&](const std::string& name, const std::string& text) {
+        std::ofstream(dir / name, std::ios::binary) << text;
+        // As restored by a rollback deploy, rsync -a, cp -p or tar
+        fs::last_write_time(dir / name, fs::last_write_time(dir) - std::chrono::hours(24));
+    };
+
+    writeApplet("a.sql", "SELECT 1");
+    SqlAppletBundle::pack(appletDir, bundlePath);
+    EXPECT_FALSE(SqlAppletBundle::isStale(appletDir, bundlePath));
+
+    writeApplet("a.sql", "SELECT 2");  // same size, older mtime
+    EXPECT_TRUE(SqlAppletBundle::isStale(appletDir, bundlePath));
+
+    SqlAppletBundle::pack(appletDir, bundlePath);
+    writeApplet("b.sql", "SELECT 3");
+    EXPECT_TRUE(SqlAppletBundle::isStale(appletDir, bundlePath));
+
+    SqlAppletBundle::pack(appletDir, bundlePath);
+    fs::remove(dir / "a.sql");
+    EXPECT_TRUE(SqlAppletBundle::isStale(appletDir, bundlePath));
+
+    fs::remove_all(dir);
+}
+
+/**
+ * @test Files that are not bundles are rejected
+ */
+TEST_F(SqlAppletBundleTest, Open_RejectsMalformedFiles)
+{
+    EXPECT_THROW(SqlAppletBundle::open(m_bundlePath + ".missing"), SqlAppletBundleException);
+    EXPECT_THROW(SqlAppletBundle::open(std::string(ALL_BACKEND_TEST_APPDATA_PATH) + "test.sql"),
+                 SqlAppletBundleException);
+
+    // Valid header, index pointing past the end of the file
+    const std::string full = readFile(m_bundlePath);
+    const std::string truncatedPath = m_bundlePath + ".truncated";
+    {
+        std::ofstream out(truncatedPath, std::ios::binary);
+        out << full.substr(0, full.size() / 2);
+    }
+    EXPECT_THROW(SqlAppletBundle::open(truncatedPath), SqlAppletBundleException);
+    fs::remove(truncatedPath);
+}
+
+/**
+ * @test SqlTemplate reads installed applets from the bundle, not the disk
+ */
+TEST_F(SqlAppletBundleTest, Install_SqlTemplateResolvesFromBundle)
+{
+    // The directory does not exist; only the bundle can serve it
+    const std::string appletPath = "/nonexistent/medicon/sql-applets/";
+    SqlAppletBundle::install(SqlAppletBundle::open(m_bundlePath), appletPath);
+
+    SqlTemplate tpl(appletPath + "select_users_cached_test.sql");
+    tpl.addParameter("min_age", 18);
+    ASSERT_NO_THROW(tpl.parse());
+    EXPECT_EQ(tpl.timeout(), std::chrono::milliseconds(500));
+    EXPECT_NE(tpl.sql().find("FROM users"), std::string::npos);
+
+    // Names outside the bundle still go to the filesystem
+    SqlTemplate missing(appletPath + "missing.sql");
+    EXPECT_THROW(missing.parse(), SqlTemplateException);
+
+    SqlAppletBundle::uninstall();
+    SqlTemplate uninstalled(appletPath + "select_users_cached_test.sql");
+    EXPECT_THROW(uninstalled.parse(), SqlTemplateException);
+}
@@ -0,0 +1,194 @@
+/**
+ * @file SqlAppletCodegenTests.cpp
+ * @brief Tests for the wrappers generated by sql_applet_codegen
+ *
+ * Verifies that the generated SQL matches what SqlTemplate builds at
+ * runtime, that @param defaults become typed members, that directives
+ * become constants, and that bind() executes against SQLite in-memory.
+ * The provider applets are generated too (provider_sql_applets.h) and
+ * checked against SqlTemplate, as provider_lib uses them with
+ * MEDICON_COMPILED_APPLETS.
+ */
+#include "provider_sql_applets.h"
+#include "sql_applets.h"
+#include "sqlquery.h"
+#include "sqlconnection.h"
+#include "sqltemplate.h"
+#include "gtest/gtest.h"
+
+#include <type_traits>
+
+namespace {
+
+std::string testApplet(std::string_view fileName)
+{
+    return std::string(ALL_BACKEND_TEST_APPDATA_PATH) + std::string(fileName);
+}
+
+std::string providerApplet(std::string_view fileName)
+{
+    return std::string(ALL_PROJECT_APPDATA_PATH) + "provider/sql-applets/" + std::string(fileName);
+}
+
+template <typename Applet>
+std::string providerTemplateSql()
+{
+    SqlTemplate sqlTemplate(providerApplet(Applet::FILE_NAME));
+    sqlTemplate.parse();
+    return sqlTemplate.sql();
+}
+
+} // namespace
+
+/**
+ * @test Generated SQL is identical to the SQL SqlTemplate parses at runtime
+ */
+TEST(SqlAppletCodegenTest, Sql_MatchesSqlTemplate)
+{
+    using namespace sql_applets;
+
+    SqlTemplate insert(testApplet(InsertUserTest::FILE_NAME));
+    insert.parse();
+    EXPECT_EQ(InsertUserTest::sql(), insert.sql());
+
+    SqlTemplate select(testApplet(SelectUsersCachedTest::FILE_NAME));
+    select.parse();
+    EXPECT_EQ(SelectUsersCachedTest::sql(), select.sql());
+}
+
+/**
+ * @test SEGMENTS and PLACEHOLDERS split the SQL around each :NAME marker
+ */
+TEST(SqlAppletCodegenTest, Segments_SplitAroundPlaceholders)
+{
+    using sql_applets::InsertUserTest;
+
+    ASSERT_EQ(InsertUserTest::SEGMENTS.size(), InsertUserTest::PLACEHOLDERS.size() + 1);
+    EXPECT_EQ(InsertUserTest::PLACEHOLDERS[0], ":id");
+    EXPECT_EQ(InsertUserTest::PLACEHOLDERS[1], ":name");
+    EXPECT_EQ(InsertUserTest::PLACEHOLDERS[2], ":age");
+
+    std::string joined(InsertUserTest::SEGMENTS[0]);
+    for (size_t i = 0; i < InsertUserTest::PLACEHOLDERS.size(); ++i) {
+        joined += InsertUserTest::PLACEHOLDERS[i];
+        joined += InsertUserTest::SEGMENTS[i + 1];
+    }
+    EXPECT_EQ(joined, InsertUserTest::SQL);
+}
+
+/**
+ * @test @param types and defaults become typed members
+ */
+TEST(SqlAppletCodegenTest, Params_AreTypedWithDefaults)
+{
+    sql_applets::Test applet;
+
+    static_assert(std::is_same_v<decltype(applet.Height), long>);
+    static_assert(std::is_same_v<decltype(applet.Money), double>);
+    static_assert(std::is_same_v<decltype(applet.Name), std::string>);
+    static_assert(std::is_same_v<decltype(applet.BirthDate), std::string>);
+
+    EXPECT_EQ(applet.Name, "Givi");
+    EXPECT_EQ(applet.BirthDate, "2007-01-20");
+    EXPECT_EQ(applet.Height, 175);
+    EXPECT_DOUBLE_EQ(applet.Money, 122.123);
+}
+
+/**
+ * @test @timeout and @prefetch become compile-time constants
+ */
+TEST(SqlAppletCodegenTest, Directives_AreConstants)
+{
+    using namespace sql_applets;
+
+    static_assert(SelectUsersCachedTest::TIMEOUT == std::chrono::milliseconds(500));
+    static_assert(SelectUsersCachedTest::PREFETCH_ROWS == 100);
+    static_assert(!InsertUserTest::TIMEOUT.has_value());
+    static_assert(InsertUserTest::PREFETCH_ROWS == 0);
+}
+
+/**
+ * @test bind() and executeWithTimeout() run the wrappers against SQLite
+ */
+TEST(SqlAppletCodegenTest, Bind_ExecutesOnSqlite)
+{
+    using namespace sql_applets;
+
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "codegenuser", "codegenpass");
+    conn.connect();
+    SqlDirectCommand create(conn, SAString("CREATE TABLE users(id INTEGER, name TEXT, age INTEGER)"));
+    create.execute();
+
+    const std::pair<const char*, long> users[] = {{"Alice", 30}, {"Bob", 17}, {"Carol", 45}};
+    long id = 0;
+    for (const auto& [name, age] : users) {
+        InsertUserTest insert;
+        insert.id = ++id;
+        insert.name = name;
+        insert.age = age;
+
+        SqlDirectCommand cmd(conn, SAString(InsertUserTest::SQL.data()));
+        insert.bind(cmd);
+        cmd.executeWithTimeout(InsertUserTest::TIMEOUT);
+    }
+
+    SelectUsersCachedTest select;
+    select.min_age = 18;
+    select.label = "adult";
+
+    SqlDirectQuery query(conn, SAString(SelectUsersCachedTest::SQL.data()));
+    select.bind(query);
+    query.executeWithTimeout(SelectUsersCachedTest::TIMEOUT);
+
+    std::vector<std::string> names;
+    while (query.query()) {
+        names.emplace_back(query.Field("name").asString().GetMultiByteChars());
+        EXPECT_STREQ(query.Field("label").asString().GetMultiByteChars(), "adult");
+    }
+    EXPECT_EQ(names, (std::vector<std::string>{"Alice", "Carol"}));
+}
+
+/**
+ * @test A string member holding "NULL" binds SQL NULL, as SqlCommand does
+ */
+TEST(SqlAppletCodegenTest, Bind_NullStringBindsSqlNull)
+{
+    using sql_applets::InsertUserTest;
+
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "codegenuser", "codegenpass");
+    conn.connect();
+    SqlDirectCommand create(conn, SAString("CREATE TABLE users(id INTEGER, name TEXT, age INTEGER)"));
+    create.execute();
+
+    InsertUserTest insert;
+    insert.id = 1;
+    insert.name = "NULL";
+    insert.age = 30;
+
+    SqlDirectCommand cmd(conn, SAString(InsertUserTest::SQL.data()));
+    insert.bind(cmd);
+    EXPECT_TRUE(cmd.Param("name").isNull());
+    cmd.execute();
+
+    SqlDirectQuery query(conn, SAString("SELECT COUNT(*) AS nulls FROM users WHERE name IS NULL"));
+    query.execute();
+    ASSERT_TRUE(query.query());
+    EXPECT_EQ(query.Field("nulls").asLong(), 1);
+}
+
+/**
+ * @test The provider applets provider_lib compiles with MEDICON_COMPILED_APPLETS
+ * generate the SQL SqlTemplate parses at runtime
+ */
+TEST(SqlAppletCodegenTest, ProviderApplets_MatchSqlTemplate)
+{
+    using namespace sql_applets;
+
+    EXPECT_EQ(CompanySelectByUid::sql(), providerTemplateSql<CompanySelectByUid>());
+    EXPECT_EQ(CompanyInsert::sql(), providerTemplateSql<CompanyInsert>());
+    EXPECT_EQ(CompanyUpdate::sql(), providerTemplateSql<CompanyUpdate>());
+    EXPECT_EQ(CompanyDelete::sql(), providerTemplateSql<CompanyDelete>());
+    EXPECT_EQ(CompanyLockRow::sql(), providerTemplateSql<CompanyLockRow>());
+    EXPECT_EQ(CompanySync::sql(), providerTemplateSql<CompanySync>());
+    EXPECT_EQ(CompanyTombstoneInsert::sql(), providerTemplateSql<CompanyTombstoneInsert>());
+}
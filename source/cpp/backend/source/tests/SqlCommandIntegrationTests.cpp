@@ -358,3 +358,20 @@ TEST_F(SqlCommandTemplateIntegrationTest, Execute_AllParams_ThrowsSAException)
 
     EXPECT_THROW(cmd.execute(), SAException);
 }
+
+/**
+ * @test Verify ARRAY_* parameters expand to an IN-list on a SQLite connection
+ */
+TEST_F(SqlCommandTemplateIntegrationTest, ArrayParam_ExpandedOnSqlite)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "admin", "pass");
+    conn.connect();
+
+    SqlCommand cmd(conn, ALL_BACKEND_TEST_APPDATA_PATH "select_users_by_ids_test.sql");
+    cmd.addParameter("ids", std::vector<int>{4, 8});
+    cmd.addParameter("names", std::vector<std::string>{"Alice"});
+
+    std::string debug = cmd.getSqlWithParameters();
+    EXPECT_NE(debug.find("id IN (4, 8)"), std::string::npos) << debug;
+    EXPECT_NE(debug.find("name IN ('Alice')"), std::string::npos) << debug;
+}
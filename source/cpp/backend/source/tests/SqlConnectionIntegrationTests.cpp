@@ -37,6 +37,26 @@ TEST_F(SqlConnectionIntegrationTest, SQLite_ConnectDisconnect_Success)
     EXPECT_FALSE(conn.isConnected());
 }
 
+/**
+ * @test Keepalive set before connect() is kept across reconnects
+ *
+ * SQLite has no socket to configure, so setKeepalive() reports false;
+ * connect() must still succeed every time it reapplies the settings.
+ */
+TEST_F(SqlConnectionIntegrationTest, SQLite_KeepaliveBeforeConnect_Reconnects)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "dbuser", "dbpass");
+    EXPECT_FALSE(conn.setKeepalive(60, 10, 3));
+
+    ASSERT_NO_THROW(conn.connect());
+    EXPECT_TRUE(conn.isConnected());
+    EXPECT_FALSE(conn.setKeepalive(60, 10, 3));
+
+    conn.disconnect();
+    ASSERT_NO_THROW(conn.connect());
+    EXPECT_TRUE(conn.isConnected());
+}
+
 /**
  * @test Verify table creation and basic SQL operations
  */
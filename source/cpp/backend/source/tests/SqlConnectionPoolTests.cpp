@@ -0,0 +1,196 @@
+/**
+ * @file SqlConnectionPoolTests.cpp
+ * @brief Tests for SqlConnectionPool using SQLite in-memory databases
+ *
+ * Verifies lease reuse, the size bound, broken connections, transaction
+ * cleanup on return, the health cooldown after failures and idle checks.
+ */
+
+#include "sqlconnectionpool.h"
+#include "transactionscope.h"
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+/**
+ * @test A returned connection is reused instead of opening a new one
+ */
+TEST(SqlConnectionPoolTest, Acquire_ReusesReturnedConnection)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 2);
+
+    SqlConnection* first = nullptr;
+    {
+        auto conn = pool.acquire();
+        first = &*conn;
+        EXPECT_TRUE(conn->isConnected());
+        EXPECT_EQ(pool.size(), 1u);
+        EXPECT_EQ(pool.idleCount(), 0u);
+    }
+    EXPECT_EQ(pool.idleCount(), 1u);
+
+    auto again = pool.acquire();
+    EXPECT_EQ(&*again, first);
+    EXPECT_EQ(pool.size(), 1u);
+}
+
+/**
+ * @test No more than maxSize connections are open; waiters time out
+ */
+TEST(SqlConnectionPoolTest, Acquire_TimesOutWhenExhausted)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    auto held = pool.acquire();
+
+    EXPECT_THROW(pool.acquire(20ms), std::runtime_error);
+    EXPECT_EQ(pool.size(), 1u);
+}
+
+/**
+ * @test A waiter gets the connection as soon as it is returned
+ */
+TEST(SqlConnectionPoolTest, Acquire_WakesWhenConnectionReturned)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    auto held = std::make_unique<SqlConnectionPool::Lease>(pool.acquire());
+
+    std::thread releaser([&held] {
+        std::this_thread::sleep_for(20ms);
+        held.reset();
+    });
+
+    EXPECT_NO_THROW(pool.acquire(5s));
+    releaser.join();
+}
+
+/**
+ * @test Broken connections are dropped and free their slot
+ */
+TEST(SqlConnectionPoolTest, MarkBroken_DropsConnection)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    {
+        auto conn = pool.acquire();
+        conn.markBroken();
+    }
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.idleCount(), 0u);
+    EXPECT_NO_THROW(pool.acquire(20ms));
+}
+
+/**
+ * @test An uncommitted transaction is rolled back and auto-commit restored
+ */
+TEST(SqlConnectionPoolTest, Return_RollsBackOpenTransaction)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    {
+        auto conn = pool.acquire();
+        SACommand(conn->connectionSa(), _TSA("CREATE TABLE t(id INTEGER)")).Execute();
+    }
+    {
+        auto conn = pool.acquire();
+        conn->setAutoCommit(false);
+        SACommand(conn->connectionSa(), _TSA("INSERT INTO t VALUES(1)")).Execute();
+        // returned without commit
+    }
+
+    auto conn = pool.acquire();
+    EXPECT_EQ(conn->connectionSa()->AutoCommit(), SA_AutoCommitOn);
+    SACommand count(conn->connectionSa(), _TSA("SELECT COUNT(*) FROM t"));
+    count.Execute();
+    ASSERT_TRUE(count.FetchNext());
+    EXPECT_EQ(count.Field(1).asLong(), 0);
+}
+
+/**
+ * @test A committed TransactionScope leaves the connection in auto-commit
+ */
+TEST(SqlConnectionPoolTest, Return_AfterCommitRestoresAutoCommit)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    {
+        auto conn = pool.acquire();
+        TransactionScope tx(*conn);
+        SACommand(conn->connectionSa(), _TSA("CREATE TABLE t(id INTEGER)")).Execute();
+        tx.commit();
+    }
+
+    auto conn = pool.acquire();
+    EXPECT_EQ(conn->connectionSa()->AutoCommit(), SA_AutoCommitOn);
+}
+
+/**
+ * @test A failed connect marks the pool unhealthy for the cooldown
+ */
+TEST(SqlConnectionPoolTest, ConnectFailure_MarksPoolUnhealthy)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, "/nonexistent-dir/medicon.db", "admin", "pass", 1, 50ms);
+    ASSERT_TRUE(pool.isHealthy());
+
+    EXPECT_THROW(pool.acquire(), SAException);
+    EXPECT_FALSE(pool.isHealthy());
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_TRUE(pool.isHealthy(SqlConnectionPool::Clock::now() + 100ms));
+}
+
+/**
+ * @test warmUp() leaves the requested connections open and idle
+ */
+TEST(SqlConnectionPoolTest, WarmUp_OpensIdleConnections)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 3);
+
+    EXPECT_EQ(pool.warmUp(2), 2u);
+    EXPECT_EQ(pool.idleCount(), 2u);
+
+    // Capped at maxSize; already open connections count
+    EXPECT_EQ(pool.warmUp(10), 3u);
+    EXPECT_EQ(pool.idleCount(), 3u);
+}
+
+/**
+ * @test warmUp() reports a failed connect
+ */
+TEST(SqlConnectionPoolTest, WarmUp_ThrowsWhenConnectFails)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, "/nonexistent-dir/medicon.db", "admin", "pass", 2, 50ms);
+
+    EXPECT_THROW(pool.warmUp(2), SAException);
+    EXPECT_EQ(pool.size(), 0u);
+}
+
+/**
+ * @test checkIdle() pings connections idle long enough and keeps live ones
+ */
+TEST(SqlConnectionPoolTest, CheckIdle_KeepsLiveConnections)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 2);
+    pool.warmUp(2);
+
+    EXPECT_EQ(pool.checkIdle(1h), 0u);
+    EXPECT_EQ(pool.checkIdle(0ms), 0u);
+    EXPECT_EQ(pool.idleCount(), 2u);
+    EXPECT_EQ(pool.size(), 2u);
+}
+
+/**
+ * @test A connection that went away while idle is reconnected by checkIdle()
+ */
+TEST(SqlConnectionPoolTest, CheckIdle_ReconnectsDeadConnection)
+{
+    SqlConnectionPool pool(SA_SQLite_Client, ":memory:", "admin", "pass", 1);
+    SqlConnection* first = nullptr;
+    {
+        auto conn = pool.acquire();
+        first = &*conn;
+        conn->disconnect();
+    }
+
+    EXPECT_EQ(pool.checkIdle(0ms), 1u);
+    EXPECT_TRUE(first->isConnected());
+    EXPECT_EQ(pool.idleCount(), 1u);
+}
@@ -502,3 +502,103 @@ TEST_F(SqlQueryIntegrationTest, SqlDirectQuery_ComplexWhereClause_FiltersCorrect
  * Tests that use SqlQuery with applets may skip if applet XML files are not available.
  * To enable full testing, create the required applet files in the test app-data directory.
  */
+
+// ============================================================================
+// SqlQuery::fetchAll() with a "-- @cache" template
+// ============================================================================
+
+/**
+ * @test Cached rows are reused for the same key and refetched for another
+ */
+TEST_F(SqlQueryIntegrationTest, SqlQuery_FetchAll_CachedTemplate_ReusesRows)
+{
+    SqlResultCache::instance().clear();
+
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "cacheuser", "cachepass");
+    conn.connect();
+    SqlDirectCommand(conn, SAString("CREATE TABLE users(id INTEGER, name TEXT, age INTEGER)")).execute();
+    SqlDirectCommand(conn, SAString("INSERT INTO users VALUES(1, 'Alice', 30)")).execute();
+
+    auto fetchIds = [&conn](int minAge, const char* label) {
+        SqlQuery query(conn, ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+        query.addParameter("min_age", minAge);
+        query.addParameter("label", label);
+        return query.fetchAll<long>([](SACommand& row) { return row.Field("id").asLong(); });
+    };
+
+    EXPECT_EQ(fetchIds(18, "first"), std::vector<long>{1});
+
+    SqlDirectCommand(conn, SAString("INSERT INTO users VALUES(2, 'Bob', 40)")).execute();
+
+    // Same key (label is not part of it): served from the cache
+    EXPECT_EQ(fetchIds(18, "second"), std::vector<long>{1});
+    // Different key: executed
+    EXPECT_EQ(fetchIds(20, "first"), (std::vector<long>{1, 2}));
+
+    SqlResultCache::instance().invalidate(ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+    EXPECT_EQ(fetchIds(18, "first"), (std::vector<long>{1, 2}));
+
+    SqlResultCache::instance().clear();
+}
+
+
+// ============================================================================
+// Streaming: rows() range, prefetch and server cursor
+// ============================================================================
+
+static_assert(std::input_iterator<SqlDirectQuery::RowRange::iterator>);
+
+/**
+ * @test rows() visits every row once in a range-for
+ */
+TEST_F(SqlQueryIntegrationTest, SqlDirectQuery_RowsRange_VisitsEveryRow)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "rangeuser", "rangepass");
+    conn.connect();
+    SqlDirectCommand(conn, SAString("CREATE TABLE users(id INTEGER, name TEXT)")).execute();
+    SqlDirectCommand(conn, SAString("INSERT INTO users VALUES(1, 'Alice'), (2, 'Bob'), (3, 'Carol')")).execute();
+
+    SqlDirectQuery query(conn, SAString("SELECT id FROM users ORDER BY id"));
+    std::vector<long> ids;
+    for (SqlDirectQuery& row : query.rows()) {
+        ids.push_back(row.Field(1).asLong());
+    }
+    EXPECT_EQ(ids, (std::vector<long>{1, 2, 3}));
+
+    SqlDirectQuery empty(conn, SAString("SELECT id FROM users WHERE id > 10"));
+    auto range = empty.rows();
+    EXPECT_TRUE(range.begin() == range.end());
+}
+
+/**
+ * @test Prefetch and server cursor settings do not change the rows
+ *
+ * SQLite has no server-side cursors: setServerCursor() only sets the
+ * prefetch size there.
+ */
+TEST_F(SqlQueryIntegrationTest, SqlQuery_ServerCursorOnSqlite_StreamsAllRows)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "cursoruser", "cursorpass");
+    conn.connect();
+    SqlDirectCommand(conn, SAString("CREATE TABLE users(id INTEGER, name TEXT, age INTEGER)")).execute();
+    SqlDirectCommand(conn, SAString(
+        "INSERT INTO users VALUES(1, 'Alice', 30), (2, 'Bob', 17), (3, 'Carol', 45)")).execute();
+
+    SqlQuery query(conn, ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+    query.setServerCursor(2);
+    query.addParameter("min_age", 18);
+
+    std::vector<long> ids;
+    for (SqlDirectQuery& row : query.rows()) {
+        ids.push_back(row.Field("id").asLong());
+    }
+    EXPECT_EQ(ids, (std::vector<long>{1, 3}));
+
+    SqlDirectQuery direct(conn, SAString("SELECT id FROM users ORDER BY id"));
+    direct.setPrefetchRows(1);
+    int count = 0;
+    while (direct.query()) {
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+}
@@ -0,0 +1,176 @@
+/**
+ * @file SqlTemplateCacheTests.cpp
+ * @brief Tests for SqlTemplateCache and SqlAppletWatcher hot reload
+ *
+ * Works on a copy of a test applet in a temporary directory and verifies
+ * that loads are shared, that a reload publishes a new version while
+ * existing templates keep theirs, that a broken edit keeps the previous
+ * version, and (on Linux) that the watcher picks up edits by itself.
+ */
+#include "sqlappletwatcher.h"
+#include "sqltemplatecache.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/**
+ * @class SqlTemplateCacheTest
+ * @brief Enables the process-wide cache over a scratch applet directory
+ */
+class SqlTemplateCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_dir = fs::temp_directory_path() / "medicon_template_cache_test";
+        fs::create_directories(m_dir);
+        m_filePath = (m_dir / "select_users.sql").string();
+        writeApplet("SELECT id FROM users WHERE age >= :min_age");
+        SqlTemplateCache::instance().setEnabled(true);
+    }
+
+    void TearDown() override
+    {
+        SqlTemplateCache::instance().setEnabled(false);
+        fs::remove_all(m_dir);
+    }
+
+    void writeApplet(const std::string& body, const std::string& header = "-- @param min_age NUMERIC default=0")
+    {
+        // Write through a temporary file and rename, as editors do
+        const fs::path temp = m_dir / "select_users.sql.tmp";
+        {
+            std::ofstream out(temp);
+            out << "-- select_users.sql\n" << header << "\n\n" << body << "\n";
+        }
+        fs::rename(temp, m_filePath);
+    }
+
+    std::string parsedSql()
+    {
+        SqlTemplate tpl(m_filePath);
+        tpl.parse();
+        return tpl.sql();
+    }
+
+    fs::path m_dir;
+    std::string m_filePath;
+};
+
+/**
+ * @test Enabled, a file is loaded once and shared
+ */
+TEST_F(SqlTemplateCacheTest, Get_SharesOneSource)
+{
+    auto& cache = SqlTemplateCache::instance();
+    auto first = cache.get(m_filePath);
+    auto second = cache.get(m_filePath);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // Edits without reload() are not seen
+    writeApplet("SELECT id, name FROM users WHERE age >= :min_age");
+    EXPECT_EQ(parsedSql(), "SELECT id FROM users WHERE age >= :min_age\n");
+}
+
+/**
+ * @test reload() publishes a new version; a parsed template keeps its own
+ */
+TEST_F(SqlTemplateCacheTest, Reload_PublishesNewVersion)
+{
+    SqlTemplate before(m_filePath);
+    before.parse();
+
+    writeApplet("SELECT id, name FROM users WHERE age >= :min_age");
+    ASSERT_TRUE(SqlTemplateCache::instance().reload(m_filePath));
+
+    EXPECT_EQ(parsedSql(), "SELECT id, name FROM users WHERE age >= :min_age\n");
+    before.parse();
+    EXPECT_EQ(before.sql(), "SELECT id FROM users WHERE age >= :min_age\n");
+}
+
+/**
+ * @test A broken edit is rejected and the previous version stays
+ */
+TEST_F(SqlTemplateCacheTest, Reload_ParseErrorKeepsPreviousVersion)
+{
+    const auto previous = SqlTemplateCache::instance().get(m_filePath);
+
+    writeApplet("SELECT 1", "-- @prefetch none");
+    std::string error;
+    EXPECT_FALSE(SqlTemplateCache::instance().reload(m_filePath, &error));
+    EXPECT_NE(error.find("@prefetch"), std::string::npos);
+    EXPECT_EQ(SqlTemplateCache::instance().get(m_filePath), previous);
+}
+
+/**
+ * @test Disabled, every get() reads the file
+ */
+TEST_F(SqlTemplateCacheTest, Disabled_ReadsFileEveryTime)
+{
+    SqlTemplateCache::instance().setEnabled(false);
+    EXPECT_EQ(SqlTemplateCache::instance().size(), 0u);
+
+    writeApplet("SELECT id, age FROM users WHERE age >= :min_age");
+    EXPECT_EQ(parsedSql(), "SELECT id, age FROM users WHERE age >= :min_age\n");
+    EXPECT_EQ(SqlTemplateCache::instance().size(), 0u);
+}
+
+#ifdef __linux__
+/**
+ * @test The watcher reloads edited applets and reports broken ones
+ */
+TEST_F(SqlTemplateCacheTest, Watcher_ReloadsEditedApplet)
+{
+    std::string reportedPath;
+    SqlAppletWatcher watcher(m_dir.string(), SqlTemplateCache::instance(),
+        [&](const std::string& filePath, const std::string&) { reportedPath = filePath; });
+    ASSERT_TRUE(watcher.start());
+    EXPECT_EQ(parsedSql(), "SELECT id FROM users WHERE age >= :min_age\n");
+
+    auto waitFor = [](const auto& done) {
+        for (int i = 0; i < 100 && !done(); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        return done();
+    };
+
+    writeApplet("SELECT name FROM users WHERE age >= :min_age");
+    ASSERT_TRUE(waitFor([&] { return watcher.reloads() > 0; }));
+    EXPECT_EQ(parsedSql(), "SELECT name FROM users WHERE age >= :min_age\n");
+
+    writeApplet("SELECT 1", "-- @bogus");
+    ASSERT_TRUE(waitFor([&] { return watcher.failures() > 0; }));
+    watcher.stop();
+    EXPECT_EQ(reportedPath, m_filePath);
+    EXPECT_EQ(parsedSql(), "SELECT name FROM users WHERE age >= :min_age\n");
+}
+#endif
+
+/**
+ * @test preload() loads every applet and reports the broken ones
+ */
+TEST_F(SqlTemplateCacheTest, Preload_LoadsDirectoryAndReportsErrors)
+{
+    {
+        std::ofstream broken(m_dir / "broken.sql");
+        broken << "-- broken.sql\n-- @bogus\n\nSELECT 1\n";
+        std::ofstream ignored(m_dir / "notes.txt");
+        ignored << "not an applet\n";
+    }
+
+    std::vector<std::string> failed;
+    const size_t loaded = SqlTemplateCache::instance().preload(
+        m_dir.string() + "/", [&](const std::string& filePath, const std::string&) {
+            failed.push_back(filePath);
+        });
+
+    EXPECT_EQ(loaded, 1u);
+    EXPECT_EQ(SqlTemplateCache::instance().size(), 1u);
+    ASSERT_EQ(failed.size(), 1u);
+    EXPECT_NE(failed[0].find("broken.sql"), std::string::npos);
+}
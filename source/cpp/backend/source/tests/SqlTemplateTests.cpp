@@ -295,3 +295,166 @@ TEST_F(SqlTemplateTest, StringDefault_BindsRawValue_NoQuotes)
     EXPECT_EQ(it->value, "Givi") << "default must bind raw 'Givi', not a quoted literal";
 }
 
+
+// ============================================================================
+// Header directives (-- @timeout, -- @prefetch, -- @cache)
+// ============================================================================
+
+/**
+ * @test Directives are read from the header
+ */
+TEST_F(SqlTemplateTest, Directives_ParsedFromHeader)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+    tpl.parse();
+
+    ASSERT_TRUE(tpl.timeout().has_value());
+    EXPECT_EQ(tpl.timeout()->count(), 500);
+    EXPECT_EQ(tpl.prefetchRows(), 100);
+    ASSERT_TRUE(tpl.cachePolicy().has_value());
+    EXPECT_EQ(tpl.cachePolicy()->ttl, std::chrono::seconds(60));
+    EXPECT_EQ(tpl.cachePolicy()->keyParams, std::vector<std::string>{"min_age"});
+    EXPECT_NE(tpl.description().find("Users"), std::string::npos);
+}
+
+/**
+ * @test Templates without directives keep the defaults
+ */
+TEST_F(SqlTemplateTest, Directives_AbsentByDefault)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "test.sql");
+    tpl.parse();
+
+    EXPECT_FALSE(tpl.timeout().has_value());
+    EXPECT_EQ(tpl.prefetchRows(), 0);
+    EXPECT_FALSE(tpl.cachePolicy().has_value());
+}
+
+/**
+ * @test A misspelled directive is rejected instead of silently ignored
+ */
+TEST_F(SqlTemplateTest, Directives_UnknownThrows)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "bad_directive_test.sql");
+    EXPECT_THROW(tpl.parse(), SqlTemplateException);
+}
+
+/**
+ * @test Duration units
+ */
+TEST_F(SqlTemplateTest, ParseDuration_Units)
+{
+    EXPECT_EQ(SqlTemplate::parseDuration("250").count(), 250);
+    EXPECT_EQ(SqlTemplate::parseDuration("500ms").count(), 500);
+    EXPECT_EQ(SqlTemplate::parseDuration("30s").count(), 30000);
+    EXPECT_EQ(SqlTemplate::parseDuration("2m").count(), 120000);
+    EXPECT_THROW(SqlTemplate::parseDuration("fast"), SqlTemplateException);
+    EXPECT_THROW(SqlTemplate::parseDuration("5h"), SqlTemplateException);
+}
+
+/**
+ * @test The cache key follows the key parameters only
+ */
+TEST_F(SqlTemplateTest, CacheKey_UsesKeyParams)
+{
+    auto keyFor = [](int minAge, const char* label) {
+        SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+        tpl.addParameter("min_age", minAge);
+        tpl.addParameter("label", label);
+        tpl.parse();
+        return tpl.cacheKey();
+    };
+
+    EXPECT_EQ(keyFor(18, "a"), keyFor(18, "b"));
+    EXPECT_NE(keyFor(18, "a"), keyFor(30, "a"));
+
+    SqlTemplate unparsed(ALL_BACKEND_TEST_APPDATA_PATH "select_users_cached_test.sql");
+    EXPECT_THROW((void)unparsed.cacheKey(), SqlTemplateException);
+}
+
+/**
+ * @test ARRAY_* parameters expand to a padded IN-list by default
+ */
+TEST_F(SqlTemplateTest, ArrayParam_ExpandsToPaddedInList)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_by_ids_test.sql");
+    tpl.addParameter("ids", std::vector<int>{3, 1, 2});
+    tpl.addParameter("names", std::vector<std::string>{"O'Brien"});
+    tpl.parse();
+
+    EXPECT_EQ(tpl.sql(),
+              "SELECT id, name FROM users WHERE id IN (:ids_0, :ids_1, :ids_2, :ids_3) "
+              "OR name IN (:names_0) ORDER BY id\n");
+    EXPECT_EQ(tpl.getDebugSql(),
+              "SELECT id, name FROM users WHERE id IN (3, 1, 2, 2) "
+              "OR name IN ('O''Brien') ORDER BY id\n");
+
+    const auto& bindings = tpl.paramBindings();
+    ASSERT_EQ(bindings.size(), 5u);
+    EXPECT_EQ(bindings[3].name, "ids_3");
+    EXPECT_EQ(bindings[3].value, "2");
+    EXPECT_EQ(bindings[3].type, DataInfo::Int);
+    EXPECT_EQ(bindings[4].type, DataInfo::String);
+}
+
+/**
+ * @test An empty array matches nothing instead of rendering "IN ()"
+ */
+TEST_F(SqlTemplateTest, ArrayParam_EmptyRendersNull)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_by_ids_test.sql");
+    tpl.addParameter("ids", std::vector<int64_t>{});
+    tpl.parse();
+
+    EXPECT_EQ(tpl.sql(), "SELECT id, name FROM users WHERE id IN (NULL) OR name IN (NULL) ORDER BY id\n");
+    EXPECT_TRUE(tpl.paramBindings().empty());
+}
+
+/**
+ * @test Native binding keeps "= ANY(...)" and binds one array literal
+ */
+TEST_F(SqlTemplateTest, ArrayParam_NativeBindsArrayLiteral)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_by_ids_test.sql");
+    tpl.setArrayBinding(SqlTemplate::ArrayBinding::Native);
+    tpl.addParameter("ids", std::vector<int>{1, 2});
+    tpl.addParameter("names", std::vector<std::string>{"a\"b", "c"});
+    tpl.parse();
+
+    EXPECT_EQ(tpl.sql(),
+              "SELECT id, name FROM users WHERE id = ANY(CAST(:ids AS bigint[])) "
+              "OR name = ANY(CAST(:names AS text[])) ORDER BY id\n");
+
+    const auto& bindings = tpl.paramBindings();
+    ASSERT_EQ(bindings.size(), 2u);
+    EXPECT_EQ(bindings[0].value, "{1,2}");
+    EXPECT_EQ(bindings[1].value, "{\"a\\\"b\",\"c\"}");
+    EXPECT_EQ(bindings[1].type, DataInfo::String);
+}
+
+/**
+ * @test Pre-formatted values are comma-separated lists
+ */
+TEST_F(SqlTemplateTest, ArrayParam_FormattedValueIsCommaList)
+{
+    SqlTemplate tpl(ALL_BACKEND_TEST_APPDATA_PATH "select_users_by_ids_test.sql",
+                    std::map<std::string, std::string>{{"ids", "5, 6"}});
+    tpl.parse();
+
+    EXPECT_EQ(tpl.getDebugSql(), "SELECT id, name FROM users WHERE id IN (5, 6) OR name IN (NULL) ORDER BY id\n");
+}
+
+/**
+ * @test Bucket sizes bound the number of distinct statement texts
+ */
+TEST_F(SqlTemplateTest, ArrayBucket_PowersOfTwoThenMultiples)
+{
+    EXPECT_EQ(SqlTemplate::arrayBucket(0), 1u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(1), 1u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(3), 4u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(64), 64u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(65), 128u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(1024), 1024u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(1025), 2048u);
+    EXPECT_EQ(SqlTemplate::arrayBucket(3000), 3072u);
+}
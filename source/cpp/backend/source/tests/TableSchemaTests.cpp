@@ -0,0 +1,128 @@
+/**
+ * @file TableSchemaTests.cpp
+ * @brief Tests for table descriptors (table_schema.h)
+ *
+ * Checks the compile-time allow-list, ordinal row mapping over SQLite
+ * in-memory results and parameter binding from the descriptor.
+ */
+
+#include "table_schema.h"
+#include "sqlcommand.h"
+#include "sqlconnection.h"
+#include "sqlquery.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+struct Person {
+    int id = 0;
+    std::string name;
+    std::chrono::milliseconds born{0};
+    int64_t version = 0;
+};
+
+struct PersonSchema {
+    using Row = Person;
+
+    static constexpr std::tuple columns{
+        schemaColumn("ID",      DataInfo::Int,    &Person::id,      SchemaFilter),
+        schemaColumn("NAME",    DataInfo::String, &Person::name,    SchemaFilter | SchemaWrite | SchemaTrim),
+        schemaColumn("BORN",    DataInfo::Date,   &Person::born,    SchemaWrite),
+        schemaColumn("VERSION", DataInfo::Int64,  &Person::version),
+    };
+};
+
+const SchemaAllowList<PersonSchema> PERSON_COLUMNS;
+}
+
+/**
+ * @test Counts, names and the perfect-hash index are computed at compile time
+ */
+TEST(TableSchemaTest, Descriptor_DerivedAtCompileTime)
+{
+    static_assert(schemaSize<PersonSchema> == 4);
+    static_assert(schemaCount<PersonSchema, SchemaFilter>() == 2);
+    static_assert(schemaNames<PersonSchema, SchemaWrite>()[1] == "BORN");
+
+    static constexpr PerfectHashIndex<4> INDEX(schemaNames<PersonSchema>());
+    static_assert(INDEX.indexOf("VERSION") == 3);
+    static_assert(INDEX.indexOf("version") == 4);
+    SUCCEED();
+}
+
+/**
+ * @test The allow-list holds only the SchemaFilter columns
+ */
+TEST(TableSchemaTest, AllowList_ContainsFilterColumns)
+{
+    EXPECT_EQ(PERSON_COLUMNS.size(), 2u);
+    EXPECT_EQ(PERSON_COLUMNS.resolve("NAME"), "NAME");
+    EXPECT_FALSE(PERSON_COLUMNS.contains("BORN"));
+    EXPECT_EQ(PERSON_COLUMNS.validNames(), "ID, NAME");
+
+    try {
+        PERSON_COLUMNS.resolve("BORN");
+        FAIL() << "Expected std::invalid_argument";
+    } catch (const std::invalid_argument& e) {
+        EXPECT_NE(std::string(e.what()).find("Valid columns: ID, NAME"), std::string::npos);
+    }
+}
+
+/**
+ * @test Rows are mapped by ordinal whatever the column order and case;
+ *       columns missing from the result keep their defaults
+ */
+TEST(TableSchemaTest, RowReader_MapsByOrdinal)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "schemauser", "schemapass");
+    conn.connect();
+    SqlDirectCommand(conn, SAString("CREATE TABLE person(id INTEGER, name CHAR(10), born TEXT)")).execute();
+    SqlDirectCommand(conn, SAString("INSERT INTO person VALUES(1, 'Ann   ', '2001-02-03')")).execute();
+    SqlDirectCommand(conn, SAString("INSERT INTO person VALUES(2, 'Bob', '1999-12-31')")).execute();
+
+    SqlDirectQuery query(conn, SAString("SELECT born, name, id FROM person ORDER BY id"));
+    SchemaRowReader<PersonSchema> readRow;
+    std::vector<Person> rows;
+    while (query.query()) {
+        rows.push_back(readRow(query));
+    }
+
+    ASSERT_EQ(rows.size(), 2u);
+    EXPECT_EQ(rows[0].id, 1);
+    EXPECT_EQ(rows[0].name, "Ann");
+    EXPECT_EQ(rows[0].born, TimeFormatHelper::stringTochronoSysSec("2001-02-03", DataInfo::Date));
+    EXPECT_EQ(rows[0].version, 0);
+    EXPECT_EQ(rows[1].name, "Bob");
+}
+
+/**
+ * @test addSchemaParameters() binds the SchemaWrite columns by name
+ */
+TEST(TableSchemaTest, AddParameters_BindsWriteColumns)
+{
+    const auto dir = std::filesystem::temp_directory_path() / "medicon_table_schema_test";
+    std::filesystem::create_directories(dir);
+    const std::string filePath = (dir / "insert_person.sql").string();
+    {
+        std::ofstream out(filePath);
+        out << "-- insert_person.sql\n"
+               "-- @param NAME STRING default=''\n"
+               "-- @param BORN DATE   default='2000-01-01'\n\n"
+               "INSERT INTO person(name, born) VALUES(:NAME, :BORN)\n";
+    }
+
+    Person person;
+    person.name = "Eve";
+    person.born = TimeFormatHelper::stringTochronoSysSec("1990-05-06", DataInfo::Date);
+
+    SqlTemplate tpl(filePath);
+    addSchemaParameters<PersonSchema>(tpl, person);
+    tpl.parse();
+    const std::string debug = tpl.getDebugSql();
+    EXPECT_NE(debug.find("'Eve'"), std::string::npos) << debug;
+    EXPECT_NE(debug.find("'1990-05-06'"), std::string::npos) << debug;
+
+    std::filesystem::remove_all(dir);
+}
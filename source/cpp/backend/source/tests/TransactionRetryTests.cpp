@@ -0,0 +1,126 @@
+/**
+ * @file TransactionRetryTests.cpp
+ * @brief Tests for TransactionRetry using SQLite in-memory databases
+ *
+ * Verifies error classification, backoff bounds, reconnect-and-retry
+ * after a lost connection, and that permanent errors are not retried.
+ */
+
+#include "transactionretry.h"
+#include "gtest/gtest.h"
+
+namespace {
+
+RetryPolicy fastPolicy(int attempts)
+{
+    RetryPolicy policy;
+    policy.maxAttempts = attempts;
+    policy.baseDelay = std::chrono::milliseconds(1);
+    policy.maxDelay = std::chrono::milliseconds(2);
+    return policy;
+}
+
+} // namespace
+
+/**
+ * @test PostgreSQL messages map to the right error kind
+ */
+TEST(TransactionRetryTest, Classify_Messages)
+{
+    EXPECT_EQ(TransactionRetry::classify("ERROR:  could not serialize access due to concurrent update", true),
+              SqlErrorKind::Serialization);
+    EXPECT_EQ(TransactionRetry::classify("ERROR:  Deadlock detected", true),
+              SqlErrorKind::Serialization);
+    EXPECT_EQ(TransactionRetry::classify("server closed the connection unexpectedly", true),
+              SqlErrorKind::Connection);
+    EXPECT_EQ(TransactionRetry::classify("FATAL:  terminating connection due to administrator command", true),
+              SqlErrorKind::Connection);
+    EXPECT_EQ(TransactionRetry::classify("ERROR:  duplicate key value violates unique constraint", true),
+              SqlErrorKind::Permanent);
+    // A dead connection wins over the message
+    EXPECT_EQ(TransactionRetry::classify("ERROR:  syntax error", false),
+              SqlErrorKind::Connection);
+}
+
+/**
+ * @test Backoff stays within the exponential ceiling and the cap
+ */
+TEST(TransactionRetryTest, Backoff_IsBounded)
+{
+    RetryPolicy policy;
+    policy.baseDelay = std::chrono::milliseconds(10);
+    policy.maxDelay = std::chrono::milliseconds(50);
+    TransactionRetry retry(policy);
+
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_LE(retry.backoff(1).count(), 10);
+        EXPECT_LE(retry.backoff(2).count(), 20);
+        EXPECT_LE(retry.backoff(30).count(), 50);
+    }
+}
+
+/**
+ * @test A lost connection is reconnected and the unit of work re-run
+ */
+TEST(TransactionRetryTest, LostConnection_ReconnectsAndRetries)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "admin", "pass");
+    conn.connect();
+    RetryStats stats;
+    TransactionRetry retry(fastPolicy(3), &stats);
+
+    int calls = 0;
+    const int result = retry.runInTransaction(conn, [&](SqlConnection& c) {
+        if (++calls == 1) {
+            c.disconnect();  // simulate the server dropping us
+        }
+        SACommand(c.connectionSa(), _TSA("CREATE TABLE t(id INTEGER)")).Execute();
+        return calls;
+    });
+
+    EXPECT_EQ(result, 2);
+    EXPECT_TRUE(conn.isConnected());
+    EXPECT_EQ(stats.attempts, 2u);
+    EXPECT_EQ(stats.retries, 1u);
+    EXPECT_EQ(stats.reconnects, 1u);
+    EXPECT_EQ(stats.recovered, 1u);
+    EXPECT_EQ(stats.exhausted, 0u);
+}
+
+/**
+ * @test Retries stop after maxAttempts and the last error is rethrown
+ */
+TEST(TransactionRetryTest, PersistentFailure_ExhaustsAttempts)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "admin", "pass");
+    RetryStats stats;
+    TransactionRetry retry(fastPolicy(2), &stats);
+
+    EXPECT_THROW(retry.run(conn, [](SqlConnection& c) {
+        c.disconnect();
+        SACommand(c.connectionSa(), _TSA("SELECT 1")).Execute();
+        return 0;
+    }), SAException);
+
+    EXPECT_EQ(stats.attempts, 2u);
+    EXPECT_EQ(stats.exhausted, 1u);
+}
+
+/**
+ * @test SQL errors are permanent and not retried
+ */
+TEST(TransactionRetryTest, PermanentError_IsNotRetried)
+{
+    SqlConnection conn(SA_SQLite_Client, ":memory:", "admin", "pass");
+    conn.connect();
+    RetryStats stats;
+    TransactionRetry retry(fastPolicy(3), &stats);
+
+    EXPECT_THROW(retry.runInTransaction(conn, [](SqlConnection& c) {
+        SACommand(c.connectionSa(), _TSA("SELECT * FROM missing_table")).Execute();
+        return 0;
+    }), SAException);
+
+    EXPECT_EQ(stats.attempts, 1u);
+    EXPECT_EQ(stats.retries, 0u);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file TransactionScopeTests.cpp
+ * @brief Tests for TransactionScope options (SQLite in-memory)
+ *
+ * Verifies the SET TRANSACTION text built from TransactionOptions and that
+ * a scope with options still commits and rolls back on clients that ignore
+ * them.
+ */
+
+#include "transactionscope.h"
+#include "gtest/gtest.h"
+
+class TransactionScopeTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        m_conn.connect();
+        exec("CREATE TABLE items(id INTEGER PRIMARY KEY)");
+    }
+
+    void exec(const char* sql)
+    {
+        SACommand cmd(m_conn.connectionSa(), SAString(sql));
+        cmd.Execute();
+    }
+
+    long count()
+    {
+        SACommand cmd(m_conn.connectionSa(), _TSA("SELECT COUNT(*) FROM items"));
+        cmd.Execute();
+        cmd.FetchNext();
+        return cmd.Field(1).asLong();
+    }
+
+    SqlConnection m_conn{SA_SQLite_Client, ":memory:", "admin", "pass"};
+};
+
+/**
+ * @test Options render as one PostgreSQL SET TRANSACTION statement
+ */
+TEST(TransactionOptionsTest, ToSql)
+{
+    EXPECT_EQ(TransactionOptions{}.toSql(), "");
+    EXPECT_EQ(TransactionOptions::snapshot().toSql(),
+              "SET TRANSACTION ISOLATION LEVEL REPEATABLE READ READ ONLY");
+
+    TransactionOptions report{TransactionOptions::Isolation::Serializable, true, true};
+    EXPECT_EQ(report.toSql(), "SET TRANSACTION ISOLATION LEVEL SERIALIZABLE READ ONLY DEFERRABLE");
+
+    TransactionOptions readWrite;
+    readWrite.isolation = TransactionOptions::Isolation::ReadCommitted;
+    EXPECT_EQ(readWrite.toSql(), "SET TRANSACTION ISOLATION LEVEL READ COMMITTED READ WRITE");
+}
+
+/**
+ * @test Options are ignored on SQLite; commit keeps the work
+ */
+TEST_F(TransactionScopeTest, Options_CommitOnSqlite)
+{
+    {
+        TransactionScope tx(m_conn, TransactionOptions{TransactionOptions::Isolation::Serializable});
+        exec("INSERT INTO items VALUES(1)");
+        tx.commit();
+    }
+    EXPECT_EQ(count(), 1);
+}
+
+/**
+ * @test A snapshot scope left without commit rolls back
+ */
+TEST_F(TransactionScopeTest, Options_RollbackWithoutCommit)
+{
+    {
+        TransactionScope tx(m_conn, TransactionOptions::snapshot());
+        exec("INSERT INTO items VALUES(1)");
+        EXPECT_TRUE(tx.isActive());
+    }
+    EXPECT_EQ(count(), 0);
+}
+
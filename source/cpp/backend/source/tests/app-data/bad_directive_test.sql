@@ -0,0 +1,7 @@
+-- bad_directive_test.sql
+-- @param id NUMERIC default=0
+-- @timout 5s
+--
+-- Misspelled directive must be rejected
+
+SELECT :id
@@ -0,0 +1,7 @@
+-- select_users_by_ids_test.sql
+-- @param ids   ARRAY_INT    default=''
+-- @param names ARRAY_STRING default=''
+--
+-- Users whose id is in ids or whose name is in names
+
+SELECT id, name FROM users WHERE id = ANY(:ids) OR name = ANY(:names) ORDER BY id
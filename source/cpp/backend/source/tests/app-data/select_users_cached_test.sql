@@ -0,0 +1,10 @@
+-- select_users_cached_test.sql
+-- @param min_age NUMERIC  default=0
+-- @param label   STRING   default=''
+-- @timeout  500ms
+-- @prefetch 100
+-- @cache    ttl=60s key=min_age
+--
+-- Users at least min_age old; label is echoed back but is not part of the cache key
+
+SELECT id, name, :label AS label FROM users WHERE age >= :min_age ORDER BY id
@@ -0,0 +1,211 @@
+#ifndef TRANSACTIONRETRY_H
+#define TRANSACTIONRETRY_H
+
+#include "transactionscope.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+
+/**
+ * @brief How a failed statement should be handled
+ */
+enum class SqlErrorKind {
+    Permanent,      ///< Constraint, syntax, permission... — retrying cannot help
+    Serialization,  ///< Serialization failure / deadlock — transaction was rolled back
+    Connection      ///< Connection lost — reconnect, then retry
+};
+
+/**
+ * @brief Retry limits for TransactionRetry
+ */
+struct RetryPolicy {
+    int maxAttempts = 3;                       ///< Including the first attempt
+    std::chrono::milliseconds baseDelay{20};   ///< Backoff before the 2nd attempt
+    std::chrono::milliseconds maxDelay{500};   ///< Backoff cap
+};
+
+/**
+ * @brief Retry counters, shared by every runner of a service
+ */
+struct RetryStats {
+    std::atomic<uint64_t> attempts{0};   ///< Units of work started (incl. retries)
+    std::atomic<uint64_t> retries{0};    ///< Re-runs after a transient failure
+    std::atomic<uint64_t> recovered{0};  ///< Units that succeeded after a retry
+    std::atomic<uint64_t> exhausted{0};  ///< Units that failed after maxAttempts
+    std::atomic<uint64_t> reconnects{0}; ///< Reconnects after a lost connection
+};
+
+/**
+ * @brief Runs a unit of work, retrying transient database failures
+ *
+ * Failures are classified with classify(): serialization failures and
+ * deadlocks are retried on the same connection, a lost connection is
+ * reconnected in place (so pooled leases stay valid) before retrying.
+ * Backoff is exponential with full jitter.
+ *
+ * A connection lost while committing is NOT retried: the commit may have
+ * gone through, and repeating a non-idempotent insert would duplicate it.
+ *
+ * Usage:
+ * @code
+ * TransactionRetry retry(policy, &stats);
+ * CompanyData added = retry.runInTransaction(conn, [&](SqlConnection& c) {
+ *     return CompanyRepository(c, appletPath).add(data);
+ * });
+ * @endcode
+ */
+class TransactionRetry
+{
+public:
+    explicit TransactionRetry(RetryPolicy policy = {}, RetryStats* stats = nullptr) noexcept
+        : m_policy(policy)
+        , m_stats(stats)
+    {
+    }
+
+    /**
+     * @brief Classify a database error message
+     *
+     * SQLAPI++ reports PostgreSQL errors as text without the SQLSTATE, so
+     * the messages of classes 08 (connection exception), 57P (operator
+     * intervention), 40001 (serialization failure) and 40P01 (deadlock)
+     * are matched instead.
+     *
+     * @param message Error text (SAException::ErrText())
+     * @param connectionAlive Result of a liveness probe; false wins over the text
+     */
+    static SqlErrorKind classify(std::string_view message, bool connectionAlive)
+    {
+        if (!connectionAlive) {
+            return SqlErrorKind::Connection;
+        }
+
+        std::string text(message);
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        auto contains = [&text](std::string_view needle) {
+            return text.find(needle) != std::string::npos;
+        };
+
+        if (contains("could not serialize access") || contains("deadlock detected")) {
+            return SqlErrorKind::Serialization;
+        }
+        if (contains("server closed the connection") || contains("terminating connection") ||
+            contains("connection to server") || contains("no connection to the server") ||
+            contains("could not receive data") || contains("could not send data") ||
+            contains("ssl connection has been closed") || contains("the database system is") ||
+            contains("connection reset") || contains("broken pipe")) {
+            return SqlErrorKind::Connection;
+        }
+        return SqlErrorKind::Permanent;
+    }
+
+    /// Classify @p e raised on @p conn (probes the connection)
+    static SqlErrorKind classify(const SAException& e, SqlConnection& conn)
+    {
+        bool alive = false;
+        try {
+            alive = conn.isConnected() && conn.connectionSa()->isAlive();
+        } catch (...) {
+            alive = false;
+        }
+        return classify(e.ErrText().GetMultiByteChars(), alive);
+    }
+
+    /**
+     * @brief Backoff before attempt @p attempt + 1 (attempt counts from 1)
+     * @return Uniform random delay in [0, min(maxDelay, baseDelay * 2^(attempt-1))]
+     */
+    std::chrono::milliseconds backoff(int attempt) const
+    {
+        const auto shift = std::clamp(attempt - 1, 0, 20);
+        const auto ceiling = std::min<int64_t>(m_policy.maxDelay.count(),
+                                               m_policy.baseDelay.count() << shift);
+        thread_local std::mt19937 rng{std::random_device{}()};
+        std::uniform_int_distribution<int64_t> jitter(0, std::max<int64_t>(ceiling, 0));
+        return std::chrono::milliseconds(jitter(rng));
+    }
+
+    /**
+     * @brief Run @p fn(conn) in a TransactionScope and commit, with retries
+     * @throws the last SAException when it is permanent or attempts are used up
+     */
+    template <typename Fn>
+    auto runInTransaction(SqlConnection& conn, Fn&& fn)
+    {
+        return execute(conn, [&fn](SqlConnection& c, bool& committing) {
+            TransactionScope tx(c);
+            auto result = fn(c);
+            committing = true;
+            tx.commit();
+            return result;
+        });
+    }
+
+    /**
+     * @brief Run @p fn(conn) without a transaction (reads), with retries
+     */
+    template <typename Fn>
+    auto run(SqlConnection& conn, Fn&& fn)
+    {
+        return execute(conn, [&fn](SqlConnection& c, bool&) { return fn(c); });
+    }
+
+    const RetryPolicy& policy() const noexcept { return m_policy; }
+
+private:
+    template <typename Body>
+    auto execute(SqlConnection& conn, Body&& body)
+    {
+        for (int attempt = 1;; ++attempt) {
+            count(&RetryStats::attempts);
+            bool committing = false;
+            try {
+                if (!conn.isConnected()) {
+                    conn.connect();
+                }
+                auto result = body(conn, committing);
+                if (attempt > 1) {
+                    count(&RetryStats::recovered);
+                }
+                return result;
+            } catch (const SAException& e) {
+                const SqlErrorKind kind = classify(e, conn);
+                const bool ambiguous = committing && kind == SqlErrorKind::Connection;
+                if (kind == SqlErrorKind::Permanent || ambiguous) {
+                    throw;
+                }
+                if (attempt >= m_policy.maxAttempts) {
+                    count(&RetryStats::exhausted);
+                    throw;
+                }
+                if (kind == SqlErrorKind::Connection) {
+                    // Dropped here, re-established at the top of the next attempt
+                    conn.disconnect();
+                    count(&RetryStats::reconnects);
+                }
+            }
+            count(&RetryStats::retries);
+            std::this_thread::sleep_for(backoff(attempt));
+        }
+    }
+
+    void count(std::atomic<uint64_t> RetryStats::*counter) noexcept
+    {
+        if (m_stats) {
+            (m_stats->*counter).fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    RetryPolicy m_policy;
+    RetryStats* m_stats = nullptr;
+};
+
+#endif // TRANSACTIONRETRY_H
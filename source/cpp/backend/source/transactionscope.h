@@ -3,6 +3,60 @@
 
 #include "sqlconnection.h"
 
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Isolation and access mode of a TransactionScope
+ *
+ * Applied with SET TRANSACTION on PostgreSQL; other clients keep their
+ * defaults (SQLite transactions are serializable anyway).
+ */
+struct TransactionOptions {
+    enum class Isolation {
+        Default,         ///< Server default (READ COMMITTED on PostgreSQL)
+        ReadCommitted,
+        RepeatableRead,  ///< One snapshot for every statement of the transaction
+        Serializable
+    };
+
+    Isolation isolation = Isolation::Default;
+    bool readOnly = false;    ///< READ ONLY: writes fail, no row locks are taken
+    bool deferrable = false;  ///< DEFERRABLE: only with Serializable + readOnly
+
+    /// REPEATABLE READ, READ ONLY — consistent multi-statement reads
+    static TransactionOptions snapshot() noexcept
+    {
+        return {Isolation::RepeatableRead, true, false};
+    }
+
+    [[nodiscard]] bool isDefault() const noexcept
+    {
+        return isolation == Isolation::Default && !readOnly && !deferrable;
+    }
+
+    /// "SET TRANSACTION ..." for these options, empty when isDefault()
+    [[nodiscard]] std::string toSql() const
+    {
+        if (isDefault()) {
+            return {};
+        }
+        std::string sql = "SET TRANSACTION";
+        switch (isolation) {
+        case Isolation::ReadCommitted:  sql += " ISOLATION LEVEL READ COMMITTED"; break;
+        case Isolation::RepeatableRead: sql += " ISOLATION LEVEL REPEATABLE READ"; break;
+        case Isolation::Serializable:   sql += " ISOLATION LEVEL SERIALIZABLE"; break;
+        case Isolation::Default:        break;
+        }
+        sql += readOnly ? " READ ONLY" : " READ WRITE";
+        if (deferrable) {
+            sql += " DEFERRABLE";
+        }
+        return sql;
+    }
+};
+
 /**
  * @brief RAII transaction scope with automatic rollback on exception
  *
@@ -19,6 +73,13 @@
  *     // ... do SQL work ...
  *     tx.commit();  // On success
  * } // Auto-rollback if commit() was not called (e.g., on exception)
+ *
+ * {
+ *     // Page and total from one snapshot, no locks
+ *     TransactionScope tx(conn, TransactionOptions::snapshot());
+ *     // ... SELECT page; SELECT COUNT(*) ...
+ *     tx.commit();
+ * }
  * @endcode
  */
 class TransactionScope
@@ -42,6 +103,30 @@ public:
         }
     }
 
+    /**
+     * @brief Begin a transaction with an isolation level / access mode
+     * @param conn The database connection to manage
+     * @param options Applied as the first statement on PostgreSQL
+     * @throws SAException if the transaction cannot be started or configured
+     *
+     * Unlike the plain constructor this one throws: silently running a
+     * snapshot read in autocommit would defeat its purpose.
+     */
+    TransactionScope(SqlConnection& conn, const TransactionOptions& options)
+        : m_conn(&conn)
+    {
+        m_conn->setAutoCommit(false);
+        if (!options.isDefault() && m_conn->connectionSa()->Client() == SA_PostgreSQL_Client) {
+            try {
+                SACommand cmd(m_conn->connectionSa(), SAString(options.toSql().c_str()));
+                cmd.Execute();
+            } catch (...) {
+                rollbackQuietly();
+                throw;
+            }
+        }
+    }
+
     /**
      * @brief Destructor — auto-rollback if not committed
      *
@@ -51,13 +136,7 @@ public:
      */
     ~TransactionScope() noexcept
     {
-        if (m_conn && !m_committed) {
-            try {
-                m_conn->rollback();
-            } catch (...) {
-                // Swallow — destructors must not throw
-            }
-        }
+        rollbackQuietly();
     }
 
     // No copy or move
@@ -101,8 +180,125 @@ public:
     }
 
 private:
+    void rollbackQuietly() noexcept
+    {
+        if (m_conn && !m_committed) {
+            try {
+                m_conn->rollback();
+            } catch (...) {
+                // Swallow — destructors must not throw
+            }
+        }
+    }
+
     SqlConnection* m_conn = nullptr;
     bool m_committed = false;
 };
 
+/**
+ * @brief Nested scope inside a TransactionScope, backed by a SAVEPOINT
+ *
+ * Lets a batch run in one outer transaction and undo only the item that
+ * failed: on PostgreSQL an error aborts the whole transaction unless it is
+ * rolled back to a savepoint.
+ *
+ * Usage:
+ * @code
+ * TransactionScope tx(conn);
+ * for (const auto& row : rows) {
+ *     try {
+ *         SavepointScope sp(conn);
+ *         // ... write row ...
+ *         sp.release();
+ *     } catch (const SAException&) {
+ *         // only this row was rolled back; the transaction is still usable
+ *     }
+ * }
+ * tx.commit();
+ * @endcode
+ *
+ * Scopes must be released or destroyed in reverse order of creation.
+ */
+class SavepointScope
+{
+public:
+    /**
+     * @brief Set a savepoint on a connection with an open transaction
+     * @throws SAException if the savepoint cannot be created
+     */
+    explicit SavepointScope(SqlConnection& conn)
+        : m_conn(&conn)
+        , m_name("medicon_sp_" + std::to_string(nextId()))
+    {
+        execute("SAVEPOINT " + m_name);
+    }
+
+    /**
+     * @brief Destructor — roll back to the savepoint if not released
+     *
+     * Never throws.
+     */
+    ~SavepointScope() noexcept
+    {
+        if (m_active) {
+            try {
+                rollback();
+            } catch (...) {
+                // Swallow — the outer TransactionScope rolls back anyway
+            }
+        }
+    }
+
+    // No copy or move
+    SavepointScope(const SavepointScope&) = delete;
+    SavepointScope& operator=(const SavepointScope&) = delete;
+    SavepointScope(SavepointScope&&) = delete;
+    SavepointScope& operator=(SavepointScope&&) = delete;
+
+    /**
+     * @brief Keep the work done since the savepoint (RELEASE SAVEPOINT)
+     * @throws SAException if the release fails
+     */
+    void release()
+    {
+        if (m_active) {
+            execute("RELEASE SAVEPOINT " + m_name);
+            m_active = false;
+        }
+    }
+
+    /**
+     * @brief Undo the work done since the savepoint and drop it
+     * @throws SAException if the rollback fails
+     */
+    void rollback()
+    {
+        if (m_active) {
+            m_active = false;
+            execute("ROLLBACK TO SAVEPOINT " + m_name);
+            execute("RELEASE SAVEPOINT " + m_name);
+        }
+    }
+
+    [[nodiscard]] bool isActive() const noexcept { return m_active; }
+    [[nodiscard]] const std::string& name() const noexcept { return m_name; }
+
+private:
+    static uint64_t nextId() noexcept
+    {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    void execute(const std::string& sql)
+    {
+        SACommand cmd(m_conn->connectionSa(), SAString(sql.c_str()));
+        cmd.Execute();
+    }
+
+    SqlConnection* m_conn = nullptr;
+    std::string m_name;
+    bool m_active = true;
+};
+
 #endif // TRANSACTIONSCOPE_H
@@ -0,0 +1,632 @@
+/**
+ * @file main.cpp
+ * @brief Build-time generator of typed C++ wrappers for .sql applets
+ *
+ * Usage: sql_applet_codegen <output-header> <applet.sql>...
+ *
+ * Reads the same header format as SqlTemplate (-- @param, -- @timeout,
+ * -- @prefetch, -- @cache) and writes one struct per applet into
+ * namespace sql_applets:
+ * - one typed member per @param, initialized with its default
+ * - SEGMENTS: the SQL split at its placeholders, as constexpr string_views
+ * - sql(): SQL with :NAME markers; $NAME identifiers are resolved through
+ *   a ColumnAllowListBase argument per identifier parameter
+ * - bind(SACommand&): binds every :NAME marker (and PreFetchRows); a string
+ *   member holding "NULL" binds SQL NULL, like SqlCommand does
+ *
+ * Any header error fails the build with "file:line: message". Driven by
+ * cmake/sql-applets.cmake; deliberately free of project dependencies so it
+ * can be built first.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using std::string;
+using std::string_view;
+using std::vector;
+
+namespace {
+
+// ============================================================================
+// Applet model
+// ============================================================================
+
+enum class CppType { Long, Int64, Double, Bool, String };
+
+struct Param {
+    string name;
+    CppType type = CppType::String;
+    string defaultValue;
+    bool hasDefault = false;
+};
+
+struct Placeholder {
+    string name;
+    bool identifier = false;  ///< $NAME (allow-listed column) vs :NAME (bind)
+};
+
+struct Applet {
+    string file;          ///< File name, e.g. "company_select.sql"
+    string structName;    ///< e.g. "CompanySelect"
+    string description;
+    vector<Param> params;
+    vector<string> segments;           ///< segments.size() == placeholders.size() + 1
+    vector<Placeholder> placeholders;  ///< Declared placeholders only
+    std::optional<long long> timeoutMs;
+    int prefetchRows = 0;
+    bool cached = false;
+    string arrayParam;  ///< First ARRAY_* parameter; such applets get no wrapper
+};
+
+class CodegenError : public std::runtime_error {
+public:
+    CodegenError(const string& file, int line, const string& message)
+        : std::runtime_error(file + ":" + std::to_string(line) + ": " + message)
+    {
+    }
+};
+
+string trim(string_view text)
+{
+    const auto first = text.find_first_not_of(" \t\r\n");
+    if (first == string_view::npos) {
+        return {};
+    }
+    const auto last = text.find_last_not_of(" \t\r\n");
+    return string(text.substr(first, last - first + 1));
+}
+
+bool isIdentifier(string_view name)
+{
+    if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) {
+        return false;
+    }
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+    });
+}
+
+string upper(string_view text)
+{
+    string result(text);
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return result;
+}
+
+/// company_select.sql → CompanySelect
+string structNameOf(const std::filesystem::path& path)
+{
+    string name;
+    bool capitalize = true;
+    for (char c : path.stem().string()) {
+        if (!std::isalnum(static_cast<unsigned char>(c))) {
+            capitalize = true;
+            continue;
+        }
+        name += capitalize ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        capitalize = false;
+    }
+    return name;
+}
+
+// ============================================================================
+// Header parsing — mirrors SqlTemplate::loadAndParseFile()
+// ============================================================================
+
+/// Same units as SqlTemplate::parseDuration()
+std::optional<long long> parseDurationMs(string_view text)
+{
+    size_t digits = 0;
+    while (digits < text.size() && std::isdigit(static_cast<unsigned char>(text[digits]))) {
+        ++digits;
+    }
+    if (digits == 0) {
+        return std::nullopt;
+    }
+    const long long value = std::stoll(string(text.substr(0, digits)));
+    const string_view unit = text.substr(digits);
+    if (unit.empty() || unit == "ms") return value;
+    if (unit == "s")                  return value * 1000;
+    if (unit == "m" || unit == "min") return value * 60 * 1000;
+    return std::nullopt;
+}
+
+CppType cppTypeOf(const string& typeName, const string& defaultValue)
+{
+    const string type = upper(typeName);
+    if (type == "INT" || type == "NUMERIC") {
+        // SqlQuery binds a NUMERIC with a fraction as double
+        return defaultValue.find('.') != string::npos ? CppType::Double : CppType::Long;
+    }
+    if (type == "INT64")                       return CppType::Int64;
+    if (type == "DOUBLE")                      return CppType::Double;
+    if (type == "BOOL" || type == "BOOLEAN")   return CppType::Bool;
+    if (type == "STRING" || type == "DATETIME" || type == "DATETIMENOSEC" ||
+        type == "DATE" || type == "TIME") {
+        return CppType::String;
+    }
+    throw std::invalid_argument("Unknown parameter type '" + typeName + "'");
+}
+
+void parseParam(Applet& applet, const string& decl, int lineNo)
+{
+    std::istringstream iss(decl);
+    string name, type;
+    iss >> name >> type;
+    if (!isIdentifier(name)) {
+        throw CodegenError(applet.file, lineNo, "@param name '" + name + "' is not a C++ identifier");
+    }
+    if (type.empty()) {
+        throw CodegenError(applet.file, lineNo, "@param " + name + " has no type");
+    }
+
+    Param param;
+    param.name = name;
+
+    string remaining;
+    std::getline(iss, remaining);
+    const auto eq = remaining.find('=');
+    if (eq != string::npos) {
+        const string keyword = trim(string_view(remaining).substr(0, eq));
+        if (keyword == "default" || keyword.empty()) {
+            param.defaultValue = trim(string_view(remaining).substr(eq + 1));
+            if (param.defaultValue.size() >= 2 && param.defaultValue.front() == '\'' &&
+                param.defaultValue.back() == '\'') {
+                param.defaultValue = param.defaultValue.substr(1, param.defaultValue.size() - 2);
+            }
+            param.hasDefault = true;
+        }
+    }
+
+    try {
+        const string upperType = upper(type);
+        if (upperType.starts_with("ARRAY_")) {
+            // Rendered per client and array length by SqlTemplate; no wrapper
+            const string element = upperType.substr(6);
+            if (element != "INT" && element != "INT64" && element != "STRING") {
+                throw std::invalid_argument("Unknown parameter type '" + type + "'");
+            }
+            if (applet.arrayParam.empty()) {
+                applet.arrayParam = name;
+            }
+            param.type = CppType::String;
+        } else {
+            param.type = cppTypeOf(type, param.defaultValue);
+        }
+    } catch (const std::invalid_argument& e) {
+        throw CodegenError(applet.file, lineNo, e.what());
+    }
+    if (std::any_of(applet.params.begin(), applet.params.end(),
+                    [&](const Param& p) { return p.name == name; })) {
+        throw CodegenError(applet.file, lineNo, "@param " + name + " declared twice");
+    }
+    applet.params.push_back(std::move(param));
+}
+
+void parseDirective(Applet& applet, const string& name, const string& args, int lineNo,
+                    vector<string>& cacheKeys)
+{
+    std::istringstream iss(args);
+    if (name == "timeout") {
+        string value;
+        iss >> value;
+        applet.timeoutMs = parseDurationMs(value);
+        if (!applet.timeoutMs) {
+            throw CodegenError(applet.file, lineNo, "Invalid @timeout '" + value + "'");
+        }
+    } else if (name == "prefetch") {
+        if (!(iss >> applet.prefetchRows) || applet.prefetchRows <= 0) {
+            throw CodegenError(applet.file, lineNo, "@prefetch needs a positive row count");
+        }
+    } else if (name == "cache") {
+        bool hasTtl = false;
+        string token;
+        while (iss >> token) {
+            if (token.starts_with("ttl=")) {
+                const auto ttl = parseDurationMs(string_view(token).substr(4));
+                hasTtl = ttl && *ttl > 0;
+            } else if (token.starts_with("key=")) {
+                std::istringstream keys(token.substr(4));
+                string key;
+                while (std::getline(keys, key, ',')) {
+                    if (!key.empty()) {
+                        cacheKeys.push_back(key);
+                    }
+                }
+            } else {
+                throw CodegenError(applet.file, lineNo, "Unknown @cache option '" + token + "'");
+            }
+        }
+        if (!hasTtl) {
+            throw CodegenError(applet.file, lineNo, "@cache needs ttl=<duration>");
+        }
+        applet.cached = true;
+    } else {
+        throw CodegenError(applet.file, lineNo, "Unknown directive '@" + name + "'");
+    }
+}
+
+/// Split @p sql at its declared placeholders (same scan as SqlTemplate::findPlaceholders())
+void splitBody(Applet& applet, const string& sql)
+{
+    string segment;
+    for (size_t i = 0; i < sql.size(); ++i) {
+        const char c = sql[i];
+        const bool bind = c == ':' && i + 1 < sql.size() && sql[i + 1] != ':' && sql[i + 1] != '=';
+        const bool identifier = c == '$' && i + 1 < sql.size();
+        if (c == ':' && i + 1 < sql.size() && sql[i + 1] == ':') {
+            segment += "::";  // PostgreSQL cast
+            ++i;
+            continue;
+        }
+        if (!bind && !identifier) {
+            segment += c;
+            continue;
+        }
+
+        size_t end = i + 1;
+        while (end < sql.size() &&
+               (std::isalnum(static_cast<unsigned char>(sql[end])) || sql[end] == '_')) {
+            ++end;
+        }
+        const string name = sql.substr(i + 1, end - i - 1);
+        const bool declared = std::any_of(applet.params.begin(), applet.params.end(),
+                                          [&](const Param& p) { return p.name == name; });
+        if (name.empty() || !declared) {
+            // Not a placeholder, or unknown: kept as-is like SqlTemplate does
+            segment += sql.substr(i, std::max<size_t>(end - i, 1));
+            i = std::max(end, i + 1) - 1;
+            continue;
+        }
+
+        applet.segments.push_back(std::move(segment));
+        segment.clear();
+        applet.placeholders.push_back({name, identifier});
+        i = end - 1;
+    }
+    applet.segments.push_back(std::move(segment));
+}
+
+Applet parseApplet(const std::filesystem::path& path)
+{
+    Applet applet;
+    applet.file = path.filename().string();
+    applet.structName = structNameOf(path);
+
+    std::ifstream in(path);
+    if (!in) {
+        throw CodegenError(path.string(), 0, "cannot open file");
+    }
+
+    vector<string> cacheKeys;
+    string line;
+    string body;
+    bool inHeader = true;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        if (!inHeader) {
+            body += line;
+            body += '\n';
+            continue;
+        }
+
+        if (line.starts_with("-- @param ") && line.size() > 10) {
+            parseParam(applet, trim(string_view(line).substr(10)), lineNo);
+            continue;
+        }
+        if (line.starts_with("-- @") && !line.starts_with("-- @param")) {
+            const string directive = trim(string_view(line).substr(4));
+            const auto nameEnd = directive.find_first_of(" \t");
+            parseDirective(applet, directive.substr(0, nameEnd),
+                           nameEnd == string::npos ? string() : directive.substr(nameEnd + 1),
+                           lineNo, cacheKeys);
+            continue;
+        }
+        if (line.starts_with("--")) {
+            const auto start = line.find_first_not_of("- \t");
+            if (applet.description.empty() && start != string::npos) {
+                const string content = trim(string_view(line).substr(start));
+                const bool fileComment = content.find(".sql") != string::npos ||
+                                         content.find(".xml") != string::npos;
+                if (!content.empty() && !content.starts_with("@param") && !fileComment) {
+                    applet.description = content;
+                }
+            }
+            continue;
+        }
+        if (trim(line).empty()) {
+            continue;
+        }
+        inHeader = false;
+        body += line;
+        body += '\n';
+    }
+
+    if (body.empty()) {
+        throw CodegenError(applet.file, lineNo, "No SQL body");
+    }
+    for (const auto& key : cacheKeys) {
+        if (std::none_of(applet.params.begin(), applet.params.end(),
+                         [&](const Param& p) { return p.name == key; })) {
+            throw CodegenError(applet.file, 0, "@cache key '" + key + "' is not a declared @param");
+        }
+    }
+
+    splitBody(applet, body);
+    return applet;
+}
+
+// ============================================================================
+// Code emission
+// ============================================================================
+
+string cppStringLiteral(string_view text)
+{
+    string out = "\"";
+    for (char c : text) {
+        switch (c) {
+        case '\\': out += "\\\\"; break;
+        case '"':  out += "\\\""; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        default:   out += c; break;
+        }
+    }
+    return out + "\"";
+}
+
+string cppTypeName(CppType type)
+{
+    switch (type) {
+    case CppType::Long:   return "long";
+    case CppType::Int64:  return "int64_t";
+    case CppType::Double: return "double";
+    case CppType::Bool:   return "bool";
+    case CppType::String: return "std::string";
+    }
+    return "std::string";
+}
+
+string cppDefault(const Applet& applet, const Param& param)
+{
+    if (!param.hasDefault || (param.type != CppType::String && param.defaultValue.empty())) {
+        return param.type == CppType::String ? "" : (param.type == CppType::Bool ? " = false" : " = 0");
+    }
+    switch (param.type) {
+    case CppType::String:
+        return " = " + cppStringLiteral(param.defaultValue);
+    case CppType::Bool:
+        return (param.defaultValue == "true" || param.defaultValue == "1") ? " = true" : " = false";
+    default: {
+        // The default must be a number; anything else would not compile anyway
+        std::istringstream iss(param.defaultValue);
+        double number = 0;
+        string rest;
+        if (!(iss >> number) || (iss >> rest)) {
+            throw CodegenError(applet.file, 0,
+                               "default of @param " + param.name + " is not a number: " + param.defaultValue);
+        }
+        return " = " + param.defaultValue;
+    }
+    }
+}
+
+string bindStatement(const Param& param)
+{
+    const string target = "        cmd.Param(_TSA(\"" + param.name + "\"))";
+    switch (param.type) {
+    case CppType::Long:   return target + ".setAsLong() = " + param.name + ";\n";
+    case CppType::Int64:  return target + ".setAsLong() = static_cast<long>(" + param.name + ");\n";
+    case CppType::Double: return target + ".setAsDouble() = " + param.name + ";\n";
+    case CppType::Bool:   return target + ".setAsBool() = " + param.name + ";\n";
+    case CppType::String:
+        // "NULL" binds SQL NULL, as SqlCommand/SqlQuery do for SqlTemplate values
+        return "        if (" + param.name + " == \"NULL\") {\n"
+               "    " + target + ".setAsNull();\n"
+               "        } else {\n"
+               "    " + target + ".setAsString() = SAString(" + param.name + ".c_str());\n"
+               "        }\n";
+    }
+    return {};
+}
+
+void emitApplet(std::ostream& out, const Applet& applet)
+{
+    if (!applet.arrayParam.empty()) {
+        out << "// " << applet.file << ": ARRAY parameter " << applet.arrayParam
+            << " is rendered by SqlTemplate; no wrapper generated\n\n";
+        return;
+    }
+
+    auto paramOf = [&applet](const string& name) {
+        return &*std::find_if(applet.params.begin(), applet.params.end(),
+                              [&](const Param& p) { return p.name == name; });
+    };
+
+    vector<string> identifiers;
+    std::set<string> bound;
+    vector<const Param*> bindOrder;
+    for (const auto& ph : applet.placeholders) {
+        if (ph.identifier) {
+            if (std::find(identifiers.begin(), identifiers.end(), ph.name) == identifiers.end()) {
+                identifiers.push_back(ph.name);
+            }
+        } else if (bound.insert(ph.name).second) {
+            bindOrder.push_back(paramOf(ph.name));
+        }
+    }
+
+    string description = applet.description;
+    for (size_t pos; (pos = description.find("*/")) != string::npos;) {
+        description.replace(pos, 2, "* /");
+    }
+
+    if (description.empty()) {
+        out << "/// " << applet.file << "\n";
+    } else {
+        out << "/// " << description << " (" << applet.file << ")\n";
+    }
+    out << "struct " << applet.structName << " {\n";
+    out << "    static constexpr std::string_view FILE_NAME = " << cppStringLiteral(applet.file) << ";\n";
+    if (applet.timeoutMs) {
+        out << "    static constexpr std::optional<std::chrono::milliseconds> TIMEOUT{std::chrono::milliseconds("
+            << *applet.timeoutMs << ")};\n";
+    } else {
+        out << "    static constexpr std::optional<std::chrono::milliseconds> TIMEOUT{};\n";
+    }
+    out << "    static constexpr int PREFETCH_ROWS = " << applet.prefetchRows << ";\n";
+    if (applet.cached) {
+        out << "    // @cache is honored by SqlQuery::fetchAll() only\n";
+    }
+    out << "\n";
+
+    out << "    /// SQL between placeholders: PLACEHOLDERS[i] sits between SEGMENTS[i] and SEGMENTS[i + 1]\n";
+    out << "    static constexpr std::array<std::string_view, " << applet.segments.size() << "> SEGMENTS = {\n";
+    for (const auto& segment : applet.segments) {
+        out << "        " << cppStringLiteral(segment) << ",\n";
+    }
+    out << "    };\n";
+    out << "    static constexpr std::array<std::string_view, " << applet.placeholders.size()
+        << "> PLACEHOLDERS = {";
+    for (size_t i = 0; i < applet.placeholders.size(); ++i) {
+        out << (i ? ", " : "") << cppStringLiteral((applet.placeholders[i].identifier ? "$" : ":") +
+                                                   applet.placeholders[i].name);
+    }
+    out << "};\n";
+
+    if (identifiers.empty()) {
+        string sql;
+        for (size_t i = 0; i < applet.segments.size(); ++i) {
+            sql += applet.segments[i];
+            if (i < applet.placeholders.size()) {
+                sql += ":" + applet.placeholders[i].name;
+            }
+        }
+        out << "    static constexpr std::string_view SQL = " << cppStringLiteral(sql) << ";\n";
+    }
+    out << "\n";
+
+    for (const auto& param : applet.params) {
+        out << "    " << cppTypeName(param.type) << " " << param.name << cppDefault(applet, param) << ";\n";
+    }
+    out << "\n";
+
+    // sql()
+    if (identifiers.empty()) {
+        out << "    /// SQL with :NAME markers for bind()\n";
+        out << "    static std::string sql() { return std::string(SQL); }\n\n";
+    } else {
+        out << "    /// SQL with :NAME markers for bind(); $identifiers resolved through the allow-lists\n";
+        out << "    std::string sql(";
+        for (size_t i = 0; i < identifiers.size(); ++i) {
+            out << (i ? ", " : "") << "const ColumnAllowListBase& " << identifiers[i] << "_columns";
+        }
+        out << ") const\n    {\n";
+        size_t length = 0;
+        for (const auto& segment : applet.segments) {
+            length += segment.size();
+        }
+        out << "        std::string out;\n";
+        out << "        out.reserve(" << length + 32 * applet.placeholders.size() << ");\n";
+        for (size_t i = 0; i < applet.segments.size(); ++i) {
+            out << "        out += SEGMENTS[" << i << "];\n";
+            if (i < applet.placeholders.size()) {
+                const auto& ph = applet.placeholders[i];
+                if (ph.identifier) {
+                    out << "        out += '\"';\n";
+                    out << "        out += " << ph.name << "_columns.resolve(" << ph.name << ");\n";
+                    out << "        out += '\"';\n";
+                } else {
+                    out << "        out += \":" << ph.name << "\";\n";
+                }
+            }
+        }
+        out << "        return out;\n    }\n\n";
+    }
+
+    // bind()
+    out << "    /// Bind the :NAME markers of sql() (and PREFETCH_ROWS) on @p cmd\n";
+    out << "    void bind(SACommand& cmd) const\n    {\n";
+    if (bindOrder.empty() && applet.prefetchRows == 0) {
+        out << "        (void)cmd;\n";
+    }
+    for (const Param* param : bindOrder) {
+        out << bindStatement(*param);
+    }
+    if (applet.prefetchRows > 0) {
+        out << "        cmd.setOption(_TSA(\"PreFetchRows\")) = _TSA(\"" << applet.prefetchRows << "\");\n";
+    }
+    out << "    }\n";
+    out << "};\n\n";
+}
+
+string generate(const vector<Applet>& applets)
+{
+    std::ostringstream out;
+    out << "// Generated by sql_applet_codegen — do not edit.\n";
+    out << "// Change the .sql applet and rebuild instead.\n";
+    out << "#pragma once\n\n";
+    out << "#include \"column_allowlist.h\"\n\n";
+    out << "#include <SQLAPI.h>\n\n";
+    out << "#include <array>\n#include <chrono>\n#include <cstdint>\n#include <optional>\n"
+           "#include <string>\n#include <string_view>\n\n";
+    out << "namespace sql_applets {\n\n";
+    for (const auto& applet : applets) {
+        emitApplet(out, applet);
+    }
+    out << "} // namespace sql_applets\n";
+    return out.str();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::cerr << "usage: sql_applet_codegen <output-header> <applet.sql>..." << std::endl;
+        return 2;
+    }
+
+    try {
+        vector<Applet> applets;
+        std::set<string> names;
+        for (int i = 2; i < argc; ++i) {
+            Applet applet = parseApplet(argv[i]);
+            if (!isIdentifier(applet.structName) || !names.insert(applet.structName).second) {
+                throw CodegenError(applet.file, 0,
+                                   "struct name '" + applet.structName + "' is invalid or not unique");
+            }
+            applets.push_back(std::move(applet));
+        }
+        std::sort(applets.begin(), applets.end(),
+                  [](const Applet& a, const Applet& b) { return a.structName < b.structName; });
+
+        const std::filesystem::path output(argv[1]);
+        if (output.has_parent_path()) {
+            std::filesystem::create_directories(output.parent_path());
+        }
+        std::ofstream file(output, std::ios::binary);
+        file << generate(applets);
+        if (!file) {
+            throw std::runtime_error("cannot write " + output.string());
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "sql_applet_codegen: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
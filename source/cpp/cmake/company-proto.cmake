@@ -0,0 +1,63 @@
+# company-proto.cmake
+# Build-time generation of the company protobuf/gRPC stubs.
+#
+#   medicon_company_proto(<target>)
+#
+# Runs the protoc and grpc_cpp_plugin found by global-settings over
+# company.proto and health.proto (grpc.health.v1, served by
+# CompanyHealthService), so <target> always builds against stubs that match
+# the .proto instead of whatever copy is checked in under grpc/cpp-source. The
+# stubs are compiled once per project into the company_proto library; the
+# output directory goes ahead of grpc/cpp-source on <target>'s include path.
+# The generated files are also copied back to grpc/cpp-source, as the
+# grpc/cpp-source/company project does, to keep the checked-in copies current.
+
+function(medicon_company_proto target)
+    set(_out "${CMAKE_BINARY_DIR}/company-proto")
+
+    if(NOT TARGET company_proto)
+        set(_generated)
+        foreach(_name company health)
+            get_filename_component(_proto "${ALL_PROJECT_GRPC_PROTOS_PATH}/protos/${_name}.proto" ABSOLUTE)
+            get_filename_component(_proto_path "${_proto}" PATH)
+
+            set(_stubs
+                "${_out}/${_name}.pb.cc"
+                "${_out}/${_name}.pb.h"
+                "${_out}/${_name}.grpc.pb.cc"
+                "${_out}/${_name}.grpc.pb.h"
+            )
+
+            add_custom_command(
+                OUTPUT ${_stubs}
+                COMMAND ${CMAKE_COMMAND} -E make_directory "${_out}"
+                COMMAND ${_PROTOBUF_PROTOC}
+                    --grpc_out "${_out}"
+                    --cpp_out "${_out}"
+                    -I "${_proto_path}"
+                    --plugin=protoc-gen-grpc=${_GRPC_CPP_PLUGIN_EXECUTABLE}
+                    "${_proto}"
+                COMMAND ${CMAKE_COMMAND} -E copy_if_different ${_stubs} "${ALL_PROJECT_GRPC_CPP_SOURCE}"
+                DEPENDS "${_proto}"
+                COMMENT "Generating ${_name} protobuf/gRPC stubs"
+                VERBATIM
+            )
+            list(APPEND _generated ${_stubs})
+        endforeach()
+
+        add_library(company_proto STATIC ${_generated})
+        target_include_directories(company_proto BEFORE PUBLIC "${_out}")
+        target_link_libraries(company_proto
+            PUBLIC
+                absl::check
+                ${_REFLECTION}
+                ${_GRPC_GRPCPP}
+                ${_PROTOBUF_LIBPROTOBUF}
+        )
+    endif()
+
+    # Directory-level include_directories() come before usage requirements,
+    # so the generated headers must be prepended on the target itself
+    target_include_directories(${target} BEFORE PUBLIC "${_out}")
+    target_link_libraries(${target} PUBLIC company_proto)
+endfunction()
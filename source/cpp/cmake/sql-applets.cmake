@@ -0,0 +1,41 @@
+# sql-applets.cmake
+# Build-time generation of typed C++ wrappers for .sql applets.
+#
+#   medicon_sql_applets(<target> OUTPUT <header> FILES <applet.sql>...)
+#
+# Runs sql_applet_codegen over FILES and writes one header with a struct per
+# applet (namespace sql_applets). The header is regenerated whenever an
+# applet changes, added to <target>'s sources and its directory to <target>'s
+# include path. A malformed applet header fails the build.
+
+set(_SQL_APPLET_CODEGEN_SOURCE "${CMAKE_CURRENT_LIST_DIR}/../backend/sql-applet-codegen/main.cpp")
+
+if(NOT TARGET sql_applet_codegen)
+    add_executable(sql_applet_codegen ${_SQL_APPLET_CODEGEN_SOURCE})
+    set_target_properties(sql_applet_codegen PROPERTIES
+        CXX_STANDARD 20
+        CXX_STANDARD_REQUIRED ON
+    )
+endif()
+
+function(medicon_sql_applets target)
+    cmake_parse_arguments(ARG "" "OUTPUT" "FILES" ${ARGN})
+    if(NOT ARG_OUTPUT OR NOT ARG_FILES)
+        message(FATAL_ERROR "medicon_sql_applets: OUTPUT and FILES are required")
+    endif()
+
+    get_filename_component(_output_dir "${ARG_OUTPUT}" DIRECTORY)
+    get_filename_component(_output_name "${ARG_OUTPUT}" NAME)
+
+    add_custom_command(
+        OUTPUT "${ARG_OUTPUT}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${_output_dir}"
+        COMMAND sql_applet_codegen "${ARG_OUTPUT}" ${ARG_FILES}
+        DEPENDS sql_applet_codegen ${ARG_FILES}
+        COMMENT "Generating ${_output_name} from sql applets"
+        VERBATIM
+    )
+
+    target_sources(${target} PRIVATE "${ARG_OUTPUT}")
+    target_include_directories(${target} PUBLIC "${_output_dir}")
+endfunction()
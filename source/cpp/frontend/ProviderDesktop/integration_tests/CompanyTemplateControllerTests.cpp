@@ -0,0 +1,347 @@
+// ============================================================================
+// CompanyTemplateController live-update tests
+//
+// The controller talks to an in-process fake CompanyEditor service, so these
+// run without provider.exe or PostgreSQL. They cover the WatchCompanies
+// hooks: targeted row updates/deletes/inserts and resuming a dropped stream
+// from the last received epoch/sequence.
+// ============================================================================
+
+#include "gtest/gtest.h"
+
+#include "ModelItems/CompanyTableModel.h"
+#include "ModelItems/CompanyTemplateController.h"
+#include "GrpcForm.h"
+#include "GrpcObjectWrapper.hpp"
+#include "GrpcProxySortFilterModel.h"
+#include "GrpcTableView.h"
+
+#include <grpcpp/grpcpp.h>
+
+#include <QAction>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QLineEdit>
+#include <QMainWindow>
+#include <QThread>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+using CompanyEdit::CompanyChange;
+using CompanyEdit::CompanyEditor;
+using CompanyEdit::CompanyList;
+using CompanyEdit::CompanyUid;
+using CompanyEdit::JsonParameters;
+using CompanyEdit::WatchRequest;
+
+namespace {
+
+constexpr int TEST_SERVER_UID = 30003;
+constexpr uint64_t FEED_EPOCH = 7;
+
+void processEventsUntil(const std::function<bool()> & predicate, int timeoutMs = 3000)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!predicate() && timer.elapsed() < timeoutMs) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 25);
+        QThread::msleep(5);
+    }
+}
+
+Company makeCompany(const std::string & uid, const std::string & name)
+{
+    Company company;
+    company.set_uid(uid);
+    company.set_server_uid(TEST_SERVER_UID);
+    company.set_name(name);
+    return company;
+}
+
+// Company table + WatchCompanies feed held in memory
+class FakeCompanyEditor final : public CompanyEditor::Service
+{
+public:
+    grpc::Status QueryCompanies(grpc::ServerContext *, const JsonParameters *, CompanyList * list) override
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto & company : m_companies) {
+            *list->add_companies() = company;
+        }
+        return grpc::Status::OK;
+    }
+
+    grpc::Status QueryCompanyByUid(grpc::ServerContext *, const CompanyUid * request, Company * response) override
+    {
+        std::lock_guard lock(m_mutex);
+        for (const auto & company : m_companies) {
+            if (company.uid() == request->uid()) {
+                *response = company;
+                return grpc::Status::OK;
+            }
+        }
+        return grpc::Status(grpc::StatusCode::NOT_FOUND, "No record found");
+    }
+
+    grpc::Status WatchCompanies(grpc::ServerContext * context, const WatchRequest * request,
+                                grpc::ServerWriter<CompanyChange> * writer) override
+    {
+        std::unique_lock lock(m_mutex);
+        m_watchRequests.push_back(*request);
+        const uint64_t stream = ++m_streams;
+
+        CompanyChange hello;
+        hello.set_epoch(FEED_EPOCH);
+        hello.set_sequence(m_sequence);
+        hello.set_operation(CompanyEdit::CHANGE_HEARTBEAT);
+        if (!writer->Write(hello)) {
+            return grpc::Status::OK;
+        }
+        m_cv.notify_all();
+
+        while (!context->IsCancelled() && stream > m_dropped) {
+            if (m_pending.empty()) {
+                m_cv.wait_for(lock, std::chrono::milliseconds(20));
+                continue;
+            }
+            CompanyChange change = m_pending.front();
+            m_pending.pop_front();
+            if (!writer->Write(change)) {
+                break;
+            }
+        }
+        return grpc::Status::OK;
+    }
+
+    void setCompanies(std::vector<Company> companies)
+    {
+        std::lock_guard lock(m_mutex);
+        m_companies = std::move(companies);
+    }
+
+    // Changes the table and publishes the matching change event
+    void publish(CompanyEdit::ChangeOperation operation, const Company & company)
+    {
+        std::lock_guard lock(m_mutex);
+        auto it = std::find_if(m_companies.begin(), m_companies.end(), [&](const Company & c) {
+            return c.uid() == company.uid();
+        });
+        if (operation == CompanyEdit::CHANGE_DELETE) {
+            if (it != m_companies.end()) {
+                m_companies.erase(it);
+            }
+        } else if (it != m_companies.end()) {
+            *it = company;
+        } else {
+            m_companies.push_back(company);
+        }
+
+        CompanyChange change;
+        change.set_epoch(FEED_EPOCH);
+        change.set_sequence(++m_sequence);
+        change.set_operation(operation);
+        change.set_uid(company.uid());
+        change.set_server_uid(TEST_SERVER_UID);
+        m_pending.push_back(change);
+        m_cv.notify_all();
+    }
+
+    // Ends the open stream as a server restart or network drop would
+    void dropStream()
+    {
+        std::lock_guard lock(m_mutex);
+        m_dropped = m_streams;
+        m_cv.notify_all();
+    }
+
+    bool waitForStreams(size_t count, int timeoutMs = 3000)
+    {
+        std::unique_lock lock(m_mutex);
+        return m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&] {
+            return m_watchRequests.size() >= count;
+        });
+    }
+
+    std::vector<WatchRequest> watchRequests()
+    {
+        std::lock_guard lock(m_mutex);
+        return m_watchRequests;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<Company> m_companies;
+    std::deque<CompanyChange> m_pending;
+    std::vector<WatchRequest> m_watchRequests;
+    uint64_t m_sequence = 100;
+    uint64_t m_streams = 0;
+    uint64_t m_dropped = 0;
+};
+
+class CompanyTestForm : public GrpcForm
+{
+public:
+    explicit CompanyTestForm(QWidget * parent = nullptr)
+        : GrpcForm(new GrpcObjectWrapper<Company>(), nullptr, parent)
+    {
+        initializeForm();
+    }
+
+    void initializeForm() override
+    {
+        auto * wrapper = dynamic_cast<GrpcObjectWrapper<Company> *>(objectWrapper());
+        if (!wrapper) {
+            return;
+        }
+        auto * nameEdit = new QLineEdit(this);
+        nameEdit->setObjectName("Name");
+        wrapper->addProperty("Name", DataInfo::String, stringSetter<Company>(&Company::set_name), &Company::name);
+    }
+
+    QVariant defaultObject() override
+    {
+        return QVariant::fromValue(makeCompany("", ""));
+    }
+};
+
+class CompanyTemplateControllerFixture : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        if (!qApp) {
+            static int argc = 0;
+            static char * argv[] = { nullptr };
+            s_app = new QApplication(argc, argv);
+        }
+    }
+
+    void SetUp() override
+    {
+        service.setCompanies({ makeCompany("A", "Alpha"), makeCompany("B", "Beta") });
+
+        grpc::ServerBuilder builder;
+        builder.RegisterService(&service);
+        server = builder.BuildAndStart();
+        ASSERT_NE(server, nullptr);
+
+        mainWindow = std::make_unique<QMainWindow>();
+        sourceModel = new CompanyTableModel({}, mainWindow.get());
+        proxyModel = std::make_unique<GrpcProxySortFilterModel>(sourceModel, QList<int>{}, mainWindow.get());
+        view = std::make_unique<GrpcTableView>(mainWindow.get());
+        form = std::make_unique<CompanyTestForm>(mainWindow.get());
+
+        controller = std::make_unique<CompanyTemplateController>(
+            server->InProcessChannel(grpc::ChannelArguments()), TEST_SERVER_UID,
+            proxyModel.get(), view.get(), form.get(), mainWindow.get());
+        // Keep warnings from opening modal message boxes
+        QObject::disconnect(controller.get(), &GrpcTemplateController::warning, view.get(), &GrpcTableView::showWarning);
+
+        // Initial page load (F5)
+        QAction * refresh = controller->findChild<QAction *>("actionRefresh");
+        ASSERT_NE(refresh, nullptr);
+        refresh->trigger();
+        processEventsUntil([this] { return sourceModel->rowCount() == 2; });
+        ASSERT_EQ(sourceModel->rowCount(), 2);
+        ASSERT_TRUE(service.waitForStreams(1));
+    }
+
+    void TearDown() override
+    {
+        controller.reset();
+        form.reset();
+        view.reset();
+        proxyModel.reset();
+        mainWindow.reset();
+        sourceModel = nullptr;
+        if (server) {
+            server->Shutdown();
+        }
+    }
+
+    QString nameAt(int row) const
+    {
+        return QString::fromStdString(sourceModel->variantObject(row).value<Company>().name());
+    }
+
+    int rowOf(const std::string & uid) const
+    {
+        for (int row = 0; row < sourceModel->rowCount(); ++row) {
+            if (sourceModel->variantObject(row).value<Company>().uid() == uid) {
+                return row;
+            }
+        }
+        return -1;
+    }
+
+    static QApplication * s_app;
+
+    FakeCompanyEditor service;
+    std::unique_ptr<grpc::Server> server;
+
+    std::unique_ptr<QMainWindow> mainWindow;
+    CompanyTableModel * sourceModel = nullptr;
+    std::unique_ptr<GrpcProxySortFilterModel> proxyModel;
+    std::unique_ptr<GrpcTableView> view;
+    std::unique_ptr<CompanyTestForm> form;
+    std::unique_ptr<CompanyTemplateController> controller;
+};
+
+QApplication * CompanyTemplateControllerFixture::s_app = nullptr;
+
+} // namespace
+
+TEST_F(CompanyTemplateControllerFixture, ControllerWatchesFromCurrentPosition)
+{
+    const auto requests = service.watchRequests();
+    ASSERT_EQ(requests.size(), 1u);
+    EXPECT_EQ(requests[0].server_uid(), TEST_SERVER_UID);
+    EXPECT_FALSE(requests[0].has_resume_sequence());
+}
+
+TEST_F(CompanyTemplateControllerFixture, RemoteUpdateRefreshesRow)
+{
+    service.publish(CompanyEdit::CHANGE_UPDATE, makeCompany("B", "Beta v2"));
+
+    processEventsUntil([this] { return rowOf("B") >= 0 && nameAt(rowOf("B")) == "Beta v2"; });
+    EXPECT_EQ(nameAt(rowOf("B")), "Beta v2");
+    EXPECT_EQ(sourceModel->rowCount(), 2);
+}
+
+TEST_F(CompanyTemplateControllerFixture, RemoteInsertAndDeleteChangeRows)
+{
+    service.publish(CompanyEdit::CHANGE_INSERT, makeCompany("C", "Gamma"));
+    processEventsUntil([this] { return rowOf("C") >= 0; });
+    ASSERT_GE(rowOf("C"), 0);
+    EXPECT_EQ(nameAt(rowOf("C")), "Gamma");
+
+    service.publish(CompanyEdit::CHANGE_DELETE, makeCompany("A", ""));
+    processEventsUntil([this] { return rowOf("A") < 0; });
+    EXPECT_LT(rowOf("A"), 0);
+    EXPECT_EQ(sourceModel->rowCount(), 2);
+}
+
+TEST_F(CompanyTemplateControllerFixture, DroppedStreamResumesFromLastSequence)
+{
+    service.publish(CompanyEdit::CHANGE_UPDATE, makeCompany("A", "Alpha v2"));
+    processEventsUntil([this] { return rowOf("A") >= 0 && nameAt(rowOf("A")) == "Alpha v2"; });
+    ASSERT_EQ(nameAt(rowOf("A")), "Alpha v2");
+
+    service.dropStream();
+    ASSERT_TRUE(service.waitForStreams(2));
+
+    const auto requests = service.watchRequests();
+    ASSERT_TRUE(requests[1].has_resume_sequence());
+    EXPECT_EQ(requests[1].epoch(), FEED_EPOCH);
+    EXPECT_EQ(requests[1].resume_sequence(), 101u);
+
+    // Changes after the reconnect still arrive
+    service.publish(CompanyEdit::CHANGE_UPDATE, makeCompany("B", "Beta v3"));
+    processEventsUntil([this] { return rowOf("B") >= 0 && nameAt(rowOf("B")) == "Beta v3"; });
+    EXPECT_EQ(nameAt(rowOf("B")), "Beta v3");
+}
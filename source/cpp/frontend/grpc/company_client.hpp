@@ -1,7 +1,9 @@
 #include <grpcpp/grpcpp.h>
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 
@@ -20,9 +22,17 @@ using CompanyEdit::CompanyEditor;
 using CompanyEdit::Company;
 using CompanyEdit::CompanyResult;
 using CompanyEdit::CompanyList;
+using CompanyEdit::CompanyPage;
 using CompanyEdit::JsonParameters;
 using CompanyEdit::CompanyUid;
+using CompanyEdit::CompanyUids;
+using CompanyEdit::CompanyLookup;
 using CompanyEdit::TotalCount;
+using CompanyEdit::CompanyQuery;
+using CompanyEdit::WatchRequest;
+using CompanyEdit::CompanyChange;
+using CompanyEdit::SyncRequest;
+using CompanyEdit::SyncResponse;
 
 
 
@@ -69,11 +79,69 @@ public:
         ClientContext context;
         return stub_->QueryCompanyByUid(&context, uid, &result);
     }
+    // Found companies in request order plus the UIDs that have no row
+    Status QueryCompaniesByUids(const CompanyUids & uids, CompanyLookup & result) {
+        ClientContext context;
+        return stub_->QueryCompaniesByUids(&context, uids, &result);
+    }
     Status QueryCompanyTotalCount(const JsonParameters & params, TotalCount & result) {
         ClientContext context;
         return stub_->QueryCompanyTotalCount(&context, params, &result);
     }
 
+    // Typed query overloads (ListCompanies/CountCompanies RPCs)
+    Status QueryCompanies(const CompanyQuery & query, std::vector<Company> & object_list,
+                          std::string * next_cursor = nullptr) {
+        ClientContext context;
+        CompanyList list;
+
+        Status status = stub_->ListCompanies(&context, query, &list);
+        if (status.ok()) {
+            for (const auto & object : list.companies()) {
+                object_list.push_back(object);
+            }
+            if (next_cursor) {
+                *next_cursor = list.next_cursor();
+            }
+        }
+        return status;
+    }
+
+    Status QueryCompanyTotalCount(const CompanyQuery & query, TotalCount & result) {
+        ClientContext context;
+        return stub_->CountCompanies(&context, query, &result);
+    }
+
+    // Page and total from one server-side snapshot
+    Status QueryCompanyPage(const CompanyQuery & query, CompanyPage & result) {
+        ClientContext context;
+        return stub_->ListCompanyPage(&context, query, &result);
+    }
+
+    // Blocks until the stream ends, onChange returns false or context is
+    // cancelled (context.TryCancel() from another thread).
+    Status WatchCompanies(ClientContext & context, const WatchRequest & request,
+                          const std::function<bool(const CompanyChange &)> & onChange) {
+        std::unique_ptr<grpc::ClientReader<CompanyChange>> reader(
+            stub_->WatchCompanies(&context, request));
+
+        CompanyChange change;
+        while (reader->Read(&change)) {
+            if (!onChange(change)) {
+                context.TryCancel();
+                break;
+            }
+        }
+        return reader->Finish();
+    }
+
+    // One delta batch; call again with result.version() while has_more() is set.
+    // result.reset(): drop the cache and start over from version 0 with snapshot set.
+    Status SyncCompanies(const SyncRequest & request, SyncResponse & result) {
+        ClientContext context;
+        return stub_->SyncCompanies(&context, request, &result);
+    }
+
 private:
     std::unique_ptr<CompanyEditor::Stub> stub_;
 };
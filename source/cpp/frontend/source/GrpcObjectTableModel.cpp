@@ -99,6 +99,17 @@ void GrpcObjectTableModel::addNewObject(const QVariant & data)
     insertObject(rowCount(), data);
 }
 
+void GrpcObjectTableModel::appendRemoteObject(const QVariant & data)
+{
+    if (!data.isValid()) {
+        throw std::invalid_argument("Cannot insert invalid QVariant data");
+    }
+
+    const int row = m_container->count();
+    insertRow(row);
+    m_container->insertObject(row, data);
+}
+
 void GrpcObjectTableModel::updateObject(int row, const QVariant &data)
 {
     if (row < 0 || row >= m_container->count()) {
@@ -142,6 +142,16 @@ public slots:
      * @note Emits inserted(row) signal on success
      */
     void addNewObject(const QVariant & data);
+
+    /**
+     * @brief Appends an object that was created by another client
+     * @param data The object to add as QVariant
+     * @throws std::invalid_argument if data is invalid or cannot be converted
+     *
+     * @note Unlike addNewObject() this does NOT emit inserted(row), so the
+     *       user's current selection is left alone.
+     */
+    void appendRemoteObject(const QVariant & data);
     
     /**
      * @brief Updates the object at the specified row
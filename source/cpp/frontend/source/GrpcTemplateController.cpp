@@ -8,6 +8,8 @@
 #include <QStatusBar>
 #include <QtConcurrent/QtConcurrent>
 
+#include <utility>
+
 #include "GrpcForm.h"
 #include "GrpcObjectTableModel.h"
 #include "GrpcProxySortFilterModel.h"
@@ -23,6 +25,7 @@ GrpcTemplateController::GrpcTemplateController(GrpcProxySortFilterModel * proxyM
                                                GrpcTableView  * view, GrpcForm * form, IBaseGrpcObjectWrapper * masterObjectWrapper, QObject *parent)
     : QObject{parent}
     , m_masterObjectWrapper(masterObjectWrapper)
+    , m_proxyModel(proxyModel)
 {
     Q_ASSERT(proxyModel);
     Q_ASSERT(view);
@@ -30,6 +33,8 @@ GrpcTemplateController::GrpcTemplateController(GrpcProxySortFilterModel * proxyM
 
     GrpcObjectTableModel * sourceModel = qobject_cast<GrpcObjectTableModel*>(proxyModel->sourceModel());
     Q_ASSERT(sourceModel);
+    m_sourceModel = sourceModel;
+    m_watchPool.setMaxThreadCount(1);
     connect(this, &GrpcTemplateController::clearModelDataRequested, sourceModel, &GrpcObjectTableModel::clearModelData);
 
     // Init actions
@@ -135,6 +140,7 @@ GrpcTemplateController::GrpcTemplateController(GrpcProxySortFilterModel * proxyM
     connect(this, &GrpcTemplateController::addNewObject, sourceModel, &GrpcObjectTableModel::addNewObject);
     connect(this, &GrpcTemplateController::updateObject, sourceModel, &GrpcObjectTableModel::updateObject);
     connect(this, &GrpcTemplateController::deleteObject, sourceModel, &GrpcObjectTableModel::deleteObject);
+    connect(this, &GrpcTemplateController::appendRemoteObject, sourceModel, &GrpcObjectTableModel::appendRemoteObject);
 
     connect(&m_watcherLoad, &QFutureWatcher<void>::finished, this, &GrpcTemplateController::handleRefreshGrpc);
     connect(&m_watcherAddNew, &QFutureWatcher<QVariant>::finished, this, &GrpcTemplateController::handleAddNewGrpc);
@@ -144,6 +150,10 @@ GrpcTemplateController::GrpcTemplateController(GrpcProxySortFilterModel * proxyM
 
 GrpcTemplateController::~GrpcTemplateController()
 {
+    // Derived watchers should already have called stopWatching()
+    m_watchStop = true;
+    m_watchFuture.waitForFinished();
+
     if (m_templateToolBar) {
         m_templateToolBar->clear();
         m_templateToolBar->setVisible(false);
@@ -172,6 +182,7 @@ void GrpcTemplateController::addNavigator(GrpcViewNavigator * navigator)
     m_currentPage = 1;
     m_maxPages = navigator->maxPages();
     connect(this, &GrpcTemplateController::navigatorRecordCount, navigator, &GrpcViewNavigator::synchronizeByRecords);
+    connect(this, &GrpcTemplateController::navigatorEstimatedRecordCount, navigator, &GrpcViewNavigator::synchronizeByEstimatedRecords);
     connect(navigator, &GrpcViewNavigator::pageSelected, this, [this](int page) {
         m_currentPage = page;
         startLoadingData();
@@ -450,6 +461,7 @@ void GrpcTemplateController::handleAddNewGrpc()
         updateState();
         emit finishSave();
         m_grpcLoader->showLoader(false);
+        flushRemoteChanges();
      } catch (const QUnhandledException & e) {
 
      }
@@ -465,6 +477,7 @@ void GrpcTemplateController::handleEditGrpc()
         updateState();
         emit finishSave();
         m_grpcLoader->showLoader(false);
+        flushRemoteChanges();
     } catch (const QUnhandledException & e) {
 
     }
@@ -532,6 +545,7 @@ void GrpcTemplateController::escape()
         }
         updateState();
         emit finishSave();
+        flushRemoteChanges();
     }
 }
 
@@ -550,3 +564,120 @@ JsonParameterFormatter & GrpcTemplateController::searchCriterias()
 
 
 
+
+void GrpcTemplateController::startWatching()
+{
+    if (m_watchFuture.isRunning()) {
+        return;
+    }
+    m_watchStop = false;
+    m_watchFuture = QtConcurrent::run(&m_watchPool, &GrpcTemplateController::workerWatchChanges, this);
+}
+
+void GrpcTemplateController::stopWatching()
+{
+    m_watchStop = true;
+    cancelWatching();
+    m_watchFuture.waitForFinished();
+}
+
+void GrpcTemplateController::postRemoteChange(RemoteChange change, const QString & uid)
+{
+    QMetaObject::invokeMethod(this, [this, change, uid]() {
+        applyRemoteChange(change, uid);
+    }, Qt::QueuedConnection);
+}
+
+void GrpcTemplateController::applyRemoteChange(int change, const QString & uid)
+{
+    // Never pull the record out from under the user's form
+    if (m_state == Edit || m_state == Insert) {
+        m_pendingRemoteChanges.append({change, uid});
+        return;
+    }
+
+    if (change == RemoteReset) {
+        startLoadingData();
+        return;
+    }
+
+    const int sourceRow = sourceRowOfUid(uid);
+    if (change == RemoteDeleted) {
+        if (sourceRow < 0) {
+            return;
+        }
+        if (proxyRow(sourceRow) == m_currentRow) {
+            clearSelection();
+        }
+        emit deleteObject(sourceRow);
+        return;
+    }
+
+    // Updates of rows that are not on this page are irrelevant
+    if (change == RemoteUpdated && sourceRow < 0) {
+        return;
+    }
+    fetchRemoteObject(static_cast<RemoteChange>(change), uid);
+}
+
+void GrpcTemplateController::fetchRemoteObject(RemoteChange change, const QString & uid)
+{
+    auto * watcher = new QFutureWatcher<QVariant>(this);
+    connect(watcher, &QFutureWatcher<QVariant>::finished, this, [this, watcher, change, uid]() {
+        watcher->deleteLater();
+        QVariant object;
+        try {
+            object = watcher->result();
+        } catch (const QUnhandledException & e) {
+            return;
+        }
+        if (!object.isValid()) {
+            return;
+        }
+        if (m_state == Edit || m_state == Insert) {
+            m_pendingRemoteChanges.append({change, uid});
+            return;
+        }
+
+        // Rows may have moved while the object was being fetched
+        const int sourceRow = sourceRowOfUid(uid);
+        if (sourceRow >= 0) {
+            emit updateObject(sourceRow, object);
+            if (proxyRow(sourceRow) == m_currentRow && m_sourceModel) {
+                emit rowChanged(m_sourceModel->index(sourceRow, 0));
+            }
+        } else if (change == RemoteInserted) {
+            emit appendRemoteObject(object);
+        }
+    });
+    watcher->setFuture(QtConcurrent::run(&GrpcTemplateController::workerFetchObject, this, uid));
+}
+
+void GrpcTemplateController::flushRemoteChanges()
+{
+    const auto pending = std::exchange(m_pendingRemoteChanges, {});
+    for (const auto & [change, uid] : pending) {
+        applyRemoteChange(change, uid);
+    }
+}
+
+int GrpcTemplateController::sourceRowOfUid(const QString & uid) const
+{
+    if (!m_sourceModel || uid.isEmpty()) {
+        return -1;
+    }
+    for (int row = 0; row < m_sourceModel->rowCount(); ++row) {
+        if (objectUid(m_sourceModel->variantObject(row)) == uid) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+int GrpcTemplateController::proxyRow(int sourceRow) const
+{
+    if (!m_proxyModel || !m_sourceModel) {
+        return sourceRow;
+    }
+    return m_proxyModel->mapFromSource(m_sourceModel->index(sourceRow, 0)).row();
+}
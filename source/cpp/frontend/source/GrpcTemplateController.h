@@ -5,6 +5,9 @@
 #include <QPointer>
 #include <QVariant>
 #include <QFutureWatcher>
+#include <QThreadPool>
+
+#include <atomic>
 
 #include "JsonParameterFormatter.h"
 
@@ -51,6 +54,14 @@ class GrpcViewNavigator;
  *   `QMetaObject::invokeMethod(..., Qt::QueuedConnection)`), because emitting
  *   Qt signals from a worker thread can otherwise update UI/models from the
  *   wrong thread.
+ *
+ * Live updates:
+ * - `startWatching()` runs `workerWatchChanges()` on a dedicated pool thread.
+ *   The worker reports server-side changes with `postRemoteChange()`; they are
+ *   applied as targeted row updates by `applyRemoteChange()` on the
+ *   controller's thread, so no F5 reload is needed.
+ * - Derived classes that implement a watcher must call `stopWatching()` in
+ *   their destructor (the base destructor cannot reach `cancelWatching()`).
  */
 class GrpcTemplateController : public QObject
 {
@@ -74,6 +85,12 @@ public:
 
     enum State {Unselected = 0, Browsing, Edit, Insert};
 
+    /// Kind of change reported by `workerWatchChanges()`
+    enum RemoteChange {RemoteInserted = 1, RemoteUpdated, RemoteDeleted, RemoteReset};
+
+    void startWatching();
+    void stopWatching();
+
 signals:
     /**
      * @brief Emitted when the current row selection changed.
@@ -126,12 +143,19 @@ signals:
     void addNewObject(const QVariant & data);
     void updateObject(int row, const QVariant & data);
     void deleteObject(int row);
+    void appendRemoteObject(const QVariant & data);
 
     void warning(const QString & warningTitle, const QString & message);
     void clearForm();
     void clearViewSelection();
 
     void navigatorRecordCount(int count);
+    /**
+     * @brief Approximate record count (e.g. TotalCount.estimated from the server).
+     *
+     * The navigator shows "~N"; emit @ref navigatorRecordCount later to refine it.
+     */
+    void navigatorEstimatedRecordCount(int count);
 
 public slots:
     /**
@@ -160,6 +184,16 @@ public slots:
     void clearForMasterReload();
 
     void applySearchCriterias( const JsonParameterFormatter & searchCriterias);
+
+    /**
+     * @brief Applies one server-side change to the current page.
+     *
+     * Deleted rows are removed, updated rows are re-fetched through
+     * `workerFetchObject()`, inserted rows are appended without moving the
+     * selection, and `RemoteReset` falls back to a full reload. While the user
+     * edits or inserts a record, changes are queued and applied afterwards.
+     */
+    void applyRemoteChange(int change, const QString & uid);
     void showMenuAndToolbar();
     void hideMenuAndToolbar();
 
@@ -203,6 +237,28 @@ protected:
      */
     virtual QVariant workerDeleteObject(const QVariant & promise) = 0;
 
+    /**
+     * @brief Long-running worker that listens for server-side changes.
+     *
+     * Runs on a dedicated thread after `startWatching()`. Implementations call
+     * `postRemoteChange()` per event, reconnect/resume on errors, and return
+     * once `watchStopRequested()` is true. The default does nothing.
+     */
+    virtual void workerWatchChanges() {}
+
+    /// Interrupts a blocking `workerWatchChanges()` (e.g. ClientContext::TryCancel()).
+    virtual void cancelWatching() {}
+
+    /// Fetches a single object by uid (worker thread); invalid QVariant if not found.
+    virtual QVariant workerFetchObject(const QString & uid) { Q_UNUSED(uid); return {}; }
+
+    /// Returns the uid of an object held by the model; used to locate rows.
+    virtual QString objectUid(const QVariant & object) const { Q_UNUSED(object); return {}; }
+
+    /// Thread-safe: queues a change for `applyRemoteChange()` on the controller's thread.
+    void postRemoteChange(RemoteChange change, const QString & uid);
+    bool watchStopRequested() const { return m_watchStop; }
+
     // Override in child class for custom states
     virtual void updateState();
 
@@ -227,6 +283,11 @@ protected:
     int maxPages(){return m_maxPages;}
 
 private:
+    int sourceRowOfUid(const QString & uid) const;
+    int proxyRow(int sourceRow) const;
+    void fetchRemoteObject(RemoteChange change, const QString & uid);
+    void flushRemoteChanges();
+
     JsonParameterFormatter m_searchCriterias;
     std::unique_ptr<IBaseGrpcObjectWrapper> m_masterObjectWrapper;
 
@@ -252,6 +313,14 @@ private:
 
     int m_currentPage = -1;
     int m_maxPages = 0;
+
+    QPointer<GrpcProxySortFilterModel> m_proxyModel;
+    QPointer<GrpcObjectTableModel> m_sourceModel;
+
+    QThreadPool m_watchPool;
+    QFuture<void> m_watchFuture;
+    std::atomic<bool> m_watchStop{false};
+    QList<QPair<int, QString>> m_pendingRemoteChanges;
 };
 
 #endif // GRPCTEMPLATECONTROLLER_H
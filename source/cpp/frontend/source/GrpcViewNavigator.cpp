@@ -2,6 +2,8 @@
 
 #include <QScrollArea>
 #include <QHBoxLayout>
+#include <QLabel>
+#include <QLocale>
 #include <QPushButton>
 #include <QScrollBar>
 #include <QPropertyAnimation>
@@ -80,10 +82,16 @@ GrpcViewNavigator::GrpcViewNavigator(QWidget * parent)
 
     m_scrollArea->setWidget(m_containerWidget);
 
+    // Record count next to the page buttons
+    m_countLabel = new QLabel(this);
+    m_countLabel->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Preferred);
+    m_countLabel->setVisible(false);
+
     // Main layout for the panel itself
-    auto mainLayout = new QVBoxLayout(this);
+    auto mainLayout = new QHBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
-    mainLayout->addWidget(m_scrollArea);
+    mainLayout->addWidget(m_scrollArea, 1);
+    mainLayout->addWidget(m_countLabel);
     setLayout(mainLayout);
 }
 
@@ -295,10 +303,41 @@ void GrpcViewNavigator::synchronizeByPages(int pageCount)
 
 void GrpcViewNavigator::synchronizeByRecords(int rowCount)
 {
+    setRecordCount(rowCount, false);
     int pageCount = static_cast<int>(std::ceil(static_cast<double>(rowCount) / ScrollButtonHelper::maxPages));
     synchronizeByPages(pageCount);
 }
 
+void GrpcViewNavigator::synchronizeByEstimatedRecords(int rowCount)
+{
+    setRecordCount(rowCount, true);
+    int pageCount = static_cast<int>(std::ceil(static_cast<double>(rowCount) / ScrollButtonHelper::maxPages));
+    synchronizeByPages(pageCount);
+}
+
+QString GrpcViewNavigator::formatRecordCount(qint64 count, bool estimated)
+{
+    const QString number = QLocale().toString(count);
+    return estimated ? QStringLiteral("~") + number : number;
+}
+
+QString GrpcViewNavigator::recordCountText() const
+{
+    return m_countLabel->text();
+}
+
+void GrpcViewNavigator::setRecordCount(int rowCount, bool estimated)
+{
+    if(rowCount <= 0) {
+        m_countLabel->clear();
+        m_countLabel->setVisible(false);
+        return;
+    }
+    m_countLabel->setText(formatRecordCount(rowCount, estimated));
+    m_countLabel->setToolTip(estimated ? tr("Approximate number of records") : tr("Number of records"));
+    m_countLabel->setVisible(true);
+}
+
 void GrpcViewNavigator::selectPage(int page)
 {
     if(m_pages <= 0) {
@@ -102,6 +102,7 @@ private:
 class QScrollArea;
 class QHBoxLayout;
 class QPushButton;
+class QLabel;
 
 /**
  * @brief A scrollable pagination widget used by GRPC template controllers.
@@ -134,6 +135,20 @@ public:
      */
     int maxPages() const {return ScrollButtonHelper::maxPages;}
 
+    /**
+     * @brief Text of the record-count label ("12,400", or "~12,400" when estimated).
+     *
+     * Empty when there are no records.
+     */
+    QString recordCountText() const;
+
+    /**
+     * @brief Formats a record count with the locale's group separators.
+     *
+     * Estimated counts get a leading "~".
+     */
+    static QString formatRecordCount(qint64 count, bool estimated);
+
 public slots:
     /**
      * @brief Clears all pages and removes all buttons.
@@ -175,6 +190,14 @@ public slots:
      */
     void synchronizeByRecords(int rowCount);
 
+    /**
+     * @brief Same as @ref synchronizeByRecords, for an approximate record count.
+     *
+     * The count label shows "~N" until the next exact @ref synchronizeByRecords
+     * refines it. Used to render large, slow-to-count result sets at once.
+     */
+    void synchronizeByEstimatedRecords(int rowCount);
+
 private slots:
     /** @brief Handles clicking the left "..." (hidden pages) button. */
     void leftHidden();
@@ -208,6 +231,7 @@ private:
      */
     void rebuildWindow(int from);
     void clearAllButtons();
+    void setRecordCount(int rowCount, bool estimated);
 
 private:
     QScrollArea * m_scrollArea;
@@ -215,6 +239,7 @@ private:
     QWidget * m_centerWidget;
     QHBoxLayout * m_buttonLayout;
     QVector<ScrollableButton *> m_buttons;
+    QLabel * m_countLabel;
 
     int m_pages = 0;
     int m_currentPage = -1;
@@ -0,0 +1,204 @@
+#include "CompanyTemplateController.h"
+
+#include <QThread>
+
+#include <stdexcept>
+
+#include "company_client.hpp"
+#include "include_frontend_util.h"
+#include "GrpcDataContainer.hpp"
+
+using CommonUtil::sqlRowOffset;
+
+namespace {
+// Pause before reconnecting a dropped WatchCompanies stream
+constexpr int WATCH_RETRY_MS = 1000;
+constexpr int WATCH_RETRY_STEP_MS = 50;
+}
+
+CompanyTemplateController::CompanyTemplateController(std::shared_ptr<grpc::Channel> channel, int serverUid,
+                                                     GrpcProxySortFilterModel * proxyModel, GrpcTableView * tableView,
+                                                     GrpcForm * form, QObject * parent)
+    : GrpcTemplateController(proxyModel, tableView, form, nullptr, parent)
+    , m_client(std::make_unique<CompanyEditorClient>(std::move(channel)))
+    , m_serverUid(serverUid)
+{
+    startWatching();
+}
+
+CompanyTemplateController::~CompanyTemplateController()
+{
+    // cancelWatching() is not reachable from the base destructor
+    stopWatching();
+}
+
+void CompanyTemplateController::workerModelData()
+{
+    JsonParameterFormatter criterias = searchCriterias();
+    criterias.addParameter("SERVER_UID", m_serverUid);
+
+    JsonParameters parameters;
+    if (maxPages() > 0) {
+        // Planner estimate first: the navigator shows "~N" while the exact count runs
+        JsonParameterFormatter estimateCriterias = criterias;
+        estimateCriterias.addParameter("COUNT_ACCURACY", "ESTIMATE");
+        TotalCount totalCount;
+        parameters.set_jsonparams(estimateCriterias.toJson());
+        Status status = m_client->QueryCompanyTotalCount(parameters, totalCount);
+        if (!status.ok()) {
+            emit warning(tr("Companies"), QString::fromStdString(status.error_message()));
+            return;
+        }
+        if (totalCount.estimated()) {
+            emit navigatorEstimatedRecordCount(static_cast<int>(totalCount.count()));
+
+            parameters.set_jsonparams(criterias.toJson());
+            status = m_client->QueryCompanyTotalCount(parameters, totalCount);
+            if (!status.ok()) {
+                emit warning(tr("Companies"), QString::fromStdString(status.error_message()));
+                return;
+            }
+        }
+        const int recordCount = static_cast<int>(totalCount.count());
+        emit navigatorRecordCount(recordCount);
+
+        criterias.addParameter("OFFSET", static_cast<int>(sqlRowOffset(currentNavigatorPage(), maxPages(), recordCount)));
+        criterias.addParameter("LIMIT", maxPages());
+    }
+
+    std::vector<Company> companies;
+    parameters.set_jsonparams(criterias.toJson());
+    Status status = m_client->QueryCompanies(parameters, companies);
+    if (!status.ok()) {
+        emit warning(tr("Companies"), QString::fromStdString(status.error_message()));
+        return;
+    }
+
+    auto container = std::make_shared<GrpcDataContainer<Company>>(std::move(companies));
+    QMetaObject::invokeMethod(this, [this, container]() {
+        emit populateModel(container);
+    }, Qt::QueuedConnection);
+}
+
+QVariant CompanyTemplateController::workerAddNewObject(const QVariant & promise)
+{
+    Company company = promise.value<Company>();
+    company.set_server_uid(m_serverUid);
+
+    CompanyResult result;
+    Status status = m_client->AddCompany(company, result);
+    if (!status.ok() || !result.success()) {
+        const std::string error = status.ok() ? result.error() : status.error_message();
+        emit warning(tr("Add company"), QString::fromStdString(error));
+        throw std::runtime_error(error);
+    }
+    company.set_uid(result.uid());
+    return QVariant::fromValue(company);
+}
+
+QVariant CompanyTemplateController::workerEditObject(const QVariant & promise)
+{
+    Company company = promise.value<Company>();
+
+    CompanyResult result;
+    Status status = m_client->EditCompany(company, result);
+    if (!status.ok() || !result.success()) {
+        const std::string error = status.ok() ? result.error() : status.error_message();
+        emit warning(tr("Edit company"), QString::fromStdString(error));
+        throw std::runtime_error(error);
+    }
+    return promise;
+}
+
+QVariant CompanyTemplateController::workerDeleteObject(const QVariant & promise)
+{
+    CompanyResult result;
+    Status status = m_client->DeleteCompany(promise.value<Company>(), result);
+    if (!status.ok() || !result.success()) {
+        const std::string error = status.ok() ? result.error() : status.error_message();
+        emit warning(tr("Delete company"), QString::fromStdString(error));
+        throw std::runtime_error(error);
+    }
+    return promise;
+}
+
+void CompanyTemplateController::workerWatchChanges()
+{
+    WatchRequest request;
+    request.set_server_uid(m_serverUid);
+
+    while (!watchStopRequested()) {
+        grpc::ClientContext * context = nullptr;
+        {
+            std::lock_guard lock(m_watchMutex);
+            m_watchContext = std::make_unique<grpc::ClientContext>();
+            context = m_watchContext.get();
+        }
+        // stopWatching() may have run before the new context existed
+        if (watchStopRequested()) {
+            break;
+        }
+
+        m_client->WatchCompanies(*context, request, [this, &request](const CompanyChange & change) {
+            if (watchStopRequested()) {
+                return false;
+            }
+            // Resume right after this message if the stream drops
+            request.set_epoch(change.epoch());
+            request.set_resume_sequence(change.sequence());
+
+            const QString uid = QString::fromStdString(change.uid());
+            switch (change.operation()) {
+            case CompanyEdit::CHANGE_INSERT:
+                postRemoteChange(RemoteInserted, uid);
+                break;
+            case CompanyEdit::CHANGE_UPDATE:
+                postRemoteChange(RemoteUpdated, uid);
+                break;
+            case CompanyEdit::CHANGE_DELETE:
+                postRemoteChange(RemoteDeleted, uid);
+                break;
+            case CompanyEdit::CHANGE_RESET:
+                // Events were lost (server restarted or we fell too far behind)
+                postRemoteChange(RemoteReset, {});
+                break;
+            default:
+                break;
+            }
+            return true;
+        });
+
+        // Stream ended or failed: reconnect and resume after a short pause
+        for (int waited = 0; waited < WATCH_RETRY_MS && !watchStopRequested(); waited += WATCH_RETRY_STEP_MS) {
+            QThread::msleep(WATCH_RETRY_STEP_MS);
+        }
+    }
+
+    std::lock_guard lock(m_watchMutex);
+    m_watchContext.reset();
+}
+
+void CompanyTemplateController::cancelWatching()
+{
+    std::lock_guard lock(m_watchMutex);
+    if (m_watchContext) {
+        m_watchContext->TryCancel();
+    }
+}
+
+QVariant CompanyTemplateController::workerFetchObject(const QString & uid)
+{
+    CompanyUid request;
+    request.set_uid(uid.toStdString());
+
+    Company company;
+    if (!m_client->QueryCompanyByUid(request, company).ok()) {
+        return {};
+    }
+    return QVariant::fromValue(company);
+}
+
+QString CompanyTemplateController::objectUid(const QVariant & object) const
+{
+    return QString::fromStdString(object.value<Company>().uid());
+}
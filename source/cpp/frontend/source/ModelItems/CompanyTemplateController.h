@@ -0,0 +1,53 @@
+#ifndef COMPANYTEMPLATECONTROLLER_H
+#define COMPANYTEMPLATECONTROLLER_H
+
+#include <memory>
+#include <mutex>
+
+#include "GrpcTemplateController.h"
+
+namespace grpc {
+class Channel;
+class ClientContext;
+}
+class CompanyEditorClient;
+
+/**
+ * @brief Company table + form template backed by the CompanyEditor service.
+ *
+ * Loads one navigator page of the companies of @p serverUid and keeps it
+ * current through WatchCompanies: the controller starts watching on
+ * construction, resumes from the last received epoch/sequence after a
+ * dropped stream and reloads when the server answers CHANGE_RESET.
+ */
+class CompanyTemplateController : public GrpcTemplateController
+{
+    Q_OBJECT
+
+public:
+    explicit CompanyTemplateController(std::shared_ptr<grpc::Channel> channel, int serverUid,
+                                       GrpcProxySortFilterModel * proxyModel, GrpcTableView * tableView,
+                                       GrpcForm * form, QObject * parent = nullptr);
+    ~CompanyTemplateController() override;
+
+protected:
+    void workerModelData() override;
+    QVariant workerAddNewObject(const QVariant & promise) override;
+    QVariant workerEditObject(const QVariant & promise) override;
+    QVariant workerDeleteObject(const QVariant & promise) override;
+
+    void workerWatchChanges() override;
+    void cancelWatching() override;
+    QVariant workerFetchObject(const QString & uid) override;
+    QString objectUid(const QVariant & object) const override;
+
+private:
+    std::unique_ptr<CompanyEditorClient> m_client;
+    const int m_serverUid;
+
+    // Context of the running WatchCompanies call, cancelled from the GUI thread
+    std::mutex m_watchMutex;
+    std::unique_ptr<grpc::ClientContext> m_watchContext;
+};
+
+#endif // COMPANYTEMPLATECONTROLLER_H
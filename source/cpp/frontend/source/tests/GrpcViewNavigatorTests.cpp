@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include <QCoreApplication>
+#include <QLocale>
 #include <QMetaObject>
 #include <QSignalSpy>
 #include <QTest>
@@ -122,3 +123,20 @@ TEST(GrpcViewNavigatorTest, PrevNextDoNotEmitWhenOutOfRange)
     EXPECT_EQ(spy.count(), 0);
     EXPECT_EQ(navigator.currentPage(), 1);
 }
+
+TEST(GrpcViewNavigatorTest, EstimatedRecordCountIsRefinedByExactCount)
+{
+    QLocale::setDefault(QLocale(QLocale::English, QLocale::UnitedStates));
+    GrpcViewNavigator navigator;
+
+    navigator.synchronizeByEstimatedRecords(12400);
+    EXPECT_EQ(navigator.recordCountText(), QString("~12,400"));
+    EXPECT_EQ(navigator.currentPage(), 1);
+
+    navigator.synchronizeByRecords(12391);
+    EXPECT_EQ(navigator.recordCountText(), QString("12,391"));
+
+    navigator.synchronizeByRecords(0);
+    EXPECT_TRUE(navigator.recordCountText().isEmpty());
+    QLocale::setDefault(QLocale::system());
+}
@@ -96,7 +96,14 @@ JsonParameterFormatter::toJsonString(const std::map<std::string, std::string>& p
 
 std::string
 JsonParameterFormatter::toJsonString(const TypeToStringFormatter& formatter, bool pretty) {
-    return toJsonString(formatter.toMap(), pretty);
+    json doc = json::object();
+
+    // In insertion order, so a repeated name ends with its last value
+    for (const auto& info : formatter.parameters()) {
+        doc[info.param] = info.value;
+    }
+
+    return pretty ? doc.dump(4) : doc.dump();
 }
 
 bool JsonParameterFormatter::isValidJson(std::string_view jsonString) noexcept {
@@ -1,10 +1,10 @@
 #include "TypeToStringFormatter.h"
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <sstream>
+#include <iterator>
 #include <format>
 #include <random>
-#include <algorithm>
-#include <iomanip>
 
 // ============================================================================
 // Time Formatting Utilities
@@ -15,84 +15,236 @@ using std::string;
 using std::string_view;
 namespace timeFormatter {
 
-string toString(std::chrono::milliseconds timePoint, DataInfo::Type type) {
-    try {
-        using namespace std::chrono;
-
-        const sys_time<milliseconds> tpMs{timePoint};
-        const auto tpSec = floor<seconds>(tpMs);
-
-        const auto dayPoint = floor<days>(tpSec);
-        const year_month_day ymd{dayPoint};
-        const hh_mm_ss timeOfDay{tpSec - dayPoint};
-
-        const int year = int(ymd.year());
-        const unsigned month = unsigned(ymd.month());
-        const unsigned day = unsigned(ymd.day());
-        const auto hours = timeOfDay.hours().count();
-        const auto minutes = timeOfDay.minutes().count();
-        const auto secs = timeOfDay.seconds().count();
-
-        switch (type) {
-        case DataInfo::DateTime:
-            return std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}",
-                               year, month, day, hours, minutes, secs);
-        case DataInfo::DateTimeNoSec:
-            return std::format("{:04}-{:02}-{:02} {:02}:{:02}",
-                               year, month, day, hours, minutes);
-        case DataInfo::Date:
-            return std::format("{:04}-{:02}-{:02}", year, month, day);
-        case DataInfo::Time:
-            return std::format("{:02}:{:02}:{:02}", hours, minutes, secs);
-        default:
-            throw FormatterException(ERR_WRONG_DATE_TIME_TYPE);
+namespace {
+constexpr int64_t MS_PER_DAY = 86'400'000;
+
+/// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's days_from_civil)
+constexpr int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) noexcept
+{
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+struct CivilDate {
+    int64_t year;
+    unsigned month;
+    unsigned day;
+};
+
+/// Inverse of daysFromCivil()
+constexpr CivilDate civilFromDays(int64_t days) noexcept
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const unsigned dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    return {static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2),
+            month, dayOfYear - (153 * mp + 2) / 5 + 1};
+}
+
+static_assert(daysFromCivil(1970, 1, 1) == 0);
+static_assert(civilFromDays(daysFromCivil(2000, 2, 29)).day == 29);
+
+constexpr unsigned daysInMonth(unsigned year, unsigned month) noexcept
+{
+    constexpr unsigned DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+constexpr std::size_t layoutSize(DataInfo::Type type) noexcept
+{
+    switch (type) {
+    case DataInfo::DateTime:      return 19;
+    case DataInfo::DateTimeNoSec: return 16;
+    case DataInfo::Date:          return 10;
+    case DataInfo::Time:          return 8;
+    default:                      return 0;
+    }
+}
+
+/// Write @p value as exactly @p width digits
+char* putDigits(char* out, unsigned value, int width) noexcept
+{
+    for (int i = width - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return out + width;
+}
+
+/// Read exactly @p width digits
+bool getDigits(const char*& in, const char* last, int width, unsigned& value) noexcept
+{
+    if (last - in < width) {
+        return false;
+    }
+    value = 0;
+    for (int i = 0; i < width; ++i) {
+        const unsigned digit = static_cast<unsigned>(static_cast<unsigned char>(in[i]) - '0');
+        if (digit > 9) {
+            return false;
         }
-    } catch (const std::format_error& e) {
-        throw FormatterException(
-            std::format("{} - {}", ERR_CHRONO_FORMAT, e.what())
-            );
+        value = value * 10 + digit;
     }
+    in += width;
+    return true;
 }
 
-string toString(int64_t milliseconds, DataInfo::Type type) {
-    return toString(std::chrono::milliseconds{milliseconds}, type);
+bool getChar(const char*& in, const char* last, char expected) noexcept
+{
+    if (in == last || *in != expected) {
+        return false;
+    }
+    ++in;
+    return true;
 }
+} // namespace
+
+std::to_chars_result toChars(char* first, char* last, std::chrono::milliseconds timePoint,
+                             DataInfo::Type type) noexcept
+{
+    const std::size_t size = layoutSize(type);
+    if (size == 0) {
+        return {last, std::errc::invalid_argument};
+    }
+    if (last - first < static_cast<std::ptrdiff_t>(size)) {
+        return {last, std::errc::value_too_large};
+    }
 
-std::chrono::milliseconds fromString(string_view formatted, DataInfo::Type type) {
-    std::chrono::sys_time<std::chrono::milliseconds> timePoint;
-    string inputStr(formatted);
+    // Floor to whole days so times before the epoch keep a positive time of day
+    int64_t days = timePoint.count() / MS_PER_DAY;
+    int64_t msOfDay = timePoint.count() % MS_PER_DAY;
+    if (msOfDay < 0) {
+        msOfDay += MS_PER_DAY;
+        --days;
+    }
+    const unsigned secOfDay = static_cast<unsigned>(msOfDay / 1000);
 
-    // For Time type without date, prepend a date for parsing
-    if (type == DataInfo::Time) {
-        inputStr = std::format("1970-01-01 {}", formatted);
+    char* out = first;
+    if (type != DataInfo::Time) {
+        const CivilDate date = civilFromDays(days);
+        if (date.year < 0 || date.year > 9999) {
+            return {last, std::errc::invalid_argument};
+        }
+        out = putDigits(out, static_cast<unsigned>(date.year), 4);
+        *out++ = '-';
+        out = putDigits(out, date.month, 2);
+        *out++ = '-';
+        out = putDigits(out, date.day, 2);
+        if (type == DataInfo::Date) {
+            return {out, std::errc()};
+        }
+        *out++ = ' ';
     }
+    out = putDigits(out, secOfDay / 3600, 2);
+    *out++ = ':';
+    out = putDigits(out, secOfDay / 60 % 60, 2);
+    if (type != DataInfo::DateTimeNoSec) {
+        *out++ = ':';
+        out = putDigits(out, secOfDay % 60, 2);
+    }
+    return {out, std::errc()};
+}
 
-    std::istringstream ss(inputStr);
+std::from_chars_result fromChars(const char* first, const char* last, DataInfo::Type type,
+                                 std::chrono::milliseconds& value) noexcept
+{
+    const std::from_chars_result invalid{first, std::errc::invalid_argument};
+    if (!isDateTimeType(type)) {
+        return invalid;
+    }
 
-    switch (type) {
-    case DataInfo::DateTime:
-        ss >> std::chrono::parse("%Y-%m-%d %H:%M:%S", timePoint);
-        break;
-    case DataInfo::DateTimeNoSec:
-        ss >> std::chrono::parse("%Y-%m-%d %H:%M", timePoint);
-        break;
-    case DataInfo::Date:
-        ss >> std::chrono::parse("%Y-%m-%d", timePoint);
-        break;
-    case DataInfo::Time:
-        ss >> std::chrono::parse("%Y-%m-%d %H:%M:%S", timePoint);
-        break;
-    default:
+    const char* in = first;
+    int64_t days = 0;
+    if (type != DataInfo::Time) {
+        unsigned year, month, day;
+        if (!getDigits(in, last, 4, year) || !getChar(in, last, '-')
+            || !getDigits(in, last, 2, month) || !getChar(in, last, '-')
+            || !getDigits(in, last, 2, day)) {
+            return invalid;
+        }
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+            return invalid;
+        }
+        days = daysFromCivil(year, month, day);
+        if (type == DataInfo::Date) {
+            value = std::chrono::milliseconds(days * MS_PER_DAY);
+            return {in, std::errc()};
+        }
+        if (!getChar(in, last, ' ')) {
+            return invalid;
+        }
+    }
+
+    unsigned hours, minutes, seconds = 0, millis = 0;
+    if (!getDigits(in, last, 2, hours) || !getChar(in, last, ':')
+        || !getDigits(in, last, 2, minutes) || hours > 23 || minutes > 59) {
+        return invalid;
+    }
+    if (type != DataInfo::DateTimeNoSec) {
+        if (!getChar(in, last, ':') || !getDigits(in, last, 2, seconds) || seconds > 59) {
+            return invalid;
+        }
+        // Optional fraction; digits beyond milliseconds are dropped
+        if (in != last && *in == '.') {
+            const char* digit = in + 1;
+            int count = 0;
+            for (; digit != last && static_cast<unsigned>(*digit - '0') <= 9; ++digit, ++count) {
+                if (count < 3) {
+                    millis = millis * 10 + static_cast<unsigned>(*digit - '0');
+                }
+            }
+            if (count > 0) {
+                for (int i = count; i < 3; ++i) {
+                    millis *= 10;
+                }
+                in = digit;
+            }
+        }
+    }
+
+    value = std::chrono::milliseconds(days * MS_PER_DAY
+                                      + ((hours * 60 + minutes) * 60 + seconds) * int64_t{1000}
+                                      + millis);
+    return {in, std::errc()};
+}
+
+string toString(std::chrono::milliseconds timePoint, DataInfo::Type type) {
+    if (!isDateTimeType(type)) {
         throw FormatterException(ERR_WRONG_DATE_TIME_TYPE);
     }
+    char buffer[MAX_CHARS];
+    const auto [end, ec] = toChars(buffer, buffer + MAX_CHARS, timePoint, type);
+    if (ec != std::errc()) {
+        throw FormatterException(std::format("{} - year out of range", ERR_CHRONO_FORMAT));
+    }
+    return string(buffer, end);
+}
+
+string toString(int64_t milliseconds, DataInfo::Type type) {
+    return toString(std::chrono::milliseconds{milliseconds}, type);
+}
 
-    if (ss.fail()) {
+std::chrono::milliseconds fromString(string_view formatted, DataInfo::Type type) {
+    if (!isDateTimeType(type)) {
+        throw FormatterException(ERR_WRONG_DATE_TIME_TYPE);
+    }
+    std::chrono::milliseconds value{0};
+    const auto [end, ec] = fromChars(formatted.data(), formatted.data() + formatted.size(), type, value);
+    if (ec != std::errc()) {
         throw FormatterException(
             std::format("{} Input: '{}'", ERR_STRING_FORMAT, formatted)
             );
     }
-
-    return timePoint.time_since_epoch();
+    return value;
 }
 
 std::chrono::milliseconds now() {
@@ -101,21 +253,140 @@ std::chrono::milliseconds now() {
         );
 }
 
+namespace {
+/// Two lower-case hex digits for every byte value
+constexpr auto HEX_PAIRS = [] {
+    constexpr char DIGITS[] = "0123456789abcdef";
+    std::array<std::array<char, 2>, 256> table{};
+    for (std::size_t i = 0; i < table.size(); ++i) {
+        table[i] = {DIGITS[i >> 4], DIGITS[i & 0xF]};
+    }
+    return table;
+}();
+
+/// Write the low @p bytes bytes of @p value as hex, most significant first
+char* putHex(char* out, uint64_t value, int bytes) noexcept
+{
+    for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+        const auto& pair = HEX_PAIRS[(value >> shift) & 0xFF];
+        *out++ = pair[0];
+        *out++ = pair[1];
+    }
+    return out;
+}
+
+/**
+ * @brief xoshiro256** generator, one per thread
+ *
+ * Seeded once from std::random_device; the seed also mixes in the time and
+ * the thread's own address in case the device is deterministic.
+ */
+class ThreadRandom
+{
+public:
+    ThreadRandom() noexcept
+    {
+        uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count())
+                      ^ reinterpret_cast<uintptr_t>(this);
+        try {
+            std::random_device device;
+            seed ^= (static_cast<uint64_t>(device()) << 32) | device();
+        } catch (...) {
+            // No entropy source; time and address only
+        }
+        for (uint64_t& word : m_state) {
+            word = splitMix64(seed);
+        }
+    }
+
+    uint64_t next() noexcept
+    {
+        const uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+        const uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotl(m_state[3], 45);
+        return result;
+    }
+
+private:
+    static constexpr uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitMix64(uint64_t& x) noexcept
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+        return z ^ (z >> 31);
+    }
+
+    std::array<uint64_t, 4> m_state{};
+};
+
+ThreadRandom& threadRandom() noexcept
+{
+    thread_local ThreadRandom random;
+    return random;
+}
+
+/// Last UUIDv7 timestamp and its 12-bit counter, per thread
+struct UuidV7State {
+    uint64_t lastMs = 0;
+    uint64_t counter = 0;
+};
+} // namespace
+
 string generateUniqueId() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, 255);
+    string id(64, '0');  // 256-bit unique ID
+    char* out = id.data();
+    for (int i = 0; i < 4; ++i) {
+        out = putHex(out, threadRandom().next(), 8);
+    }
+    return id;
+}
 
-    std::vector<uint8_t> bytes(32);  // 256-bit unique ID
-    std::generate(bytes.begin(), bytes.end(), [&]() { return dist(gen); });
+std::to_chars_result uuidV7ToChars(char* first, char* last) noexcept {
+    if (last - first < static_cast<std::ptrdiff_t>(UUID_CHARS)) {
+        return {last, std::errc::value_too_large};
+    }
 
-    std::ostringstream ss;
-    ss << std::hex << std::setfill('0');
-    for (uint8_t byte : bytes) {
-        ss << std::setw(2) << static_cast<int>(byte);
+    ThreadRandom& random = threadRandom();
+    thread_local UuidV7State state;
+
+    // Counter starts at a random value below 0x800 in each new millisecond;
+    // when it runs out (or the clock steps back) the timestamp moves on by
+    // itself, so the ids of a thread never go backwards
+    const uint64_t nowMs = static_cast<uint64_t>(now().count());
+    if (nowMs > state.lastMs) {
+        state.lastMs = nowMs;
+        state.counter = random.next() & 0x7FF;
+    } else if (++state.counter > 0xFFF) {
+        ++state.lastMs;
+        state.counter = 0;
     }
 
-    return ss.str();
+    const uint64_t high = ((state.lastMs & 0xFFFF'FFFF'FFFF) << 16) | 0x7000 | state.counter;
+    const uint64_t low = (random.next() >> 2) | 0x8000'0000'0000'0000;  // variant 0b10
+
+    char* out = putHex(first, high >> 32, 4);
+    *out++ = '-';
+    out = putHex(out, high >> 16, 2);
+    *out++ = '-';
+    out = putHex(out, high, 2);
+    *out++ = '-';
+    out = putHex(out, low >> 48, 2);
+    *out++ = '-';
+    out = putHex(out, low, 6);
+    return {out, std::errc()};
+}
+
+string generateUuidV7() {
+    string id(UUID_CHARS, '0');
+    uuidV7ToChars(id.data(), id.data() + id.size());
+    return id;
 }
 
 } // namespace timeFormatter
@@ -124,6 +395,42 @@ string generateUniqueId() {
 // TypeToStringFormatter Implementation
 // ============================================================================
 
+TypeToStringFormatter::TypeToStringFormatter(std::pmr::memory_resource* upstream)
+    : m_resource(m_inline, sizeof(m_inline), upstream)
+    , m_dataList(&m_resource) {
+    m_dataList.reserve(INLINE_CAPACITY);
+}
+
+TypeToStringFormatter::TypeToStringFormatter(const TypeToStringFormatter& other)
+    : TypeToStringFormatter(other.m_resource.upstream_resource()) {
+    m_dataList.reserve(other.m_dataList.size());
+    m_dataList.assign(other.m_dataList.begin(), other.m_dataList.end());
+}
+
+TypeToStringFormatter& TypeToStringFormatter::operator=(const TypeToStringFormatter& other) {
+    if (this != &other) {
+        m_dataList.assign(other.m_dataList.begin(), other.m_dataList.end());
+    }
+    return *this;
+}
+
+TypeToStringFormatter::TypeToStringFormatter(TypeToStringFormatter&& other)
+    : TypeToStringFormatter(other.m_resource.upstream_resource()) {
+    m_dataList.reserve(other.m_dataList.size());
+    std::move(other.m_dataList.begin(), other.m_dataList.end(), std::back_inserter(m_dataList));
+    other.m_dataList.clear();
+}
+
+TypeToStringFormatter& TypeToStringFormatter::operator=(TypeToStringFormatter&& other) {
+    if (this != &other) {
+        m_dataList.clear();
+        m_dataList.reserve(other.m_dataList.size());
+        std::move(other.m_dataList.begin(), other.m_dataList.end(), std::back_inserter(m_dataList));
+        other.m_dataList.clear();
+    }
+    return *this;
+}
+
 void TypeToStringFormatter::addParameter(string_view name, const FormatterValue& value) {
     DataInfo info;
     info.param = name;
@@ -235,7 +542,7 @@ std::chrono::milliseconds TypeToStringFormatter::getAsTime(string_view name) con
 map<string, string> TypeToStringFormatter::toMap() const {
     map<string, string> result;
     for (const auto& info : m_dataList) {
-        result.emplace(info.param, info.value);
+        result.insert_or_assign(info.param, info.value);  // Last one wins, as in getValue()
     }
     return result;
 }
@@ -245,16 +552,15 @@ bool TypeToStringFormatter::contains(string_view name) const {
 }
 
 void TypeToStringFormatter::addToList(DataInfo info) {
-    size_t index = m_dataList.size();
-    string nameKey = info.param;  // Copy for map key
     m_dataList.push_back(std::move(info));
-    m_lookupMap[std::move(nameKey)] = index;
 }
 
 const DataInfo* TypeToStringFormatter::findByName(string_view name) const {
-    auto it = m_lookupMap.find(string(name));
-    if (it != m_lookupMap.end() && it->second < m_dataList.size()) {
-        return &m_dataList[it->second];
+    // Newest first: a repeated name resolves to its last value
+    for (auto it = m_dataList.rbegin(); it != m_dataList.rend(); ++it) {
+        if (it->param == name) {
+            return &*it;
+        }
     }
     return nullptr;
 }
@@ -2,12 +2,15 @@
 #define TYPETOSTRINGFORMATTER_H
 
 #include "include_util.h"
+#include <charconv>
 #include <chrono>
+#include <cstddef>
 #include <variant>
 #include <string_view>
 #include <optional>
-#include <unordered_map>
 #include <map>
+#include <memory_resource>
+#include <span>
 #include <stdexcept>
 #include <vector>
 
@@ -29,9 +32,39 @@ public:
 
 /**
  * @brief Time formatting utilities
+ *
+ * Layouts: DateTime "YYYY-MM-DD HH:MM:SS", DateTimeNoSec "YYYY-MM-DD HH:MM",
+ * Date "YYYY-MM-DD", Time "HH:MM:SS" (milliseconds since midnight of the
+ * epoch day). toChars()/fromChars() work on caller buffers without
+ * allocating; toString()/fromString() wrap them and throw on errors.
  */
 namespace timeFormatter {
 
+/// Longest layout ("YYYY-MM-DD HH:MM:SS")
+inline constexpr std::size_t MAX_CHARS = 19;
+
+/**
+ * @brief Write @p timePoint in the layout of @p type into [first, last)
+ * @return ptr past the last written character; ec is value_too_large if the
+ *         buffer is too small, invalid_argument if @p type is not a date/time
+ *         type or the year is outside 0000-9999
+ */
+std::to_chars_result toChars(char* first, char* last, std::chrono::milliseconds timePoint,
+                             DataInfo::Type type) noexcept;
+
+/**
+ * @brief Parse the layout of @p type at the start of [first, last)
+ *
+ * Every field must have exactly its digit count and a valid value (month
+ * 1-12, day within the month, hour < 24, minute and second < 60). DateTime
+ * and Time accept a fraction after the seconds (".123"); milliseconds are
+ * kept. As with std::from_chars, text after the layout is not consumed.
+ * @return ptr past the consumed characters; ec is invalid_argument on a
+ *         malformed or out-of-range field, or if @p type is not a date/time type
+ */
+std::from_chars_result fromChars(const char* first, const char* last, DataInfo::Type type,
+                                 std::chrono::milliseconds& value) noexcept;
+
 /**
  * @brief Convert chrono milliseconds to formatted string
  * @throws FormatterException if type is not a date/time type
@@ -45,6 +78,8 @@ namespace timeFormatter {
 
 /**
  * @brief Parse formatted string to chrono milliseconds
+ *
+ * Text after the layout is ignored (a Date column read as "2007-01-20 00:00:00").
  * @throws FormatterException if parsing fails
  */
 [[nodiscard]] std::chrono::milliseconds fromString(std::string_view formatted, DataInfo::Type type);
@@ -55,10 +90,29 @@ namespace timeFormatter {
 [[nodiscard]] std::chrono::milliseconds now();
 
 /**
- * @brief Generate unique random string (for UUID-like values)
+ * @brief Generate unique random string of 64 hex digits (256 random bits)
  */
 [[nodiscard]] std::string generateUniqueId();
 
+/// Length of a UUID in canonical 8-4-4-4-12 form
+inline constexpr std::size_t UUID_CHARS = 36;
+
+/**
+ * @brief Write a new UUIDv7 (RFC 9562) in canonical lower-case form
+ * @return {first + UUID_CHARS, errc{}}; errc::value_too_large if the range is shorter
+ *
+ * The first 48 bits are the Unix time in milliseconds, so ids created later
+ * sort later and index inserts go to the right edge of the B-tree. Within a
+ * millisecond a per-thread counter keeps the ids of one thread strictly
+ * increasing; the remaining 62 bits come from a per-thread PRNG seeded once.
+ */
+std::to_chars_result uuidV7ToChars(char* first, char* last) noexcept;
+
+/**
+ * @brief New UUIDv7 as a 36-character string (see uuidV7ToChars())
+ */
+[[nodiscard]] std::string generateUuidV7();
+
 /**
  * @brief Check if type is a date/time type
  */
@@ -84,20 +138,36 @@ using FormatterValue = std::variant<int, int64_t, double, std::string, bool>;
  * - string_view for input parameters
  * - Better error messages with context
  * - Optional return types for safe lookups
- * - unordered_map for O(1) lookups by name
+ * - Flat storage: the first INLINE_CAPACITY parameters live inside the
+ *   object, later ones come from an optional std::pmr upstream resource
+ * - Lookups compare string_views over the list, without building a key
  * - Clear naming conventions
  * - Exception safety
+ *
+ * Adding a name twice keeps both entries; lookups and toMap() see the last
+ * one. Read parameters through parameters() or getValue() on hot paths;
+ * toMap() copies every name and value.
  */
 class TypeToStringFormatter {
 public:
-    TypeToStringFormatter() = default;
+    /// Parameters stored without allocating the list
+    static constexpr size_t INLINE_CAPACITY = 16;
+
+    TypeToStringFormatter() : TypeToStringFormatter(std::pmr::get_default_resource()) {}
+
+    /**
+     * @brief Formatter whose list grows into @p upstream past INLINE_CAPACITY
+     *
+     * Copies and moved-to formatters use the same upstream resource.
+     */
+    explicit TypeToStringFormatter(std::pmr::memory_resource* upstream);
     ~TypeToStringFormatter() = default;
 
-    // Rule of five
-    TypeToStringFormatter(const TypeToStringFormatter&) = default;
-    TypeToStringFormatter& operator=(const TypeToStringFormatter&) = default;
-    TypeToStringFormatter(TypeToStringFormatter&&) noexcept = default;
-    TypeToStringFormatter& operator=(TypeToStringFormatter&&) noexcept = default;
+    // Rule of five; the inline buffer is never shared, so moves move the elements
+    TypeToStringFormatter(const TypeToStringFormatter& other);
+    TypeToStringFormatter& operator=(const TypeToStringFormatter& other);
+    TypeToStringFormatter(TypeToStringFormatter&& other);
+    TypeToStringFormatter& operator=(TypeToStringFormatter&& other);
 
     /**
      * @brief Add parameter with automatic type deduction
@@ -153,6 +223,8 @@ public:
 
     /**
      * @brief Get all parameters as name-value map
+     *
+     * Copies every name and value; prefer parameters() or getValue().
      */
     [[nodiscard]] std::map<std::string, std::string> toMap() const;
 
@@ -165,9 +237,11 @@ public:
     }
 
     /**
-     * @brief Get all parameter info
+     * @brief Get all parameter info, in insertion order, without copying
+     *
+     * Valid until the next add or clear.
      */
-    [[nodiscard]] const std::vector<DataInfo>& parameters() const noexcept {
+    [[nodiscard]] std::span<const DataInfo> parameters() const noexcept {
         return m_dataList;
     }
 
@@ -194,13 +268,13 @@ public:
      * @brief Clear all parameters
      */
     void clear() noexcept {
-        m_dataList.clear();
-        m_lookupMap.clear();
+        m_dataList.clear();  // Keeps the capacity for the next round
     }
 
 private:
-    std::vector<DataInfo> m_dataList;
-    std::unordered_map<std::string, size_t> m_lookupMap;  // name -> index for O(1) lookup
+    alignas(DataInfo) std::byte m_inline[INLINE_CAPACITY * sizeof(DataInfo)];
+    std::pmr::monotonic_buffer_resource m_resource;  ///< m_inline first, then upstream
+    std::pmr::vector<DataInfo> m_dataList;
 
     void addToList(DataInfo info);
     [[nodiscard]] const DataInfo* findByName(std::string_view name) const;
@@ -212,6 +286,7 @@ using timeFormatter::toString;
 using timeFormatter::fromString;
 using timeFormatter::now;
 using timeFormatter::generateUniqueId;
+using timeFormatter::generateUuidV7;
 
 inline std::string chronoSysSecToString(std::chrono::milliseconds ms, DataInfo::Type type) {
     return toString(ms, type);
@@ -0,0 +1,101 @@
+#include "../TypeToStringFormatter.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <sstream>
+
+// ============================================================================
+// timeFormatter benchmark
+//
+// Compares toChars()/fromChars() with the std::format / std::chrono::parse
+// implementation they replaced. Timing is machine dependent, so the test
+// only runs when MEDICON_RUN_BENCHMARKS is set in the environment.
+// ============================================================================
+
+namespace {
+
+constexpr int ITERATIONS = 200'000;
+
+/// The former toString(): std::format over a broken-down sys_time
+std::string legacyToString(std::chrono::milliseconds timePoint)
+{
+    using namespace std::chrono;
+    const sys_time<milliseconds> tpMs{timePoint};
+    const auto tpSec = floor<seconds>(tpMs);
+    const auto dayPoint = floor<days>(tpSec);
+    const year_month_day ymd{dayPoint};
+    const hh_mm_ss timeOfDay{tpSec - dayPoint};
+    return std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}",
+                       int(ymd.year()), unsigned(ymd.month()), unsigned(ymd.day()),
+                       timeOfDay.hours().count(), timeOfDay.minutes().count(),
+                       timeOfDay.seconds().count());
+}
+
+/// The former fromString(): istringstream + std::chrono::parse
+std::chrono::milliseconds legacyFromString(std::string_view formatted)
+{
+    std::chrono::sys_time<std::chrono::milliseconds> timePoint;
+    std::istringstream ss{std::string(formatted)};
+    ss >> std::chrono::parse("%Y-%m-%d %H:%M:%S", timePoint);
+    return timePoint.time_since_epoch();
+}
+
+template <typename Fn>
+double nanosPerCall(Fn&& fn)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; ++i) {
+        fn(i);
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ITERATIONS;
+}
+
+} // namespace
+
+class TimeFormatterBenchmark : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!std::getenv("MEDICON_RUN_BENCHMARKS")) {
+            GTEST_SKIP() << "set MEDICON_RUN_BENCHMARKS=1 to run";
+        }
+    }
+
+    const std::chrono::milliseconds base = timeFormatter::fromString("2007-01-20 11:22:33", DataInfo::DateTime);
+    int64_t sink = 0;  ///< Keeps the optimizer from dropping the loops
+};
+
+TEST_F(TimeFormatterBenchmark, FormatIsTenTimesFaster) {
+    const double legacy = nanosPerCall([&](int i) {
+        sink += legacyToString(base + std::chrono::seconds(i)).size();
+    });
+    const double current = nanosPerCall([&](int i) {
+        char buffer[timeFormatter::MAX_CHARS];
+        const auto result = timeFormatter::toChars(buffer, buffer + sizeof(buffer),
+                                                   base + std::chrono::seconds(i), DataInfo::DateTime);
+        sink += result.ptr - buffer;
+    });
+
+    std::cout << "[BENCH] format: std::format " << legacy << " ns, toChars " << current << " ns\n";
+    EXPECT_GE(legacy / current, 10.0);
+}
+
+TEST_F(TimeFormatterBenchmark, ParseIsTenTimesFaster) {
+    std::string text = timeFormatter::toString(base, DataInfo::DateTime);
+
+    const double legacy = nanosPerCall([&](int i) {
+        text[18] = static_cast<char>('0' + i % 10);
+        sink += legacyFromString(text).count();
+    });
+    const double current = nanosPerCall([&](int i) {
+        text[18] = static_cast<char>('0' + i % 10);
+        std::chrono::milliseconds value{0};
+        timeFormatter::fromChars(text.data(), text.data() + text.size(), DataInfo::DateTime, value);
+        sink += value.count();
+    });
+
+    std::cout << "[BENCH] parse: chrono::parse " << legacy << " ns, fromChars " << current << " ns\n";
+    EXPECT_GE(legacy / current, 10.0);
+}
@@ -2,6 +2,10 @@
 #include "gtest/gtest.h"
 #include <chrono>
 #include <format>
+#include <memory_resource>
+#include <set>
+#include <thread>
+#include <vector>
 
 
 
@@ -87,6 +91,119 @@ TEST_F(TimeFormatterTest, GenerateUniqueId) {
     EXPECT_EQ(id1.size(), 64);  // 32 bytes * 2 hex chars
     EXPECT_EQ(id2.size(), 64);
     EXPECT_NE(id1, id2);  // Should be different
+    EXPECT_EQ(id1.find_first_not_of("0123456789abcdef"), std::string::npos);
+}
+
+TEST_F(TimeFormatterTest, UuidV7Layout) {
+    const int64_t before = timeFormatter::now().count();
+    const std::string id = timeFormatter::generateUuidV7();
+    const int64_t after = timeFormatter::now().count();
+
+    ASSERT_EQ(id.size(), timeFormatter::UUID_CHARS);
+    for (size_t dash : {8, 13, 18, 23}) {
+        EXPECT_EQ(id[dash], '-');
+    }
+    EXPECT_EQ(id[14], '7');  // version
+    EXPECT_NE(std::string_view("89ab").find(id[19]), std::string_view::npos);  // variant 0b10
+
+    // The first 48 bits are the creation time in milliseconds
+    const int64_t timestamp = std::stoll(id.substr(0, 8) + id.substr(9, 4), nullptr, 16);
+    EXPECT_GE(timestamp, before);
+    EXPECT_LE(timestamp, after + 1);
+
+    char small[timeFormatter::UUID_CHARS - 1];
+    EXPECT_EQ(timeFormatter::uuidV7ToChars(small, small + sizeof(small)).ec, std::errc::value_too_large);
+}
+
+TEST_F(TimeFormatterTest, UuidV7IncreasesWithinThread) {
+    // More ids than the counter holds in one millisecond
+    std::string previous = timeFormatter::generateUuidV7();
+    for (int i = 0; i < 10000; ++i) {
+        std::string next = timeFormatter::generateUuidV7();
+        ASSERT_LT(previous, next) << "at " << i;
+        previous = std::move(next);
+    }
+}
+
+TEST_F(TimeFormatterTest, UuidV7UniqueAcrossThreads) {
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 5000;
+    std::vector<std::vector<std::string>> ids(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                ids[t].push_back(timeFormatter::generateUuidV7());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::set<std::string> all;
+    for (const auto& list : ids) {
+        all.insert(list.begin(), list.end());
+    }
+    EXPECT_EQ(all.size(), size_t(THREADS * PER_THREAD));
+}
+
+TEST_F(TimeFormatterTest, ToCharsWritesFixedLayouts) {
+    char buffer[timeFormatter::MAX_CHARS];
+    auto write = [&](DataInfo::Type type) {
+        const auto [end, ec] = timeFormatter::toChars(buffer, buffer + sizeof(buffer), sampleTime, type);
+        EXPECT_EQ(ec, std::errc());
+        return std::string(buffer, end);
+    };
+    EXPECT_EQ(write(DataInfo::DateTime), "1211-10-11 10:11:12");
+    EXPECT_EQ(write(DataInfo::DateTimeNoSec), "1211-10-11 10:11");
+    EXPECT_EQ(write(DataInfo::Date), "1211-10-11");
+    EXPECT_EQ(write(DataInfo::Time), "10:11:12");
+
+    EXPECT_EQ(timeFormatter::toChars(buffer, buffer + 9, sampleTime, DataInfo::Date).ec,
+              std::errc::value_too_large);
+    EXPECT_EQ(timeFormatter::toChars(buffer, buffer + sizeof(buffer), sampleTime, DataInfo::Int).ec,
+              std::errc::invalid_argument);
+}
+
+TEST_F(TimeFormatterTest, FromCharsValidatesStrictly) {
+    auto parse = [](std::string_view text, DataInfo::Type type) {
+        std::chrono::milliseconds value{0};
+        return timeFormatter::fromChars(text.data(), text.data() + text.size(), type, value).ec;
+    };
+    EXPECT_EQ(parse("2024-02-29", DataInfo::Date), std::errc());
+    EXPECT_EQ(parse("2023-02-29", DataInfo::Date), std::errc::invalid_argument);
+    EXPECT_EQ(parse("2007-13-01", DataInfo::Date), std::errc::invalid_argument);
+    EXPECT_EQ(parse("2007-1-20", DataInfo::Date), std::errc::invalid_argument);
+    EXPECT_EQ(parse("2007-01-20 24:00:00", DataInfo::DateTime), std::errc::invalid_argument);
+    EXPECT_EQ(parse("2007-01-20 10:60", DataInfo::DateTimeNoSec), std::errc::invalid_argument);
+    EXPECT_EQ(parse("10:11", DataInfo::Time), std::errc::invalid_argument);
+    EXPECT_EQ(parse("10:11:12", DataInfo::String), std::errc::invalid_argument);
+}
+
+TEST_F(TimeFormatterTest, FromCharsStopsAfterLayout) {
+    const std::string text = "2007-01-20 10:11:12.5+02";
+    std::chrono::milliseconds value{0};
+
+    auto result = timeFormatter::fromChars(text.data(), text.data() + text.size(), DataInfo::DateTime, value);
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string_view(result.ptr), "+02");
+    EXPECT_EQ(value.count() % 1000, 500);
+
+    result = timeFormatter::fromChars(text.data(), text.data() + text.size(), DataInfo::Date, value);
+    ASSERT_EQ(result.ec, std::errc());
+    EXPECT_EQ(std::string_view(result.ptr), " 10:11:12.5+02");
+    EXPECT_EQ(timeFormatter::toString(value, DataInfo::DateTime), "2007-01-20 00:00:00");
+}
+
+TEST_F(TimeFormatterTest, RoundTripAroundEpoch) {
+    for (const char* text : {"1969-12-31 23:59:59", "1970-01-01 00:00:00", "1600-03-01 12:00:00",
+                             "2000-02-29 06:07:08", "9999-12-31 23:59:59"}) {
+        EXPECT_EQ(timeFormatter::toString(timeFormatter::fromString(text, DataInfo::DateTime),
+                                          DataInfo::DateTime), text);
+    }
+    EXPECT_EQ(timeFormatter::fromString("1970-01-01", DataInfo::Date).count(), 0);
+    EXPECT_EQ(timeFormatter::fromString("00:00:01", DataInfo::Time).count(), 1000);
 }
 
 // ============================================================================
@@ -372,7 +489,6 @@ TEST(FormatterEdgeCaseTest, ManyParameters) {
 
     EXPECT_EQ(formatter.size(), 1000);
 
-    // O(1) lookup should be fast
     for (int i = 0; i < 1000; i += 100) {
         auto name = std::format("Param{}", i);
         EXPECT_TRUE(formatter.contains(name));
@@ -401,9 +517,51 @@ TEST(FormatterEdgeCaseTest, DuplicateParameterNames) {
 
     // Last write wins - both are added to the list
     EXPECT_EQ(formatter.size(), 2);
-    // But lookup returns the last one added (due to map overwrite)
+    // But lookup returns the last one added
     auto value = formatter.getValueOrThrow("Duplicate");
     EXPECT_EQ(value, "2");
+    EXPECT_EQ(formatter.toMap().at("Duplicate"), "2");
+}
+
+namespace {
+/// Counts the allocations that reach the upstream resource
+class CountingResource : public std::pmr::memory_resource {
+public:
+    int allocations = 0;
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+} // namespace
+
+TEST(FormatterEdgeCaseTest, InlineCapacityNeedsNoUpstream) {
+    CountingResource upstream;
+    TypeToStringFormatter formatter(&upstream);
+
+    for (size_t i = 0; i < TypeToStringFormatter::INLINE_CAPACITY; ++i) {
+        formatter.addParameter("P" + std::to_string(i), FormatterValue{int(i)});
+    }
+    EXPECT_EQ(upstream.allocations, 0);
+
+    formatter.addParameter("Overflow", FormatterValue{1});
+    EXPECT_GT(upstream.allocations, 0);
+    EXPECT_EQ(formatter.getValueOrThrow("P0"), "0");
+    EXPECT_EQ(formatter.getValueOrThrow("Overflow"), "1");
+
+    // Copies keep the upstream resource
+    const int beforeCopy = upstream.allocations;
+    TypeToStringFormatter copy(formatter);
+    EXPECT_GT(upstream.allocations, beforeCopy);
+    EXPECT_EQ(copy.getValueOrThrow("Overflow"), "1");
 }
 
 // ============================================================================